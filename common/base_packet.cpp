@@ -19,8 +19,202 @@
 #include "debug.h"
 #include "base_packet.h"
 #include "misc.h"
+#include "mutex.h"
 #include "packet_dump.h"
 
+namespace {
+	struct FreeBlock {
+		FreeBlock *next;
+	};
+
+	struct SizeClass {
+		uint32 block_size;
+		uint32 max_pooled;
+		FreeBlock *free_list;
+		uint32 pooled;
+		uint64 allocations;
+		uint64 pool_hits;
+		uint64 frees;
+		Mutex lock;
+	};
+
+	//objects: 16 byte steps up to 256; buffers: powers of two from 64 to 4096
+	const uint32 OBJECT_CLASS_STEP = 16;
+	const uint32 OBJECT_CLASS_COUNT = 16;
+	const uint32 BUFFER_CLASS_MIN = 64;
+	const uint32 BUFFER_CLASS_COUNT = 7;
+	const uint32 MAX_POOLED_OBJECTS = 4096;
+	const uint32 MAX_POOLED_BUFFERS = 1024;
+
+	struct PoolState {
+		SizeClass objects[OBJECT_CLASS_COUNT];
+		SizeClass buffers[BUFFER_CLASS_COUNT];
+		Mutex oversize_lock;
+		PacketPool::Stats oversize_objects;
+		PacketPool::Stats oversize_buffers;
+
+		PoolState() {
+			for (uint32 i = 0; i < OBJECT_CLASS_COUNT; i++)
+				Init(objects[i], (i + 1) * OBJECT_CLASS_STEP, MAX_POOLED_OBJECTS);
+			for (uint32 i = 0; i < BUFFER_CLASS_COUNT; i++)
+				Init(buffers[i], BUFFER_CLASS_MIN << i, MAX_POOLED_BUFFERS);
+			memset(&oversize_objects, 0, sizeof(oversize_objects));
+			memset(&oversize_buffers, 0, sizeof(oversize_buffers));
+		}
+
+		static void Init(SizeClass &sc, uint32 block_size, uint32 max_pooled) {
+			sc.block_size = block_size;
+			sc.max_pooled = max_pooled;
+			sc.free_list = nullptr;
+			sc.pooled = 0;
+			sc.allocations = 0;
+			sc.pool_hits = 0;
+			sc.frees = 0;
+		}
+	};
+
+	//never destroyed, packets may still be freed during static teardown
+	PoolState &Pool() {
+		static PoolState *state = new PoolState;
+		return *state;
+	}
+
+	SizeClass *ObjectClass(size_t len) {
+		if (len == 0 || len > OBJECT_CLASS_STEP * OBJECT_CLASS_COUNT)
+			return nullptr;
+		return &Pool().objects[(len - 1) / OBJECT_CLASS_STEP];
+	}
+
+	SizeClass *BufferClass(uint32 len) {
+		for (uint32 i = 0; i < BUFFER_CLASS_COUNT; i++) {
+			if (len <= (BUFFER_CLASS_MIN << i))
+				return &Pool().buffers[i];
+		}
+		return nullptr;
+	}
+
+	//pops a parked block, or nullptr when the class is empty
+	void *TakeBlock(SizeClass &sc) {
+		LockMutex lock(&sc.lock);
+		sc.allocations++;
+		FreeBlock *block = sc.free_list;
+		if (block) {
+			sc.free_list = block->next;
+			sc.pooled--;
+			sc.pool_hits++;
+		}
+		return block;
+	}
+
+	//parks a block, returns false when the class is full and the caller should release it
+	bool ParkBlock(SizeClass &sc, void *mem) {
+		LockMutex lock(&sc.lock);
+		sc.frees++;
+		if (sc.pooled >= sc.max_pooled)
+			return false;
+		FreeBlock *block = static_cast<FreeBlock *>(mem);
+		block->next = sc.free_list;
+		sc.free_list = block;
+		sc.pooled++;
+		return true;
+	}
+
+	void CountOversize(PacketPool::Stats &stats, bool alloc) {
+		PoolState &pool = Pool();
+		LockMutex lock(&pool.oversize_lock);
+		if (alloc)
+			stats.allocations++;
+		else
+			stats.frees++;
+	}
+
+	void AddStats(PacketPool::Stats &total, SizeClass &sc) {
+		LockMutex lock(&sc.lock);
+		total.allocations += sc.allocations;
+		total.pool_hits += sc.pool_hits;
+		total.frees += sc.frees;
+		total.pooled += sc.pooled;
+	}
+}
+
+void *PacketPool::AllocObject(size_t len)
+{
+	SizeClass *sc = ObjectClass(len);
+	if (!sc) {
+		CountOversize(Pool().oversize_objects, true);
+		return ::operator new(len);
+	}
+
+	void *block = TakeBlock(*sc);
+	if (!block)
+		block = ::operator new(sc->block_size);
+	return block;
+}
+
+void PacketPool::FreeObject(void *block, size_t len)
+{
+	if (!block)
+		return;
+
+	SizeClass *sc = ObjectClass(len);
+	if (!sc) {
+		CountOversize(Pool().oversize_objects, false);
+		::operator delete(block);
+		return;
+	}
+
+	if (!ParkBlock(*sc, block))
+		::operator delete(block);
+}
+
+unsigned char *PacketPool::AllocBuffer(uint32 len, uint32 &capacity)
+{
+	SizeClass *sc = BufferClass(len);
+	if (!sc) {
+		CountOversize(Pool().oversize_buffers, true);
+		capacity = len;
+		return new unsigned char[len];
+	}
+
+	capacity = sc->block_size;
+	unsigned char *buffer = static_cast<unsigned char *>(TakeBlock(*sc));
+	if (!buffer)
+		buffer = new unsigned char[sc->block_size];
+	return buffer;
+}
+
+void PacketPool::FreeBuffer(unsigned char *buffer, uint32 capacity)
+{
+	if (!buffer)
+		return;
+
+	SizeClass *sc = BufferClass(capacity);
+	if (!sc || sc->block_size != capacity) {
+		CountOversize(Pool().oversize_buffers, false);
+		delete[] buffer;
+		return;
+	}
+
+	if (!ParkBlock(*sc, buffer))
+		delete[] buffer;
+}
+
+void PacketPool::GetStats(Stats &objects, Stats &buffers)
+{
+	PoolState &pool = Pool();
+
+	{
+		LockMutex lock(&pool.oversize_lock);
+		objects = pool.oversize_objects;
+		buffers = pool.oversize_buffers;
+	}
+
+	for (uint32 i = 0; i < OBJECT_CLASS_COUNT; i++)
+		AddStats(objects, pool.objects[i]);
+	for (uint32 i = 0; i < BUFFER_CLASS_COUNT; i++)
+		AddStats(buffers, pool.buffers[i]);
+}
+
 BasePacket::BasePacket(const unsigned char *buf, uint32 len)
 {
 	this->pBuffer=nullptr;
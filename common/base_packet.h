@@ -31,8 +31,37 @@
 	#include <netinet/in.h>
 #endif
 
+/*
+ * Size classed free lists for packet objects and transport buffers.
+ * The stream factory reader/writer threads allocate and free packets as
+ * well, so every size class carries its own lock. Requests larger than
+ * the biggest class go straight to the heap and are only counted.
+ */
+class PacketPool {
+public:
+	struct Stats {
+		uint64 allocations;	// total requests
+		uint64 pool_hits;	// requests served from a free list
+		uint64 frees;
+		uint64 pooled;		// blocks currently parked on free lists
+	};
+
+	static void *AllocObject(size_t len);
+	static void FreeObject(void *block, size_t len);
+
+	// Buffers are real new[] arrays, so a stray delete[] stays legal; capacity must be handed back on free
+	static unsigned char *AllocBuffer(uint32 len, uint32 &capacity);
+	static void FreeBuffer(unsigned char *buffer, uint32 capacity);
+
+	static void GetStats(Stats &objects, Stats &buffers);
+};
+
 class BasePacket {
 public:
+	//every packet type is carved from the pool's object size classes
+	static void *operator new(size_t len) { return PacketPool::AllocObject(len); }
+	static void operator delete(void *block, size_t len) { PacketPool::FreeObject(block, len); }
+
 	unsigned char *pBuffer;
 	uint32 size, _wpos, _rpos;
 	uint32 src_ip,dst_ip;
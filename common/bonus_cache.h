@@ -0,0 +1,103 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_BONUS_CACHE_H
+#define _EQEMU_BONUS_CACHE_H
+
+#include <string.h>
+#include "types.h"
+
+// Stat bonus contributors, used to flag which ones need recalculating
+enum BonusSource {
+	BonusSourceNone		= 0x00,
+	BonusSourceItems	= 0x01,	// worn, tribute and edible items
+	BonusSourceSpells	= 0x02,	// buffs and npc spell effects
+	BonusSourceAAs		= 0x04,
+	BonusSourceAll		= 0x07
+};
+
+namespace EQEmu {
+
+	/*! Keeps the item and AA bonuses of the last calculation so an update only redoes the contributors
+	that changed, giving the same bonuses as recalculating all of them in the usual order: items, then
+	spells, then AAs.
+
+	Two things make the sources depend on each other. Item ATK is capped by the spell and AA ItemATKCap
+	in effect when items were last summed, so a changed cap leaves the items dirty for the next update.
+	A negate debuff makes the spell pass strip the item and AA bonuses in place; the clean copies are kept
+	here and the spell pass is redone on every update while it is up, so the stripping never outlives it.
+
+	Calc has to provide CalcAllItemBonuses, CalcSpellBonuses and CalcAABonuses taking a Bonuses*, with
+	Bonuses having ItemATKCap and NegateEffects.
+	*/
+	template<class Bonuses>
+	class BonusCache {
+	public:
+		BonusCache() : dirty_(BonusSourceAll) {
+			memset(&items_, 0, sizeof(Bonuses));
+			memset(&aas_, 0, sizeof(Bonuses));
+		}
+
+		/*!
+			Recalculates the contributors in changed_sources and any left dirty, the rest come from the cache.
+		\param calc What calculates each contributor
+		\param changed_sources BonusSource flags of what changed since the last update
+		\param items The working item bonuses
+		\param spells The working spell bonuses
+		\param aas The working AA bonuses
+		*/
+		template<class Calc>
+		void Update(Calc &calc, uint32 changed_sources, Bonuses &items, Bonuses &spells, Bonuses &aas) {
+			uint32 sources = (dirty_ | changed_sources) & BonusSourceAll;
+			dirty_ = BonusSourceNone;
+
+			if(spells.NegateEffects)
+				sources |= BonusSourceSpells;
+
+			int32 item_atk_cap = spells.ItemATKCap + aas.ItemATKCap;
+
+			if(sources & BonusSourceItems) {
+				memset(&items, 0, sizeof(Bonuses));
+				calc.CalcAllItemBonuses(&items);
+				items_ = items;
+			} else {
+				items = items_;
+			}
+
+			if(sources & BonusSourceSpells)
+				calc.CalcSpellBonuses(&spells);
+
+			if(sources & BonusSourceAAs) {
+				calc.CalcAABonuses(&aas);
+				aas_ = aas;
+			} else {
+				aas = aas_;
+			}
+
+			if(spells.ItemATKCap + aas.ItemATKCap != item_atk_cap)
+				dirty_ |= BonusSourceItems;
+		}
+
+	private:
+		uint32 dirty_;
+		Bonuses items_;
+		Bonuses aas_;
+	};
+} /*EQEmu*/
+
+#endif
@@ -2713,6 +2713,8 @@ bool Database::GetZoneGraveyard(const uint32 graveyard_id, uint32* graveyard_zon
 }
 
 bool Database::LoadZoneNames() {
+	zonename_array.clear();
+
 	std::string query("SELECT zoneidnumber, short_name FROM zone");
 
 	auto results = QueryDatabase(query);
@@ -3191,11 +3193,13 @@ void Database::AddReport(std::string who, std::string against, std::string lines
 	DoEscapeString(escape_str, lines.c_str(), lines.size());
 
 	std::string query = StringFormat("INSERT INTO reports (name, reported, reported_text) VALUES('%s', '%s', '%s')", who.c_str(), against.c_str(), escape_str);
-	auto results = QueryDatabase(query);
 	safe_delete_array(escape_str);
 
-	if (!results.Success())
-		LogFile->write(EQEmuLog::Error, "Error adding a report for %s: %s", who.c_str(), results.ErrorMessage().c_str());
+	// nothing waits on a report being stored
+	QueryDatabaseAsync(query, [who](MySQLRequestResult &results) {
+		if (!results.Success())
+			LogFile->write(EQEmuLog::Error, "Error adding a report for %s: %s", who.c_str(), results.ErrorMessage().c_str());
+	});
 }
 
 void Database::SetGroupID(const char* name, uint32 id, uint32 charid, uint32 ismerc) {
@@ -5,12 +5,18 @@
 #include "../common/misc_functions.h"
 
 #include "dbcore.h"
+#include "wake_event.h"
 
+#include <condition_variable>
+#include <deque>
 #include <errmsg.h>
 #include <fstream>
 #include <iostream>
+#include <mutex>
 #include <mysqld_error.h>
 #include <string.h>
+#include <thread>
+#include <vector>
 
 #ifdef _WINDOWS
 	#define snprintf	_snprintf
@@ -37,9 +43,52 @@ DBcore::DBcore() {
 	pCompress = false;
 	pSSL = false;
 	pStatus = Closed;
+	pAsync = nullptr;
+	pAsyncConnections = DBCORE_ASYNC_CONNECTIONS;
 }
 
+// Queries waiting for a pooled connection, and results waiting for ProcessAsyncResults()
+struct DBcore::AsyncState {
+	struct Job {
+		std::string query;
+		QueryCallback callback;
+	};
+	struct Done {
+		QueryCallback callback;
+		MySQLRequestResult results;
+	};
+
+	AsyncState() : stopping(false), wake(nullptr), port(0), compress(false), ssl(false) { }
+
+	std::mutex jobs_lock;
+	std::condition_variable jobs_ready;
+	std::deque<Job> jobs;
+	bool stopping;
+	std::vector<std::thread> workers;
+
+	std::mutex done_lock;
+	std::deque<Done> done;
+	EQEmu::WakeEvent *wake;
+
+	// copied from the owning connection when the workers start
+	std::string host, user, password, database;
+	uint32 port;
+	bool compress, ssl;
+};
+
 DBcore::~DBcore() {
+	if (pAsync) {
+		// queued queries still go out, only their callbacks are lost
+		{
+			std::lock_guard<std::mutex> lock(pAsync->jobs_lock);
+			pAsync->stopping = true;
+		}
+		pAsync->jobs_ready.notify_all();
+		for (auto &worker : pAsync->workers)
+			worker.join();
+		safe_delete(pAsync);
+	}
+	ClearStatements();
 	mysql_close(&mysql);
 	safe_delete_array(pHost);
 	safe_delete_array(pUser);
@@ -47,6 +96,50 @@ DBcore::~DBcore() {
 	safe_delete_array(pDatabase);
 }
 
+EQEmu::PreparedQuery DBcore::Prepare(const std::string &query) {
+	LockMutex lock(&MDatabase);
+
+	auto iter = pStatements.find(query);
+	if (iter != pStatements.end()) {
+		// a lost connection only shows up as a failed execute, reconnect before handing the statement out again
+		uint32 errnum = iter->second->GetErrorNumber();
+		if (errnum == CR_SERVER_GONE_ERROR || errnum == CR_SERVER_LOST)
+			pStatus = Error;
+	}
+
+	if (pStatus != Connected)
+		Open();
+
+	// failed prepares and statements invalidated by a reconnect are kept, and prepared again in place on the
+	// next call, so a handle still holding one never points at freed memory
+	EQEmu::PreparedStatement *statement = nullptr;
+	if (iter != pStatements.end()) {
+		statement = iter->second;
+		if (!statement->IsValid() && !statement->Prepare(&mysql))
+			std::cout << "DB Prepare Error " << statement->GetError() << std::endl;
+	}
+	else {
+		statement = new EQEmu::PreparedStatement(&mysql, query);
+		pStatements[query] = statement;
+
+		if (!statement->IsValid())
+			std::cout << "DB Prepare Error " << statement->GetError() << std::endl;
+	}
+
+	return EQEmu::PreparedQuery(&MDatabase, statement);
+}
+
+void DBcore::ClearStatements() {
+	for (auto iter = pStatements.begin(); iter != pStatements.end(); ++iter)
+		safe_delete(iter->second);
+	pStatements.clear();
+}
+
+void DBcore::InvalidateStatements() {
+	for (auto iter = pStatements.begin(); iter != pStatements.end(); ++iter)
+		iter->second->Invalidate();
+}
+
 // Sends the MySQL server a keepalive
 void DBcore::ping() {
 	if (!MDatabase.trylock()) {
@@ -63,6 +156,33 @@ MySQLRequestResult DBcore::QueryDatabase(std::string query, bool retryOnFailureO
 }
 
 MySQLRequestResult DBcore::QueryDatabase(const char* query, uint32 querylen, bool retryOnFailureOnce)
+{
+	return RunQuery(query, querylen, retryOnFailureOnce, true);
+}
+
+MySQLRequestResult DBcore::QueryDatabaseUnbuffered(std::string query)
+{
+	return RunQuery(query.c_str(), query.length(), true, false);
+}
+
+bool DBcore::UnbufferedResultComplete(std::string &error)
+{
+	LockMutex lock(&MDatabase);
+
+	unsigned int errorNumber = mysql_errno(&mysql);
+	if (errorNumber == 0)
+		return true;
+
+	if (errorNumber == CR_SERVER_LOST || errorNumber == CR_SERVER_GONE_ERROR)
+		pStatus = Error;
+
+	char errbuf[MYSQL_ERRMSG_SIZE];
+	snprintf(errbuf, MYSQL_ERRMSG_SIZE, "#%i: %s", errorNumber, mysql_error(&mysql));
+	error = errbuf;
+	return false;
+}
+
+MySQLRequestResult DBcore::RunQuery(const char* query, uint32 querylen, bool retryOnFailureOnce, bool buffered)
 {
 	LockMutex lock(&MDatabase);
 
@@ -85,7 +205,7 @@ MySQLRequestResult DBcore::QueryDatabase(const char* query, uint32 querylen, boo
 			if (retryOnFailureOnce)
 			{
 				std::cout << "Database Error: Lost connection, attempting to recover...." << std::endl;
-				MySQLRequestResult requestResult = QueryDatabase(query, querylen, false);
+				MySQLRequestResult requestResult = RunQuery(query, querylen, false, buffered);
 
 				if (requestResult.Success())
 				{
@@ -127,10 +247,10 @@ MySQLRequestResult DBcore::QueryDatabase(const char* query, uint32 querylen, boo
 	}
 
 	// successful query. get results.
-	MYSQL_RES* res = mysql_store_result(&mysql);
+	MYSQL_RES* res = buffered ? mysql_store_result(&mysql) : mysql_use_result(&mysql);
 	uint32 rowCount = 0;
 
-	if (res != nullptr)
+	if (res != nullptr && buffered)
         rowCount = (uint32)mysql_num_rows(res);
 
 	MySQLRequestResult requestResult(res, (uint32)mysql_affected_rows(&mysql), rowCount, (uint32)mysql_field_count(&mysql), (uint32)mysql_insert_id(&mysql));
@@ -153,6 +273,113 @@ MySQLRequestResult DBcore::QueryDatabase(const char* query, uint32 querylen, boo
 	return requestResult;
 }
 
+DBcore::AsyncState *DBcore::GetAsync() {
+	LockMutex lock(&MDatabase);
+	if (!pAsync)
+		pAsync = new AsyncState;
+	return pAsync;
+}
+
+void DBcore::QueryDatabaseAsync(std::string query, QueryCallback callback) {
+	AsyncState *state = GetAsync();
+
+	// workers only ever change under MDatabase, so concurrent first calls start the pool once
+	bool pooled;
+	{
+		LockMutex lock(&MDatabase);
+		if (state->workers.empty()) {
+			state->host = pHost ? pHost : "";
+			state->user = pUser ? pUser : "";
+			state->password = pPassword ? pPassword : "";
+			state->database = pDatabase ? pDatabase : "";
+			state->port = pPort;
+			state->compress = pCompress;
+			state->ssl = pSSL;
+			for (uint32 i = 0; i < pAsyncConnections; i++)
+				state->workers.push_back(std::thread(&DBcore::AsyncWorker, state));
+		}
+		pooled = !state->workers.empty();
+	}
+
+	if (!pooled) {
+		// pool disabled, behave like the blocking call
+		MySQLRequestResult results = QueryDatabase(query);
+		if (callback)
+			callback(results);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(state->jobs_lock);
+		AsyncState::Job job;
+		job.query = std::move(query);
+		job.callback = std::move(callback);
+		state->jobs.push_back(std::move(job));
+	}
+	state->jobs_ready.notify_one();
+}
+
+void DBcore::AsyncWorker(AsyncState *state) {
+	mysql_thread_init();
+	{
+		// each worker has a connection of its own, with the usual reconnect handling
+		DBcore connection;
+		uint32 errnum = 0;
+		char errbuf[MYSQL_ERRMSG_SIZE];
+		errbuf[0] = 0;
+		if (!connection.Open(state->host.c_str(), state->user.c_str(), state->password.c_str(), state->database.c_str(),
+				state->port, &errnum, errbuf, state->compress, state->ssl))
+			std::cout << "Async database connection failed, " << errbuf << std::endl;
+
+		for (;;) {
+			AsyncState::Job job;
+			{
+				std::unique_lock<std::mutex> lock(state->jobs_lock);
+				state->jobs_ready.wait(lock, [state] { return state->stopping || !state->jobs.empty(); });
+				if (state->jobs.empty())
+					break;
+				job = std::move(state->jobs.front());
+				state->jobs.pop_front();
+			}
+
+			MySQLRequestResult results = connection.QueryDatabase(job.query);
+			if (!job.callback)
+				continue;
+
+			std::lock_guard<std::mutex> lock(state->done_lock);
+			AsyncState::Done done;
+			done.callback = std::move(job.callback);
+			done.results = std::move(results);
+			state->done.push_back(std::move(done));
+			if (state->wake)
+				state->wake->Signal();
+		}
+	}
+	mysql_thread_end();
+}
+
+uint32 DBcore::ProcessAsyncResults() {
+	if (!pAsync)
+		return 0;
+
+	std::deque<AsyncState::Done> ready;
+	{
+		std::lock_guard<std::mutex> lock(pAsync->done_lock);
+		ready.swap(pAsync->done);
+	}
+
+	for (auto &done : ready)
+		done.callback(done.results);
+
+	return ready.size();
+}
+
+void DBcore::SetAsyncWakeEvent(EQEmu::WakeEvent *ev) {
+	AsyncState *state = GetAsync();
+	std::lock_guard<std::mutex> lock(state->done_lock);
+	state->wake = ev;
+}
+
 void DBcore::TransactionBegin() {
 	QueryDatabase("START TRANSACTION");
 }
@@ -171,6 +398,14 @@ uint32 DBcore::DoEscapeString(char* tobuf, const char* frombuf, uint32 fromlen)
 	return mysql_real_escape_string(&mysql, tobuf, frombuf, fromlen);
 }
 
+void DBcore::Close() {
+	LockMutex lock(&MDatabase);
+	InvalidateStatements();
+	mysql_close(&mysql);
+	mysql_init(&mysql);
+	pStatus = Closed;
+}
+
 bool DBcore::Open(const char* iHost, const char* iUser, const char* iPassword, const char* iDatabase,uint32 iPort, uint32* errnum, char* errbuf, bool iCompress, bool iSSL) {
 	LockMutex lock(&MDatabase);
 	safe_delete(pHost);
@@ -194,6 +429,8 @@ bool DBcore::Open(uint32* errnum, char* errbuf) {
 	if (GetStatus() == Connected)
 		return true;
 	if (GetStatus() == Error) {
+		// statements die with the connection they were prepared on, Prepare() makes them again on the new one
+		InvalidateStatements();
 		mysql_close(&mysql);
 		mysql_init(&mysql);		// Initialize structure again
 	}
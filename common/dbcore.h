@@ -8,31 +8,68 @@
 
 #include "../common/mutex.h"
 #include "../common/mysql_request_result.h"
+#include "../common/prepared_statement.h"
 #include "../common/types.h"
 
 #include <mysql.h>
 #include <string.h>
+#include <functional>
+#include <map>
+#include <string>
+
+// Connections opened for QueryDatabaseAsync, in addition to the one QueryDatabase uses
+#ifndef DBCORE_ASYNC_CONNECTIONS
+#define DBCORE_ASYNC_CONNECTIONS 2
+#endif
+
+namespace EQEmu {
+	class WakeEvent;
+}
 
 class DBcore {
 public:
 	enum eStatus { Closed, Connected, Error };
+	typedef std::function<void(MySQLRequestResult &results)> QueryCallback;
 
 	DBcore();
 	~DBcore();
 	eStatus	GetStatus() { return pStatus; }
 	MySQLRequestResult	QueryDatabase(const char* query, uint32 querylen, bool retryOnFailureOnce = true);
 	MySQLRequestResult	QueryDatabase(std::string query, bool retryOnFailureOnce = true);
+	// Rows are read from the server as the result is iterated instead of being buffered first, and RowCount()
+	// is always 0. Nothing else may be sent on this connection until the result is read out or destroyed.
+	MySQLRequestResult	QueryDatabaseUnbuffered(std::string query);
+	// A dropped connection just ends the iteration of an unbuffered result, so call this once the last row has
+	// been read. False, with the reason in error, if the rows stopped early.
+	bool	UnbufferedResultComplete(std::string &error);
+	// Runs the query on one of the pooled connections. The callback, if any, runs inside ProcessAsyncResults()
+	// on whichever thread calls it. Async queries are not ordered with each other or with QueryDatabase.
+	void	QueryDatabaseAsync(std::string query, QueryCallback callback = nullptr);
+	uint32	ProcessAsyncResults();	// returns how many callbacks ran
+	void	SetAsyncWakeEvent(EQEmu::WakeEvent *ev);	// signalled when a result is waiting for ProcessAsyncResults()
+	void	SetAsyncConnections(uint32 count) { pAsyncConnections = count; }	// only before the first async query
+	// Server side prepared statement on the primary connection, prepared once per distinct query text and
+	// reused. The connection stays locked until the returned handle is destroyed, so keep it short lived.
+	EQEmu::PreparedQuery	Prepare(const std::string &query);
 	void TransactionBegin();
 	void TransactionCommit();
 	void TransactionRollback();
 	uint32	DoEscapeString(char* tobuf, const char* frombuf, uint32 fromlen);
 	void	ping();
+	void	Close();	// drops the connection and its statements, the next query connects again
 	MYSQL*	getMySQL(){ return &mysql; }
 
 protected:
 	bool	Open(const char* iHost, const char* iUser, const char* iPassword, const char* iDatabase, uint32 iPort, uint32* errnum = 0, char* errbuf = 0, bool iCompress = false, bool iSSL = false);
 private:
+	struct AsyncState;
+
 	bool	Open(uint32* errnum = 0, char* errbuf = 0);
+	MySQLRequestResult	RunQuery(const char* query, uint32 querylen, bool retryOnFailureOnce, bool buffered);
+	AsyncState*	GetAsync();
+	static void	AsyncWorker(AsyncState *state);
+	void	ClearStatements();
+	void	InvalidateStatements();
 
 	MYSQL	mysql;
 	Mutex	MDatabase;
@@ -46,6 +83,10 @@ private:
 	uint32	pPort;
 	bool	pSSL;
 
+	AsyncState*	pAsync;
+	uint32	pAsyncConnections;
+
+	std::map<std::string, EQEmu::PreparedStatement*>	pStatements;
 };
 
 
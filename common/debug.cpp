@@ -1,5 +1,6 @@
 #include <iostream>
 #include <string>
+#include <string.h>
 
 #ifdef _WINDOWS
 	#include <process.h>
@@ -44,6 +45,8 @@ namespace ConsoleColor {
 #include "debug.h"
 #include "misc_functions.h"
 #include "platform.h"
+#include "wake_event.h"
+#include <thread>
 
 #ifndef va_copy
 	#define va_copy(d,s) ((d) = (s))
@@ -56,7 +59,49 @@ EQEmuLog *LogFile = &realLogFile;
 static const char* FileNames[EQEmuLog::MaxLogID] = { "logs/eqemu", "logs/eqemu", "logs/eqemu_error", "logs/eqemu_debug", "logs/eqemu_quest", "logs/eqemu_commands", "logs/crash" };
 static const char* LogNames[EQEmuLog::MaxLogID] = { "Status", "Normal", "Error", "Debug", "Quest", "Command", "Crash" };
 
+struct EQEmuLog::Writer {
+	Writer() : stop(false) { }
+
+	std::thread thread;
+	EQEmu::WakeEvent wake;
+	std::atomic<bool> stop;
+};
+
+#ifdef _WINDOWS
+static void SetConsoleColor(EQEmuLog::LogIDs id)
+{
+	HANDLE  console_handle;
+	console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
+
+	CONSOLE_FONT_INFOEX info = { 0 };
+	info.cbSize = sizeof(info);
+	info.dwFontSize.Y = 12; // leave X as zero
+	info.FontWeight = FW_NORMAL;
+	wcscpy(info.FaceName, L"Lucida Console");
+	SetCurrentConsoleFontEx(console_handle, NULL, &info);
+
+	if (id == EQEmuLog::LogIDs::Status){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
+	if (id == EQEmuLog::LogIDs::Error){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
+	if (id == EQEmuLog::LogIDs::Normal){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightGreen); }
+	if (id == EQEmuLog::LogIDs::Debug){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
+	if (id == EQEmuLog::LogIDs::Quest){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightCyan); }
+	if (id == EQEmuLog::LogIDs::Commands){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightMagenta); }
+	if (id == EQEmuLog::LogIDs::Crash){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
+}
+
+static void ResetConsoleColor()
+{
+	/* Always set back to white*/
+	SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), ConsoleColor::Colors::White);
+}
+#endif
+
 EQEmuLog::EQEmuLog()
+: writer(nullptr),
+  writerStarted(false),
+  dropped(0),
+  reportedDropped(0),
+  stampTime(0)
 {
 	for (int i = 0; i < MaxLogID; i++) {
 		fp[i] = 0;
@@ -64,6 +109,7 @@ EQEmuLog::EQEmuLog()
 		logCallbackBuf[i] = nullptr;
 		logCallbackPva[i] = nullptr;
 	}
+	stampText[0] = '\0';
 	pLogStatus[EQEmuLog::LogIDs::Status] = LOG_LEVEL_STATUS;
 	pLogStatus[EQEmuLog::LogIDs::Normal] = LOG_LEVEL_NORMAL;
 	pLogStatus[EQEmuLog::LogIDs::Error] = LOG_LEVEL_ERROR;
@@ -77,8 +123,15 @@ EQEmuLog::EQEmuLog()
 EQEmuLog::~EQEmuLog()
 {
 	logFileValid = false;
+	if (writer) {
+		writer->stop = true;
+		writer->wake.Signal();
+		writer->thread.join();
+		safe_delete(writer);
+	}
+	LockMutex lock(&MWrite);	//to prevent termination race
+	drain();
 	for (int i = 0; i < MaxLogID; i++) {
-		LockMutex lock(&MLog[i]);	//to prevent termination race
 		if (fp[i]) {
 			fclose(fp[i]);
 		}
@@ -133,106 +186,218 @@ bool EQEmuLog::open(LogIDs id)
 		return false;
 	}
 	fputs("---------------------------------------------\n", fp[id]);
-	write(id, "Starting Log: %s", filename);
+	fprintf(fp[id], "%sStarting Log: %s\n", stamp(time(nullptr)), filename);
 	return true;
 }
 
-bool EQEmuLog::write(LogIDs id, const char *fmt, ...)
+void EQEmuLog::startWriter()
 {
-	if (!logFileValid) {
+	LockMutex lock(&MOpen);
+	if (writerStarted) {
+		return;
+	}
+	//if the thread cant be started every message is written on the thread that logs it
+	try {
+		writer = new Writer;
+		writer->thread = std::thread(&EQEmuLog::writerLoop, this);
+	} catch (...) {
+		std::cerr << "Unable to start the log writer thread, logging synchronously" << std::endl;
+		safe_delete(writer);
+	}
+	writerStarted = true;
+}
+
+void EQEmuLog::writerLoop()
+{
+	while (!writer->stop) {
+		writer->wake.Wait(250);
+		LockMutex lock(&MWrite);
+		drain();
+	}
+}
+
+void EQEmuLog::Flush()
+{
+	LockMutex lock(&MWrite);
+	drain();
+}
+
+void EQEmuLog::Suspend()
+{
+	//a forked child gets neither the thread nor a file named after its own pid, so both are started over on demand
+	if (writer) {
+		writer->stop = true;
+		writer->wake.Signal();
+		writer->thread.join();
+		safe_delete(writer);
+	}
+	writerStarted = false;
+	LockMutex lock(&MWrite);
+	drain();
+	LockMutex open_lock(&MOpen);
+	for (int i = 0; i < MaxLogID; i++) {
+		if (fp[i]) {
+			fclose(fp[i]);
+			fp[i] = 0;
+		}
+	}
+	stampTime = 0;	//the stamp carries the pid too
+}
+
+bool EQEmuLog::post(LogIDs id, const char *text, uint32 length)
+{
+	//a crash message has to be on disk before the process goes away, and big messages dont fit a record
+	if (id == Crash || length >= EQEMU_LOG_RECORD_SIZE) {
+		LockMutex lock(&MWrite);
+		drain();
+		output(id, time(nullptr), text, length);
+		if (fp[id]) {
+			fflush(fp[id]);
+		}
+		return true;
+	}
+	if (!writerStarted) {
+		startWriter();
+	}
+	EQEmu::LogQueue::Record *r = queue.Reserve();
+	if (r == nullptr) {
+		dropped++;	//reported by the writer once it catches up
 		return false;
 	}
-	if (id >= MaxLogID) {
+	r->id = id;
+	r->when = time(nullptr);
+	r->length = length;
+	memcpy(r->text, text, length);
+	queue.Commit(r);
+	if (writer) {
+		writer->wake.Signal();
+	} else {
+		Flush();
+	}
+	return true;
+}
+
+bool EQEmuLog::postf(LogIDs id, const char *prefix, const char *fmt, va_list args)
+{
+	char text[EQEMU_LOG_RECORD_SIZE];
+	int length = 0;
+	if (prefix) {
+		length = snprintf(text, sizeof(text), "%s", prefix);
+		if (length < 0 || length >= (int)sizeof(text)) {
+			length = 0;
+			prefix = nullptr;	//absurdly long prefix, dropped rather than truncated mid-way
+		}
+	}
+	va_list tmpargptr;
+	va_copy(tmpargptr, args);
+	int formatted = vsnprintf(text + length, sizeof(text) - length, fmt, tmpargptr);
+	va_end(tmpargptr);
+	if (formatted < 0) {
 		return false;
 	}
+	if (length + formatted < (int)sizeof(text)) {
+		return post(id, text, length + formatted);
+	}
+	std::string longText(prefix ? prefix : "");
+	longText.resize(length + formatted + 1);
+	va_copy(tmpargptr, args);
+	vsnprintf(&longText[length], formatted + 1, fmt, tmpargptr);
+	va_end(tmpargptr);
+	return post(id, longText.c_str(), length + formatted);
+}
+
+void EQEmuLog::drain()
+{
+	EQEmu::LogQueue::Record *r;
+	while ((r = queue.Peek()) != nullptr) {
+		output((LogIDs)r->id, r->when, r->text, r->length);
+		queue.Release(r);
+	}
+	uint32 lost = dropped;
+	if (lost != reportedDropped) {
+		char msg[128];
+		int length = snprintf(msg, sizeof(msg), "%u log messages were dropped because the log queue was full", lost - reportedDropped);
+		reportedDropped = lost;
+		output(Error, time(nullptr), msg, length);
+	}
+	for (int i = 0; i < MaxLogID; i++) {
+		if (fp[i]) {
+			fflush(fp[i]);
+		}
+	}
+	fflush(stdout);
+	fflush(stderr);
+}
+
+const char *EQEmuLog::stamp(time_t when)
+{
+	//most messages land in the same second as the one before, so the formatted time is reused
+	if (when != stampTime || stampText[0] == '\0') {
+		struct tm *newtime = localtime(&when);
+		#ifndef NO_PIDLOG
+		snprintf(stampText, sizeof(stampText), "[%02d.%02d. - %02d:%02d:%02d] ", newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
+		#else
+		snprintf(stampText, sizeof(stampText), "%04i [%02d.%02d. - %02d:%02d:%02d] ", getpid(), newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
+		#endif
+		stampTime = when;
+	}
+	return stampText;
+}
+
+void EQEmuLog::output(LogIDs id, time_t when, const char *text, uint32 length)
+{
 	bool dofile = false;
 	if (pLogStatus[id] & 1) {
 		dofile = open(id);
 	}
-	if (!(dofile || pLogStatus[id] & 2)) {
-		return false;
-	}
-	LockMutex lock(&MLog[id]);
-	if (!logFileValid) {
-		return false;    //check again for threading race reasons (to avoid two mutexes)
-	}
-	time_t aclock;
-	struct tm *newtime;
-	time( &aclock ); /* Get time in seconds */
-	newtime = localtime( &aclock ); /* Convert time to struct */
-	if (dofile)
-	#ifndef NO_PIDLOG
-		fprintf(fp[id], "[%02d.%02d. - %02d:%02d:%02d] ", newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
-	#else
-		fprintf(fp[id], "%04i [%02d.%02d. - %02d:%02d:%02d] ", getpid(), newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
-	#endif
-	va_list argptr, tmpargptr;
-	va_start(argptr, fmt);
 	if (dofile) {
-		va_copy(tmpargptr, argptr);
-		vfprintf( fp[id], fmt, tmpargptr );
-	}
-	if (logCallbackFmt[id]) {
-		msgCallbackFmt p = logCallbackFmt[id];
-		va_copy(tmpargptr, argptr);
-		p(id, fmt, tmpargptr );
+		fputs(stamp(when), fp[id]);
+		fwrite(text, 1, length, fp[id]);
+		fputc('\n', fp[id]);
 	}
 	if (pLogStatus[id] & 2) {
 		if (pLogStatus[id] & 8) {
 			fprintf(stderr, "[%s] ", LogNames[id]);
-			vfprintf( stderr, fmt, argptr );
-		} 
+			fwrite(text, 1, length, stderr);
+			fputc('\n', stderr);
+		}
 		/* This is what's outputted to console */
 		else {
-
 #ifdef _WINDOWS
-			HANDLE  console_handle;
-			console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
-
-			CONSOLE_FONT_INFOEX info = { 0 };
-			info.cbSize = sizeof(info);
-			info.dwFontSize.Y = 12; // leave X as zero
-			info.FontWeight = FW_NORMAL;
-			wcscpy(info.FaceName, L"Lucida Console");
-			SetCurrentConsoleFontEx(console_handle, NULL, &info);
-
-			if (id == EQEmuLog::LogIDs::Status){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
-			if (id == EQEmuLog::LogIDs::Error){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
-			if (id == EQEmuLog::LogIDs::Normal){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightGreen); }
-			if (id == EQEmuLog::LogIDs::Debug){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
-			if (id == EQEmuLog::LogIDs::Quest){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightCyan); } 
-			if (id == EQEmuLog::LogIDs::Commands){	SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightMagenta); }
-			if (id == EQEmuLog::LogIDs::Crash){		SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); } 
+			SetConsoleColor(id);
 #endif
-
 			fprintf(stdout, "[%s] ", LogNames[id]);
-			vfprintf( stdout, fmt, argptr );
-
+			fwrite(text, 1, length, stdout);
+			fputc('\n', stdout);
 #ifdef _WINDOWS
-			/* Always set back to white*/
-			SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::White);
+			ResetConsoleColor();
 #endif
 		}
 	}
-	va_end(argptr);
-	if (dofile) {
-		fprintf(fp[id], "\n");
-	}
+}
 
-	/* Print Lind Endings */
-	if (pLogStatus[id] & 2) {
-		if (pLogStatus[id] & 8) {
-			fprintf(stderr, "\n");
-			fflush(stderr);
-		} else {
-			fprintf(stdout, "\n");
-			fflush(stdout);
-		}
+bool EQEmuLog::write(LogIDs id, const char *fmt, ...)
+{
+	if (!logFileValid) {
+		return false;
 	}
-	if (dofile) {
-		fflush(fp[id]);
+	if (id >= MaxLogID) {
+		return false;
 	}
-	return true;
+	if (!enabled(id)) {
+		return false;
+	}
+	va_list argptr, tmpargptr;
+	va_start(argptr, fmt);
+	if (logCallbackFmt[id]) {
+		msgCallbackFmt p = logCallbackFmt[id];
+		va_copy(tmpargptr, argptr);
+		p(id, fmt, tmpargptr );
+		va_end(tmpargptr);
+	}
+	bool res = postf(id, nullptr, fmt, argptr);
+	va_end(argptr);
+	return res;
 }
 
 //write with Prefix and a VA_list
@@ -244,89 +409,17 @@ bool EQEmuLog::writePVA(LogIDs id, const char *prefix, const char *fmt, va_list
 	if (id >= MaxLogID) {
 		return false;
 	}
-	bool dofile = false;
-	if (pLogStatus[id] & 1) {
-		dofile = open(id);
-	}
-	if (!(dofile || pLogStatus[id] & 2)) {
+	if (!enabled(id)) {
 		return false;
 	}
-	LockMutex lock(&MLog[id]);
-	if (!logFileValid) {
-		return false;    //check again for threading race reasons (to avoid two mutexes)
-	}
-	time_t aclock;
-	struct tm *newtime;
-	time( &aclock ); /* Get time in seconds */
-	newtime = localtime( &aclock ); /* Convert time to struct */
 	va_list tmpargptr;
-	if (dofile) {
-		#ifndef NO_PIDLOG
-		fprintf(fp[id], "[%02d.%02d. - %02d:%02d:%02d] %s", newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec, prefix);
-		#else
-		fprintf(fp[id], "%04i [%02d.%02d. - %02d:%02d:%02d] %s", getpid(), newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec, prefix);
-		#endif
-		va_copy(tmpargptr, argptr);
-		vfprintf( fp[id], fmt, tmpargptr );
-	}
 	if (logCallbackPva[id]) {
 		msgCallbackPva p = logCallbackPva[id];
 		va_copy(tmpargptr, argptr);
 		p(id, prefix, fmt, tmpargptr );
+		va_end(tmpargptr);
 	}
-	if (pLogStatus[id] & 2) {
-		if (pLogStatus[id] & 8) {
-			fprintf(stderr, "[%s] %s", LogNames[id], prefix);
-			vfprintf( stderr, fmt, argptr );
-		} 
-		/* Console Output */
-		else {
-			
-
-#ifdef _WINDOWS
-			HANDLE  console_handle;
-			console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
-
-			CONSOLE_FONT_INFOEX info = { 0 };
-			info.cbSize = sizeof(info);
-			info.dwFontSize.Y = 12; // leave X as zero
-			info.FontWeight = FW_NORMAL;
-			wcscpy(info.FaceName, L"Lucida Console");
-			SetCurrentConsoleFontEx(console_handle, NULL, &info);
-
-			if (id == EQEmuLog::LogIDs::Status){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
-			if (id == EQEmuLog::LogIDs::Error){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
-			if (id == EQEmuLog::LogIDs::Normal){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightGreen); }
-			if (id == EQEmuLog::LogIDs::Debug){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
-			if (id == EQEmuLog::LogIDs::Quest){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightCyan); }
-			if (id == EQEmuLog::LogIDs::Commands){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightMagenta); }
-			if (id == EQEmuLog::LogIDs::Crash){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
-#endif
-
-			fprintf(stdout, "[%s] %s", LogNames[id], prefix);
-			vfprintf(stdout, fmt, argptr);
-
-#ifdef _WINDOWS
-			/* Always set back to white*/
-			SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::White);
-#endif
-		}
-	}
-	va_end(argptr);
-	if (dofile) {
-		fprintf(fp[id], "\n");
-	}
-	if (pLogStatus[id] & 2) {
-		if (pLogStatus[id] & 8) {
-			fprintf(stderr, "\n");
-		} else {
-			fprintf(stdout, "\n");
-		}
-	}
-	if (dofile) {
-		fflush(fp[id]);
-	}
-	return true;
+	return postf(id, prefix, fmt, argptr);
 }
 
 bool EQEmuLog::writebuf(LogIDs id, const char *buf, uint8 size, uint32 count)
@@ -337,77 +430,14 @@ bool EQEmuLog::writebuf(LogIDs id, const char *buf, uint8 size, uint32 count)
 	if (id >= MaxLogID) {
 		return false;
 	}
-	bool dofile = false;
-	if (pLogStatus[id] & 1) {
-		dofile = open(id);
-	}
-	if (!(dofile || pLogStatus[id] & 2)) {
+	if (!enabled(id)) {
 		return false;
 	}
-	LockMutex lock(&MLog[id]);
-	if (!logFileValid) {
-		return false;    //check again for threading race reasons (to avoid two mutexes)
-	}
-	time_t aclock;
-	struct tm *newtime;
-	time( &aclock ); /* Get time in seconds */
-	newtime = localtime( &aclock ); /* Convert time to struct */
-	if (dofile)
-	#ifndef NO_PIDLOG
-		fprintf(fp[id], "[%02d.%02d. - %02d:%02d:%02d] ", newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
-	#else
-		fprintf(fp[id], "%04i [%02d.%02d. - %02d:%02d:%02d] ", getpid(), newtime->tm_mon + 1, newtime->tm_mday, newtime->tm_hour, newtime->tm_min, newtime->tm_sec);
-	#endif
-	if (dofile) {
-		fwrite(buf, size, count, fp[id]);
-		fprintf(fp[id], "\n");
-	}
 	if (logCallbackBuf[id]) {
 		msgCallbackBuf p = logCallbackBuf[id];
 		p(id, buf, size, count);
 	}
-	if (pLogStatus[id] & 2) {
-		if (pLogStatus[id] & 8) {
-			fprintf(stderr, "[%s] ", LogNames[id]);
-			fwrite(buf, size, count, stderr);
-			fprintf(stderr, "\n");
-		} else {
-#ifdef _WINDOWS
-			HANDLE  console_handle;
-			console_handle = GetStdHandle(STD_OUTPUT_HANDLE);
-
-			CONSOLE_FONT_INFOEX info = { 0 };
-			info.cbSize = sizeof(info);
-			info.dwFontSize.Y = 12; // leave X as zero
-			info.FontWeight = FW_NORMAL;
-			wcscpy(info.FaceName, L"Lucida Console");
-			SetCurrentConsoleFontEx(console_handle, NULL, &info);
-
-			if (id == EQEmuLog::LogIDs::Status){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::Yellow); }
-			if (id == EQEmuLog::LogIDs::Error){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
-			if (id == EQEmuLog::LogIDs::Normal){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightGreen); }
-			if (id == EQEmuLog::LogIDs::Debug){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightGreen); }
-			if (id == EQEmuLog::LogIDs::Quest){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightCyan); }
-			if (id == EQEmuLog::LogIDs::Commands){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightMagenta); }
-			if (id == EQEmuLog::LogIDs::Crash){ SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::LightRed); }
-#endif
-
-			fprintf(stdout, "[%s] ", LogNames[id]);
-			fwrite(buf, size, count, stdout);
-			fprintf(stdout, "\n");
-
-#ifdef _WINDOWS
-			/* Always set back to white*/
-			SetConsoleTextAttribute(console_handle, ConsoleColor::Colors::White);
-#endif
-
-
-		}
-	}
-	if (dofile) {
-		fflush(fp[id]);
-	}
-	return true;
+	return post(id, buf, size * count);
 }
 
 bool EQEmuLog::writeNTS(LogIDs id, bool dofile, const char *fmt, ...)
@@ -446,18 +476,22 @@ bool EQEmuLog::Dump(LogIDs id, uint8* data, uint32 size, uint32 cols, uint32 ski
 	if (id >= MaxLogID) {
 		return false;
 	}
-	bool dofile = false;
-	if (pLogStatus[id] & 1) {
-		dofile = open(id);
-	}
-	if (!(dofile || pLogStatus[id] & 2)) {
+	if (!enabled(id)) {
 		return false;
 	}
-	LockMutex lock(&MLog[id]);
+	//the dump is written in pieces, so it goes out directly once everything queued before it has been written
+	LockMutex lock(&MWrite);
 	if (!logFileValid) {
 		return false;    //check again for threading race reasons (to avoid two mutexes)
 	}
-	write(id, "Dumping Packet: %i", size);
+	drain();
+	bool dofile = false;
+	if (pLogStatus[id] & 1) {
+		dofile = open(id);
+	}
+	char header[64];
+	int headerLength = snprintf(header, sizeof(header), "Dumping Packet: %i", size);
+	output(id, time(nullptr), header, headerLength);
 	// Output as HEX
 	int beginningOfLineOffset = 0;
 	uint32 indexInData;
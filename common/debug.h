@@ -70,6 +70,7 @@
 #include "logsys.h"
 
 #include "../common/mutex.h"
+#include "../common/log_queue.h"
 #include <stdio.h>
 #include <stdarg.h>
 
@@ -107,14 +108,36 @@ public:
 	bool write(LogIDs id, const char *fmt, ...);
 	bool writePVA(LogIDs id, const char *prefix, const char *fmt, va_list args);
 	bool Dump(LogIDs id, uint8* data, uint32 size, uint32 cols=16, uint32 skip=0);
+	void Flush();	//writes out everything queued so far on the calling thread
+	void Suspend();	//stops the writer thread and closes the files until the next message, call before fork() with no other thread logging
+	uint32 GetDropped() const { return dropped; }
 private:
+	struct Writer;
+	void writerLoop();
+
 	bool open(LogIDs id);
 	bool writeNTS(LogIDs id, bool dofile, const char *fmt, ...); // no error checking, assumes is open, no locking, no timestamp, no newline
+	bool enabled(LogIDs id) const { return ((pLogStatus[id] & 1) && !(pLogStatus[id] & 4)) || (pLogStatus[id] & 2); }
+	bool post(LogIDs id, const char *text, uint32 length);
+	bool postf(LogIDs id, const char *prefix, const char *fmt, va_list args);
+	void startWriter();
+	void drain();	//caller holds MWrite
+	void output(LogIDs id, time_t when, const char *text, uint32 length);	//caller holds MWrite
+	const char *stamp(time_t when);	//caller holds MWrite
 
 	Mutex	MOpen;
-	Mutex	MLog[MaxLogID];
+	Mutex	MWrite;	//held by whichever thread is writing queued messages to the files
 	FILE*	fp[MaxLogID];
 
+	//messages are formatted by the caller and written out by a background thread
+	EQEmu::LogQueue	queue;
+	Writer*	writer;
+	std::atomic<bool>	writerStarted;
+	std::atomic<uint32>	dropped;
+	uint32	reportedDropped;
+	time_t	stampTime;
+	char	stampText[32];
+
 /* LogStatus: bitwise variable
 	1 = output to file
 	2 = output to stdout
@@ -31,6 +31,7 @@ tremendously.
 #include "emu_tcp_connection.h"
 #include "emu_tcp_server.h"
 #include "../common/servertalk.h"
+#include "../common/wake_event.h"
 
 #ifdef FREEBSD //Timothy Whitman - January 7, 2003
 	#define MSG_NOSIGNAL 0
@@ -67,7 +68,7 @@ EmuTCPConnection::EmuTCPConnection(uint32 ID, EmuTCPServer* iServer, SOCKET in_s
 	RelayServer = false;
 	RelayCount = 0;
 	RemoteID = 0;
-
+	wake_event = nullptr;
 }
 
 //client outgoing connection case (and client side relay)
@@ -87,6 +88,7 @@ EmuTCPConnection::EmuTCPConnection(bool iOldFormat, EmuTCPServer* iRelayServer,
 	pOldFormat = iOldFormat;
 	TCPMode = iMode;
 	PacketMode = packetModeZone;
+	wake_event = nullptr;
 #if TCPN_DEBUG_Memory >= 7
 	std::cout << "Constructor #1 on outgoing TCP# " << GetID() << std::endl;
 #endif
@@ -107,6 +109,7 @@ EmuTCPConnection::EmuTCPConnection(uint32 ID, EmuTCPServer* iServer, EmuTCPConne
 	ConnectionType = Incomming;
 	TCPMode = modePacket;
 	PacketMode = packetModeZone;
+	wake_event = nullptr;
 #if TCPN_DEBUG_Memory >= 7
 	std::cout << "Constructor #3 on outgoing TCP# " << GetID() << std::endl;
 #endif
@@ -272,6 +275,8 @@ void EmuTCPConnection::OutQueuePush(ServerPacket* pack) {
 	MOutQueueLock.lock();
 	OutQueue.push(pack);
 	MOutQueueLock.unlock();
+	if (wake_event)
+		wake_event->Signal();
 }
 
 
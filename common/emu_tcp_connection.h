@@ -4,6 +4,8 @@
 #include "tcp_connection.h"
 #include "timer.h"
 
+namespace EQEmu { class WakeEvent; }
+
 //moved out of TCPConnection:: to be more exportable
 #pragma pack(1)
 	struct EmuTCPNetPacket_Struct {
@@ -48,6 +50,8 @@ public:
 	virtual bool	SendPacket(EmuTCPNetPacket_Struct* tnps);
 	ServerPacket*	PopPacket(); // OutQueuePop()
 	void SetPacketMode(ePacketMode mode) { PacketMode = mode; }
+	//signalled whenever a packet is queued for PopPacket()
+	void SetWakeEvent(EQEmu::WakeEvent *ev) { wake_event = ev; }
 
 	eTCPMode		GetMode()	const		{ return TCPMode; }
 	ePacketMode		GetPacketMode() const	{ return(PacketMode); }
@@ -96,6 +100,7 @@ protected:
 	//output queue...
 	MyQueue<ServerPacket> OutQueue;
 	Mutex	MOutQueueLock;
+	EQEmu::WakeEvent *wake_event;
 };
 
 #endif /*EmuTCPCONNECTION_H_*/
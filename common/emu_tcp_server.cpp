@@ -1,10 +1,12 @@
 #include "debug.h"
 #include "emu_tcp_server.h"
 #include "emu_tcp_connection.h"
+#include "wake_event.h"
 
 EmuTCPServer::EmuTCPServer(uint16 iPort, bool iOldFormat)
 :	TCPServer<EmuTCPConnection>(iPort),
-	pOldFormat(iOldFormat)
+	pOldFormat(iOldFormat),
+	wake_event(nullptr)
 {
 }
 
@@ -25,7 +27,10 @@ void EmuTCPServer::Process() {
 void EmuTCPServer::CreateNewConnection(uint32 ID, SOCKET in_socket, uint32 irIP, uint16 irPort)
 {
 	EmuTCPConnection *conn = new EmuTCPConnection(ID, this, in_socket, irIP, irPort, pOldFormat);
+	conn->SetWakeEvent(wake_event);
 	AddConnection(conn);
+	if (wake_event)
+		wake_event->Signal();
 }
 
 
@@ -6,6 +6,7 @@
 class EmuTCPConnection;
 struct EmuTCPNetPacket_Struct;
 class ServerPacket;
+namespace EQEmu { class WakeEvent; }
 
 class EmuTCPServer : public TCPServer<EmuTCPConnection> {
 public:
@@ -19,6 +20,9 @@ public:
 	//special crap for relay management
 	EmuTCPConnection *FindConnection(uint32 iID);
 
+	//signalled on new connections, and handed to each connection for its inbound packets
+	void	SetWakeEvent(EQEmu::WakeEvent *ev) { wake_event = ev; }
+
 	//exposed for some crap we pull. Do not call from outside this object.
 	using TCPServer<EmuTCPConnection>::AddConnection;
 
@@ -28,6 +32,7 @@ protected:
 	virtual void CreateNewConnection(uint32 ID, SOCKET in_socket, uint32 irIP, uint16 irPort);
 
 	bool pOldFormat;
+	EQEmu::WakeEvent *wake_event;
 
 	//broadcast packet queue..
 	void	CheckInQueue();
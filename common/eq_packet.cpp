@@ -199,6 +199,44 @@ void EQRawApplicationPacket::DumpRawHeaderNoTime(uint16 seq, FILE *to) const
 #endif
 }
 
+EQProtocolPacket::EQProtocolPacket(uint16 op, const unsigned char *buf, uint32 len)
+:	BasePacket(),
+	opcode(op)
+{
+	acked = false;
+	resend = false;
+	sent_time = 0;
+	sent_count = 0;
+	pool_buffer = nullptr;
+	pool_capacity = 0;
+	timestamp.tv_sec = 0;
+	if (len > 0) {
+		uint32 capacity = 0;
+		SetPooledBuffer(PacketPool::AllocBuffer(len, capacity), capacity);
+		size = len;
+		if (buf)
+			memcpy(pBuffer, buf, len);
+		else
+			memset(pBuffer, 0, len);
+	}
+}
+
+EQProtocolPacket::~EQProtocolPacket()
+{
+	SetPooledBuffer(nullptr, 0);
+}
+
+void EQProtocolPacket::SetPooledBuffer(unsigned char *buffer, uint32 capacity)
+{
+	if (pBuffer && pBuffer == pool_buffer)
+		PacketPool::FreeBuffer(pBuffer, pool_capacity);
+	else
+		safe_delete_array(pBuffer);
+
+	pBuffer = pool_buffer = buffer;
+	pool_capacity = capacity;
+}
+
 uint32 EQProtocolPacket::serialize(unsigned char *dest) const
 {
 	if (opcode>0xff) {
@@ -258,26 +296,33 @@ uint32 offset;
 bool EQProtocolPacket::combine(const EQProtocolPacket *rhs)
 {
 bool result=false;
+uint32 capacity=0;
 	if (opcode==OP_Combined && size+rhs->size+5<256) {
-		unsigned char *tmpbuffer=new unsigned char [size+rhs->size+3];
+		if (pBuffer == pool_buffer && size+rhs->size+3 <= pool_capacity) {
+			//room left in the pooled block, append in place
+			uint32 offset=size;
+			pBuffer[offset++]=rhs->Size();
+			offset+=rhs->serialize(pBuffer+offset);
+			size=offset;
+			return true;
+		}
+		unsigned char *tmpbuffer=PacketPool::AllocBuffer(size+rhs->size+3, capacity);
 		memcpy(tmpbuffer,pBuffer,size);
 		uint32 offset=size;
 		tmpbuffer[offset++]=rhs->Size();
 		offset+=rhs->serialize(tmpbuffer+offset);
 		size=offset;
-		delete[] pBuffer;
-		pBuffer=tmpbuffer;
+		SetPooledBuffer(tmpbuffer, capacity);
 		result=true;
 	} else if (size+rhs->size+7<256) {
-		unsigned char *tmpbuffer=new unsigned char [size+rhs->size+6];
+		unsigned char *tmpbuffer=PacketPool::AllocBuffer(size+rhs->size+6, capacity);
 		uint32 offset=0;
 		tmpbuffer[offset++]=Size();
 		offset+=serialize(tmpbuffer+offset);
 		tmpbuffer[offset++]=rhs->Size();
 		offset+=rhs->serialize(tmpbuffer+offset);
 		size=offset;
-		delete[] pBuffer;
-		pBuffer=tmpbuffer;
+		SetPooledBuffer(tmpbuffer, capacity);
 		opcode=OP_Combined;
 		result=true;
 	}
@@ -380,8 +425,40 @@ uint32 flag_offset=0;
 	return newlen;
 }
 
+namespace {
+	/*
+		Per-thread record of how well each wire opcode has compressed lately.
+		Once an opcode has enough samples and deflate isn't buying us anything
+		(position updates are the usual offender), it goes out with the 0xa5
+		"uncompressed" flag and is only re-probed every CompressReprobe sends.
+	*/
+	struct CompressHistory {
+		uint32 key;
+		uint16 samples;
+		uint16 skipped;
+		uint32 raw_bytes;
+		uint32 packed_bytes;
+	};
+
+	const uint32 CompressHistorySize = 256;
+	const uint16 CompressMinSamples = 16;
+	const uint16 CompressReprobe = 64;
+	const uint32 CompressSkipPercent = 95;
+
+	CompressHistory &GetCompressHistory(uint32 key) {
+		static thread_local CompressHistory history[CompressHistorySize];
+
+		CompressHistory &h = history[(key ^ (key >> 16) ^ (key >> 8)) % CompressHistorySize];
+		if (h.key != key) {
+			memset(&h, 0, sizeof(h));
+			h.key = key;
+		}
+		return h;
+	}
+}
+
 uint32 EQProtocolPacket::Compress(const unsigned char *buffer, const uint32 length, unsigned char *newbuf, uint32 newbufsize) {
-uint32 flag_offset=1,newlength;
+uint32 flag_offset=1,newlength=0;
 	//dump_message_column(buffer,length,"Before: ");
 	newbuf[0]=buffer[0];
 	if (buffer[0]==0) {
@@ -389,7 +466,39 @@ uint32 flag_offset=1,newlength;
 		newbuf[1]=buffer[1];
 	}
 	if (length>30) {
-		newlength=DeflatePacket(buffer+flag_offset,length-flag_offset,newbuf+flag_offset+1,newbufsize);
+		//protocol opcode, plus the app opcode for plain OP_Packet sends
+		uint32 key = buffer[0] == 0 ? (buffer[1] << 16) : (0xff0000 | buffer[0]);
+		if (buffer[0] == 0 && buffer[1] == OP_Packet)
+			key |= buffer[4] | (buffer[5] << 8);
+
+		CompressHistory &h = GetCompressHistory(key);
+		bool probe = true;
+		if (h.samples >= CompressMinSamples && h.packed_bytes * 100ull >= h.raw_bytes * (uint64)CompressSkipPercent) {
+			if (++h.skipped < CompressReprobe)
+				probe = false;
+			else
+				h.skipped = 0;
+		}
+
+		if (probe) {
+			uint32 rawlength = length - flag_offset;
+			newlength = DeflatePacket(buffer+flag_offset,rawlength,newbuf+flag_offset+1,newbufsize-flag_offset-1);
+
+			h.raw_bytes += rawlength;
+			h.packed_bytes += newlength ? newlength : rawlength;
+			if (++h.samples >= CompressMinSamples * 2) {
+				h.samples /= 2;
+				h.raw_bytes /= 2;
+				h.packed_bytes /= 2;
+			}
+
+			//deflate failed or didn't shrink it, send it raw
+			if (newlength >= rawlength)
+				newlength = 0;
+		}
+	}
+
+	if (newlength) {
 		*(newbuf+flag_offset)=0x5a;
 		newlength+=flag_offset+1;
 	} else {
@@ -61,7 +61,8 @@ class EQProtocolPacket : public BasePacket {
 	friend class EQStream;
 	friend class EQStreamPair;
 public:
-	EQProtocolPacket(uint16 op, const unsigned char *buf, uint32 len) : BasePacket(buf,len), opcode(op) { acked = false; }
+	EQProtocolPacket(uint16 op, const unsigned char *buf, uint32 len);
+	virtual ~EQProtocolPacket();
 //	EQProtocolPacket(const unsigned char *buf, uint32 len);
 	bool combine(const EQProtocolPacket *rhs);
 	uint32 serialize (unsigned char *dest) const;
@@ -70,6 +71,11 @@ public:
 
 	bool acked;
 
+	//sequenced send tracking, only meaningful on the copy held in EQStream's SequencedQueue
+	bool resend;		//flagged for a selective resend by an out of order ack
+	uint32 sent_time;	//ms timestamp of the last transmission
+	uint16 sent_count;	//how many times it has gone out, RTT is only sampled when this is 1
+
 	virtual void build_raw_header_dump(char *buffer, uint16 seq=0xffff) const;
 	virtual void build_header_dump(char *buffer) const;
 	virtual void DumpRawHeader(uint16 seq=0xffff, FILE *to = stdout) const;
@@ -87,8 +93,15 @@ protected:
 
 	uint32 Size() const { return size+2; }
 
+	//swaps in a buffer from PacketPool, releasing the current one
+	void SetPooledBuffer(unsigned char *buffer, uint32 capacity);
+
 	//the actual raw EQ opcode
 	uint16 opcode;
+
+	//protocol packets never leave EQStream, so their buffers can come from PacketPool
+	unsigned char *pool_buffer;
+	uint32 pool_capacity;
 };
 
 class EQApplicationPacket : public EQPacket {
@@ -113,7 +126,7 @@ public:
 	virtual void DumpRawHeader(uint16 seq=0xffff, FILE *to = stdout) const;
 	virtual void DumpRawHeaderNoTime(uint16 seq=0xffff, FILE *to = stdout) const;
 
-	uint16 GetOpcodeBypass() { return opcode_bypass; }
+	uint16 GetOpcodeBypass() const { return opcode_bypass; }
 	void SetOpcodeBypass(uint16 v) { opcode_bypass = v; }
 
 protected:
@@ -72,9 +72,12 @@ void EQStream::init(bool resetSession) {
 	BytesWritten=0;
 	SequencedBase = 0;
 	NextSequencedSend = 0;
+	srtt = 0;
+	rttvar = 0;
+	sequenced_sent = 0;
+	sequenced_resent = 0;
 
 	if(GetExecutablePlatform() == ExePlatformWorld || GetExecutablePlatform() == ExePlatformZone) {
-		retransmittimer = Timer::GetCurrentTime();
 		retransmittimeout = 500 * RETRANSMIT_TIMEOUT_MULT;
 	}
 
@@ -304,10 +307,6 @@ void EQStream::ProcessPacket(EQProtocolPacket *p)
 #ifndef COLLECTOR
 			uint16 seq=ntohs(*(uint16 *)(p->pBuffer));
 			AckPackets(seq);
-
-			if(GetExecutablePlatform() == ExePlatformWorld || GetExecutablePlatform() == ExePlatformZone) {
-				retransmittimer = Timer::GetCurrentTime();
-			}
 #endif
 		}
 		break;
@@ -423,31 +422,41 @@ void EQStream::ProcessPacket(EQProtocolPacket *p)
 			}
 			//if the packet they got out of order is between our last acked packet and the last sent packet, then its valid.
 			if (CompareSequence(SequencedBase,seq) != SeqPast && CompareSequence(NextOutSeq,seq) == SeqPast) {
-				_log(NET__NET_TRACE, _L "Received OP_OutOfOrderAck for sequence %d, starting retransmit at the start of our unacked buffer (seq %d, was %d)." __L,
-					seq, SequencedBase, SequencedBase+NextSequencedSend);
+				uint16 sqsize = SequencedQueue.size();
+				uint16 index = seq - SequencedBase;
 
 				bool retransmit_acked_packets = false;
 				if(GetExecutablePlatform() == ExePlatformWorld || GetExecutablePlatform() == ExePlatformZone) {
 					retransmit_acked_packets = RETRANSMIT_ACKED_PACKETS;
 				}
 
-				if(!retransmit_acked_packets) {
-					uint16 sqsize = SequencedQueue.size();
-					uint16 index = seq - SequencedBase;
-					_log(NET__NET_TRACE, _L "OP_OutOfOrderAck marking packet acked in queue (queue index = %d, queue size = %d)." __L, index, sqsize);
-					if (index < sqsize) {
-						std::deque<EQProtocolPacket *>::iterator sitr;
-						sitr = SequencedQueue.begin();
-						sitr += index;
-						(*sitr)->acked = true;
+				if (index < sqsize) {
+					EQProtocolPacket *ooa = SequencedQueue[index];
+					if(!retransmit_acked_packets) {
+						_log(NET__NET_TRACE, _L "OP_OutOfOrderAck marking packet acked in queue (queue index = %d, queue size = %d)." __L, index, sqsize);
+						ooa->acked = true;
 					}
-				}
 
-				if(RETRANSMIT_TIMEOUT_MULT) {
-					retransmittimer = Timer::GetCurrentTime();
+					//they have seq but are missing something before it. Resend only the unacked packets
+					//that went out before seq did; anything resent since then is already on its way.
+					uint16 flagged = 0;
+					for (uint16 i = 0; i < index && i < NextSequencedSend; i++) {
+						EQProtocolPacket *gap = SequencedQueue[i];
+						if (!gap->acked && gap->sent_count && !gap->resend && int32(gap->sent_time - ooa->sent_time) <= 0) {
+							gap->resend = true;
+							flagged++;
+						}
+					}
+					_log(NET__NET_TRACE, _L "Received OP_OutOfOrderAck for sequence %d, flagged %d earlier packets for resend (base seq %d)." __L,
+						seq, flagged, SequencedBase);
 				}
 
-				NextSequencedSend = 0;
+				//only world and zone resend flagged packets in Write(), everyone else goes back over the unacked buffer
+				if(GetExecutablePlatform() != ExePlatformWorld && GetExecutablePlatform() != ExePlatformZone) {
+					_log(NET__NET_TRACE, _L "Received OP_OutOfOrderAck for sequence %d, starting retransmit at the start of our unacked buffer (seq %d, was %d)." __L,
+						seq, SequencedBase, SequencedBase+NextSequencedSend);
+					NextSequencedSend = 0;
+				}
 			} else {
 				_log(NET__NET_TRACE, _L "Received OP_OutOfOrderAck for out-of-window %d. Window (%d->%d)." __L, seq, SequencedBase, NextOutSeq);
 			}
@@ -481,8 +490,9 @@ void EQStream::ProcessPacket(EQProtocolPacket *p)
 			NonSequencedPush(new EQProtocolPacket(OP_SessionStatResponse,p->pBuffer,p->size));
 			AdjustRates(ntohl(Stats->average_delta));
 
+			//only used to seed the RTO until we have our own round trip samples
 			if(GetExecutablePlatform() == ExePlatformWorld || GetExecutablePlatform() == ExePlatformZone) {
-				if(RETRANSMIT_TIMEOUT_MULT && ntohl(Stats->average_delta)) {
+				if(RETRANSMIT_TIMEOUT_MULT && ntohl(Stats->average_delta) && !srtt) {
 					//recalculate retransmittimeout using the larger of the last rtt or average rtt, which is multiplied by the rule value
 					if((ntohl(Stats->last_local_delta) + ntohl(Stats->last_remote_delta)) > (ntohl(Stats->average_delta) * 2)) {
 						retransmittimeout = (ntohl(Stats->last_local_delta) + ntohl(Stats->last_remote_delta)) 
@@ -519,10 +529,16 @@ void EQStream::QueuePacket(const EQApplicationPacket *p, bool ack_req)
 	if(p == nullptr)
 		return;
 
-	EQApplicationPacket *newp = p->Copy();
+	//serialized straight from the caller's packet, so one packet can be queued to many streams
+	uint16 opcode = 0;
+	if(!GetWireOpcode(p, opcode))
+		return;
 
-	if (newp != nullptr)
-		FastQueuePacket(&newp, ack_req);
+	if (!ack_req) {
+		NonSequencedPush(new EQProtocolPacket(opcode, p->pBuffer, p->size));
+	} else {
+		SendPacket(opcode, p);
+	}
 }
 
 void EQStream::FastQueuePacket(EQApplicationPacket **p, bool ack_req)
@@ -533,28 +549,26 @@ void EQStream::FastQueuePacket(EQApplicationPacket **p, bool ack_req)
 	if(pack == nullptr)
 		return;
 
+	QueuePacket(pack, ack_req);
+	delete pack;
+}
+
+bool EQStream::GetWireOpcode(const EQApplicationPacket *p, uint16 &opcode)
+{
 	if(OpMgr == nullptr || *OpMgr == nullptr) {
 		_log(NET__DEBUG, _L "Packet enqueued into a stream with no opcode manager, dropping." __L);
-		delete pack;
-		return;
+		return false;
 	}
 
-	uint16 opcode = 0;
-	if(pack->GetOpcodeBypass() != 0) {
-		opcode = pack->GetOpcodeBypass();
-	} else {
-		opcode = (*OpMgr)->EmuToEQ(pack->emu_opcode);
-	}
-
-	if (!ack_req) {
-		NonSequencedPush(new EQProtocolPacket(opcode, pack->pBuffer, pack->size));
-		delete pack;
+	if(p->GetOpcodeBypass() != 0) {
+		opcode = p->GetOpcodeBypass();
 	} else {
-		SendPacket(opcode, pack);
+		opcode = (*OpMgr)->EmuToEQ(p->GetOpcode());
 	}
+	return true;
 }
 
-void EQStream::SendPacket(uint16 opcode, EQApplicationPacket *p)
+void EQStream::SendPacket(uint16 opcode, const EQApplicationPacket *p)
 {
 	uint32 chunksize,used;
 	uint32 length;
@@ -563,7 +577,8 @@ void EQStream::SendPacket(uint16 opcode, EQApplicationPacket *p)
 	if (p->size>(MaxLen-8)) { // proto-op(2), seq(2), app-op(2) ... data ... crc(2)
 		_log(NET__FRAGMENT, _L "Making oversized packet, len %d" __L, p->size);
 
-		unsigned char *tmpbuff=new unsigned char[p->size+3];
+		uint32 capacity;
+		unsigned char *tmpbuff=PacketPool::AllocBuffer(p->size+3, capacity);
 		length=p->serialize(opcode, tmpbuff);
 
 		EQProtocolPacket *out=new EQProtocolPacket(OP_Fragment,nullptr,MaxLen-4);
@@ -583,18 +598,17 @@ void EQStream::SendPacket(uint16 opcode, EQApplicationPacket *p)
 			used+=chunksize;
 			_log(NET__FRAGMENT, _L "Subsequent fragment: len %d, used %d/%d." __L, chunksize, used, p->size);
 		}
-		delete p;
-		delete[] tmpbuff;
+		PacketPool::FreeBuffer(tmpbuff, capacity);
 	} else {
 
-		unsigned char *tmpbuff=new unsigned char[p->Size()+3];
+		uint32 capacity;
+		unsigned char *tmpbuff=PacketPool::AllocBuffer(p->Size()+3, capacity);
 		length=p->serialize(opcode, tmpbuff+2) + 2;
 
 		EQProtocolPacket *out=new EQProtocolPacket(OP_Packet,tmpbuff,length);
 
-		delete[] tmpbuff;
+		PacketPool::FreeBuffer(tmpbuff, capacity);
 		SequencedPush(out);
-		delete p;
 	}
 }
 
@@ -680,14 +694,44 @@ void EQStream::Write(int eq_fd)
 	// Place to hold the base packet t combine into
 	EQProtocolPacket *p=nullptr;
 
+	uint32 now = Timer::GetCurrentTime();
+
 	if(GetExecutablePlatform() == ExePlatformWorld || GetExecutablePlatform() == ExePlatformZone) {
-		// if we have a timeout defined and we have not received an ack recently enough, retransmit from beginning of queue
-		if (RETRANSMIT_TIMEOUT_MULT && !SequencedQueue.empty() && NextSequencedSend &&
-			(GetState()==ESTABLISHED) && ((retransmittimer+retransmittimeout) < Timer::GetCurrentTime())) {
-			_log(NET__NET_TRACE, _L "Timeout since last ack received, starting retransmit at the start of our unacked "
-				"buffer (seq %d, was %d)." __L, SequencedBase, SequencedBase+NextSequencedSend);
-			NextSequencedSend = 0;
-			retransmittimer = Timer::GetCurrentTime(); // don't want to endlessly retransmit the first packet
+		// resend only the packets that need it: flagged by an out of order ack, or unacked for longer than the RTO
+		if (RETRANSMIT_TIMEOUT_MULT && NextSequencedSend && (GetState()==ESTABLISHED)) {
+			bool timed_out = false;
+			for (long i = 0; i < NextSequencedSend && BytesWritten <= threshold; i++) {
+				EQProtocolPacket *sp = SequencedQueue[i];
+				if (sp->acked)
+					continue;
+
+				bool expired = (now - sp->sent_time) >= retransmittimeout;
+				if (!sp->resend && !expired)
+					continue;
+
+				_log(NET__NET_TRACE, _L "Resending seq packet %d (%s, sent %d times)" __L, uint16(SequencedBase + i),
+					sp->resend ? "out of order ack" : "timeout", sp->sent_count);
+				if (!p) {
+					p = sp->Copy();
+				} else if (!p->combine(sp)) {
+					ReadyToSend.push(p);
+					BytesWritten += p->size;
+					p = sp->Copy();
+				}
+
+				timed_out |= expired;
+				sp->resend = false;
+				sp->sent_time = now;
+				sp->sent_count++;
+				sequenced_resent++;
+			}
+
+			// back off until a fresh sample comes in, so a dead link doesn't get hammered
+			if (timed_out) {
+				retransmittimeout *= 2;
+				if (retransmittimeout > RETRANSMIT_TIMEOUT_MAX)
+					retransmittimeout = RETRANSMIT_TIMEOUT_MAX;
+			}
 		}
 	}
 
@@ -697,7 +741,7 @@ void EQStream::Write(int eq_fd)
 	sitr += NextSequencedSend;
 
 	// Loop until both are empty or MaxSends is reached
-	while(!SeqEmpty || !NonSeqEmpty) {
+	while((!SeqEmpty || !NonSeqEmpty) && BytesWritten <= threshold) {
 
 		// See if there are more non-sequenced packets left
 		if (!NonSequencedQueue.empty()) {
@@ -757,6 +801,9 @@ void EQStream::Write(int eq_fd)
 					// Copy it first as it will still live until it is acked
 					p=(*sitr)->Copy();
 					_log(NET__NET_COMBINE, _L "Starting combined packet with seq packet %d of len %d" __L, seq_send, p->size);
+					(*sitr)->sent_time = now;
+					(*sitr)->sent_count++;
+					sequenced_sent++;
 					++sitr;
 					NextSequencedSend++;
 				} else if (!p->combine(*sitr)) {
@@ -775,6 +822,9 @@ void EQStream::Write(int eq_fd)
 				} else {
 					// Combine worked
 					_log(NET__NET_COMBINE, _L "Combined seq packet %d of len %d, yeilding %d combined." __L, seq_send, (*sitr)->size, p->size);
+					(*sitr)->sent_time = now;
+					(*sitr)->sent_count++;
+					sequenced_sent++;
 					++sitr;
 					NextSequencedSend++;
 				}
@@ -784,6 +834,9 @@ void EQStream::Write(int eq_fd)
 					// Copy it first as it will still live until it is acked
 					p=(*sitr)->Copy();
 					_log(NET__NET_COMBINE, _L "Starting combined packet with seq packet %d of len %d" __L, seq_send, p->size);
+					(*sitr)->sent_time = now;
+					(*sitr)->sent_count++;
+					sequenced_sent++;
 					++sitr;
 					NextSequencedSend++;
 				} else if (!p->combine(*sitr)) {
@@ -802,6 +855,9 @@ void EQStream::Write(int eq_fd)
 				} else {
 					// Combine worked
 					_log(NET__NET_COMBINE, _L "Combined seq packet %d of len %d, yeilding %d combined." __L, seq_send, (*sitr)->size, p->size);
+					(*sitr)->sent_time = now;
+					(*sitr)->sent_count++;
+					sequenced_sent++;
 					++sitr;
 					NextSequencedSend++;
 				}
@@ -1160,6 +1216,8 @@ if(NextSequencedSend > SequencedQueue.size()) {
 
 
 		//this is a good ack, we get to ack some blocks.
+		uint32 sample = 0;
+		bool have_sample = false;
 		seq++;	//we stop at the block right after their ack, counting on the wrap of both numbers.
 		while(SequencedBase != seq) {
 if(SequencedQueue.empty()) {
@@ -1169,8 +1227,15 @@ _log(NET__ERROR, _L "OUT OF PACKETS acked packet with sequence %lu. Next send is
 	break;
 }
 			_log(NET__NET_ACKS, _L "Removing acked packet with sequence %lu. Next send is %d before this." __L, (unsigned long)SequencedBase, NextSequencedSend);
-			//clean out the acked packet
-			delete SequencedQueue.front();
+			//clean out the acked packet, sampling the round trip off the newest one we only sent once (Karn)
+			EQProtocolPacket *acked = SequencedQueue.front();
+			if (acked->sent_count == 1) {
+				sample = Timer::GetCurrentTime() - acked->sent_time;
+				have_sample = true;
+			} else if (acked->sent_count > 1) {
+				have_sample = false;
+			}
+			delete acked;
 			SequencedQueue.pop_front();
 			//adjust our "next" pointer
 			if(NextSequencedSend > 0)
@@ -1178,6 +1243,8 @@ _log(NET__ERROR, _L "OUT OF PACKETS acked packet with sequence %lu. Next send is
 			//advance the base sequence number to the seq of the block after the one we just got rid of.
 			SequencedBase++;
 		}
+		if (have_sample)
+			UpdateRTT(sample);
 if(uint16(SequencedBase + SequencedQueue.size()) != NextOutSeq) {
 	_log(NET__ERROR, _L "Post-Ack on %d Invalid Sequenced queue: BS %d + SQ %d != NOS %d" __L, seq, SequencedBase, SequencedQueue.size(), NextOutSeq);
 }
@@ -1189,6 +1256,32 @@ if(NextSequencedSend > SequencedQueue.size()) {
 	MOutboundQueue.unlock();
 }
 
+void EQStream::UpdateRTT(uint32 sample)
+{
+	if(!RETRANSMIT_TIMEOUT_MULT)
+		return;
+	if(GetExecutablePlatform() != ExePlatformWorld && GetExecutablePlatform() != ExePlatformZone)
+		return;
+
+	if (!srtt) {
+		srtt = sample ? sample : 1;
+		rttvar = sample / 2;
+	} else {
+		uint32 delta = sample > srtt ? sample - srtt : srtt - sample;
+		rttvar = (rttvar * 3 + delta) / 4;
+		srtt = (srtt * 7 + sample) / 8;
+		if (!srtt)
+			srtt = 1;
+	}
+
+	retransmittimeout = srtt + std::max<uint32>(RETRANSMIT_CLOCK_GRANULARITY, rttvar * 4);
+	if (retransmittimeout < RETRANSMIT_TIMEOUT_MIN)
+		retransmittimeout = RETRANSMIT_TIMEOUT_MIN;
+	if (retransmittimeout > RETRANSMIT_TIMEOUT_MAX)
+		retransmittimeout = RETRANSMIT_TIMEOUT_MAX;
+	_log(NET__NET_TRACE, _L "RTT sample %dms, srtt %dms, rttvar %dms, rto %dms" __L, sample, srtt, rttvar, retransmittimeout);
+}
+
 void EQStream::SetNextAckToSend(uint32 seq)
 {
 	MAcks.lock();
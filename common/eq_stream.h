@@ -41,6 +41,15 @@ class EQProtocolPacket;
 #define RETRANSMIT_TIMEOUT_MAX 5000
 #endif
 
+#ifndef RETRANSMIT_TIMEOUT_MIN
+#define RETRANSMIT_TIMEOUT_MIN 200
+#endif
+
+//timer granularity term of the RTO calculation, in ms
+#ifndef RETRANSMIT_CLOCK_GRANULARITY
+#define RETRANSMIT_CLOCK_GRANULARITY 10
+#endif
+
 #ifndef AVERAGE_DELTA_MAX
 #define AVERAGE_DELTA_MAX 2500
 #endif
@@ -105,8 +114,17 @@ class EQStream : public EQStreamInterface {
 		uint8 app_opcode_size;
 		EQStreamType StreamType;
 		bool compressed,encoded;
-		uint32 retransmittimer;
-		uint32 retransmittimeout;
+		uint32 retransmittimeout;	//current RTO in ms
+
+		// Smoothed round trip time and variance (RFC 6298), sampled from acks
+		// of packets that were only sent once. Zero srtt means no sample yet.
+		uint32 srtt;
+		uint32 rttvar;
+		void UpdateRTT(uint32 sample);
+
+		// Sequenced packets sent for the first time, and resends of them
+		uint32 sequenced_sent;
+		uint32 sequenced_resent;
 
 		uint16 sessionAttempts;
 		bool streamactive;
@@ -168,7 +186,8 @@ class EQStream : public EQStreamInterface {
 		EQRawApplicationPacket *MakeApplicationPacket(EQProtocolPacket *p);
 		EQRawApplicationPacket *MakeApplicationPacket(const unsigned char *buf, uint32 len);
 		EQProtocolPacket *MakeProtocolPacket(const unsigned char *buf, uint32 len);
-		void SendPacket(uint16 opcode, EQApplicationPacket *p);
+		void SendPacket(uint16 opcode, const EQApplicationPacket *p);
+		bool GetWireOpcode(const EQApplicationPacket *p, uint16 &opcode);
 
 		void SetState(EQStreamState state);
 
@@ -282,6 +301,10 @@ class EQStream : public EQStreamInterface {
 			return bytes_recv / (Timer::GetTimeSeconds() - create_time);
 		}
 
+		virtual const uint32 GetSequencedSent() const { return sequenced_sent; }
+		virtual const uint32 GetSequencedResent() const { return sequenced_resent; }
+		virtual const uint32 GetRoundTripTime() const { return srtt; }
+
 		//used for dynamic stream identification
 		class Signature {
 		public:
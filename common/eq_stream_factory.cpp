@@ -19,6 +19,7 @@
 #include <fcntl.h>
 
 #include "op_codes.h"
+#include "wake_event.h"
 
 ThreadReturnType EQStreamFactoryReaderLoop(void *eqfs)
 {
@@ -55,7 +56,7 @@ ThreadReturnType EQStreamFactoryWriterLoop(void *eqfs)
 }
 
 EQStreamFactory::EQStreamFactory(EQStreamType type, int port, uint32 timeout)
-	: Timeoutable(5000), stream_timeout(timeout)
+	: Timeoutable(5000), stream_timeout(timeout), wake_event(nullptr)
 {
 	StreamType=type;
 	Port=port;
@@ -196,6 +197,8 @@ timeval sleep_time;
 						s->AddBytesRecv(length);
 						s->Process(buffer,length);
 						s->SetLastPacketTime(Timer::GetCurrentTime());
+						if (wake_event)
+							wake_event->Signal();
 					}
 					MStreams.unlock();
 				} else {
@@ -212,6 +215,8 @@ timeval sleep_time;
 						curstream->Process(buffer,length);
 						curstream->SetLastPacketTime(Timer::GetCurrentTime());
 						curstream->ReleaseFromUse();
+						if (wake_event)
+							wake_event->Signal();
 					}
 				}
 			}
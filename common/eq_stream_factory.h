@@ -11,6 +11,7 @@
 
 class EQStream;
 class Timer;
+namespace EQEmu { class WakeEvent; }
 
 class EQStreamFactory : private Timeoutable {
 	private:
@@ -38,8 +39,10 @@ class EQStreamFactory : private Timeoutable {
 
 		uint32 stream_timeout;
 
+		EQEmu::WakeEvent *wake_event;
+
 	public:
-		EQStreamFactory(EQStreamType type, uint32 timeout = 135000) : Timeoutable(5000), stream_timeout(timeout) { ReaderRunning=false; WriterRunning=false; StreamType=type; sock=-1; }
+		EQStreamFactory(EQStreamType type, uint32 timeout = 135000) : Timeoutable(5000), stream_timeout(timeout), wake_event(nullptr) { ReaderRunning=false; WriterRunning=false; StreamType=type; sock=-1; }
 		EQStreamFactory(EQStreamType type, int port, uint32 timeout = 135000);
 
 		EQStream *Pop();
@@ -55,6 +58,8 @@ class EQStreamFactory : private Timeoutable {
 		void StopReader() { MReaderRunning.lock(); ReaderRunning=false; MReaderRunning.unlock(); }
 		void StopWriter() { MWriterRunning.lock(); WriterRunning=false; MWriterRunning.unlock(); WriterWork.Signal(); }
 		void SignalWriter() { WriterWork.Signal(); }
+		//signalled by the reader thread after it hands inbound data to a stream
+		void SetWakeEvent(EQEmu::WakeEvent *ev) { wake_event = ev; }
 };
 
 #endif
@@ -35,6 +35,9 @@ public:
 	virtual const uint32 GetBytesRecieved() const { return 0; }
 	virtual const uint32 GetBytesSentPerSecond() const { return 0; }
 	virtual const uint32 GetBytesRecvPerSecond() const { return 0; }
+	virtual const uint32 GetSequencedSent() const { return 0; }
+	virtual const uint32 GetSequencedResent() const { return 0; }
+	virtual const uint32 GetRoundTripTime() const { return 0; }
 	virtual const EQClientVersion ClientVersion() const { return EQClientUnknown; }
 };
 
@@ -83,6 +83,21 @@ const uint32 EQStreamProxy::GetBytesRecvPerSecond() const
 	return(m_stream->GetBytesRecvPerSecond());
 }
 
+const uint32 EQStreamProxy::GetSequencedSent() const
+{
+	return(m_stream->GetSequencedSent());
+}
+
+const uint32 EQStreamProxy::GetSequencedResent() const
+{
+	return(m_stream->GetSequencedResent());
+}
+
+const uint32 EQStreamProxy::GetRoundTripTime() const
+{
+	return(m_stream->GetRoundTripTime());
+}
+
 void EQStreamProxy::ReleaseFromUse() {
 	m_stream->ReleaseFromUse();
 
@@ -33,6 +33,9 @@ public:
 	virtual const uint32 GetBytesRecieved() const;
 	virtual const uint32 GetBytesSentPerSecond() const;
 	virtual const uint32 GetBytesRecvPerSecond() const;
+	virtual const uint32 GetSequencedSent() const;
+	virtual const uint32 GetSequencedResent() const;
+	virtual const uint32 GetRoundTripTime() const;
 
 protected:
 	EQStream *const					m_stream;	//we own this stream object.
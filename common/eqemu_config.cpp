@@ -318,6 +318,14 @@ void EQEmuConfig::do_launcher(TiXmlElement *ele)
 			ZoneBootInterval = atoi(text);
 		}
 	}
+	// Get the <host> element
+	sub_ele = ele->FirstChildElement("host");
+	if (sub_ele != nullptr) {
+		text = sub_ele->Attribute("enabled");
+		if (text && !strcasecmp(text, "true")) {
+			ZoneHostEnabled = true;
+		}
+	}
 }
 
 std::string EQEmuConfig::GetByName(const std::string &var_name) const
@@ -95,6 +95,7 @@ class EQEmuConfig : public XMLParser
 		uint32 TerminateWait;
 		uint32 InitialBootWait;
 		uint32 ZoneBootInterval;
+		bool ZoneHostEnabled;
 
 		// From <zones/>
 		uint16 ZonePortLow;
@@ -168,6 +169,7 @@ class EQEmuConfig : public XMLParser
 			TerminateWait = 10000;		//milliseconds
 			InitialBootWait = 20000;	//milliseconds
 			ZoneBootInterval = 2000;	//milliseconds
+			ZoneHostEnabled = false;
 			#ifdef WIN32
 			ZoneExe = "zone.exe";
 			#else
@@ -0,0 +1,45 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "event_loop.h"
+#include "timer.h"
+
+namespace EQEmu {
+	EventLoop::EventLoop(uint32 max_wait) : max_wait_(max_wait) {
+	}
+
+	void EventLoop::WatchTimer(Timer *timer) {
+		timers_.push_back(timer);
+	}
+
+	bool EventLoop::Wait() {
+		Timer::SetCurrentTime();
+
+		uint32 wait = max_wait_;
+		for(std::vector<Timer*>::iterator iter = timers_.begin(); iter != timers_.end(); ++iter) {
+			uint32 remaining = (*iter)->GetRemainingTime();
+			if(remaining < wait)
+				wait = remaining;
+		}
+
+		if(wait == 0)
+			return false;
+
+		return wake_.Wait(wait);
+	}
+}
@@ -0,0 +1,66 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_EVENT_LOOP_H
+#define _EQEMU_EVENT_LOOP_H
+
+#include "types.h"
+#include "wake_event.h"
+#include <vector>
+
+class Timer;
+
+namespace EQEmu {
+
+	//! Deadline driven main loop pacing for the server daemons
+	/*!
+		Replaces the fixed Sleep() at the bottom of a main loop. Hand GetWakeEvent() to the stream factories,
+		TCP servers and world connections the loop services so their threads wake it as soon as they queue
+		something, and register the loop's own timers with WatchTimer() so Wait() returns when the next one is
+		due. Anything the loop polls that isn't covered by either is bounded by max_wait.
+	*/
+	class EventLoop {
+	public:
+		//! Constructor
+		/*!
+		\param max_wait Longest Wait() will ever block, in milliseconds.
+		*/
+		EventLoop(uint32 max_wait);
+
+		//! The event the loop's I/O sources should signal
+		WakeEvent *GetWakeEvent() { return &wake_; }
+
+		//! Adds a timer whose expiry should end a Wait(), the timer must outlive the loop
+		void WatchTimer(Timer *timer);
+
+		//! Blocks until woken or until the earliest watched timer is due
+		/*!
+		\return True if woken by an I/O source rather than a deadline.
+		*/
+		bool Wait();
+	private:
+		EventLoop(const EventLoop&);
+		const EventLoop& operator=(const EventLoop&);
+
+		WakeEvent wake_;
+		std::vector<Timer*> timers_;
+		uint32 max_wait_;
+	};
+}
+
+#endif
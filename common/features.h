@@ -162,7 +162,7 @@ enum {	//timer settings, all in milliseconds
 	ClientProximity_interval = 150,
 	CombatEventTimer_expire = 12000,
 	Tribute_duration = 600000,
-	ZoneTimerResolution = 3,			//sleep time between zone main loop runs (milliseconds)
+	ZoneMaxLoopWait = 200,			//longest the zone main loop will block waiting for its next deadline (milliseconds)
 	FeignMemoryDuration = 120000, // Duration player must feign death to clear zonewide agro.
 	EnragedTimer = 360000,
 	EnragedDurationTimer = 10000
@@ -21,6 +21,7 @@
 #include "logsys.h"
 //#include "misc_functions.h"
 #include "string_util.h"
+#include "servertalk.h"
 #include <cstdlib>
 #include <cstring>
 
@@ -445,6 +446,21 @@ bool BaseGuildManager::SetGuild(uint32 charid, uint32 guild_id, uint8 rank) {
 	if(!DBSetGuild(charid, guild_id, rank))
 		return(false);
 
+	//the REPLACE resets everything but the char to its defaults, mirror that
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr) {
+		CharGuildInfo moved = *cached;
+		moved.guild_id = guild_id;
+		moved.rank = guild_id == GUILD_NONE ? GUILD_RANK_NONE : rank;
+		moved.tribute_enable = false;
+		moved.total_tribute = 0;
+		moved.last_tribute = 0;
+		moved.banker = false;
+		moved.alt = false;
+		moved.public_note.clear();
+		StoreMember(moved);
+	}
+
 	SendCharRefresh(old_guild, guild_id, charid);
 
 	return(true);
@@ -458,6 +474,10 @@ bool BaseGuildManager::SetGuildRank(uint32 charid, uint8 rank) {
 	if(!DBSetGuildRank(charid, rank))
 		return(false);
 
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr)
+		cached->rank = rank;
+
 	SendCharRefresh(GUILD_NONE, 0, charid);
 
 	return(true);
@@ -468,6 +488,10 @@ bool BaseGuildManager::SetBankerFlag(uint32 charid, bool is_banker) {
 	if(!DBSetBankerFlag(charid, is_banker))
 		return(false);
 
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr)
+		cached->banker = is_banker;
+
 	SendRankUpdate(charid);
 
 	return(true);
@@ -483,6 +507,10 @@ bool BaseGuildManager::SetAltFlag(uint32 charid, bool is_alt)
 	if(!DBSetAltFlag(charid, is_alt))
 		return(false);
 
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr)
+		cached->alt = is_alt;
+
 	SendRankUpdate(charid);
 
 	return(true);
@@ -492,6 +520,10 @@ bool BaseGuildManager::SetTributeFlag(uint32 charid, bool enabled) {
 	if(!DBSetTributeFlag(charid, enabled))
 		return(false);
 
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr)
+		cached->tribute_enable = enabled;
+
 	SendCharRefresh(GUILD_NONE, 0, charid);
 
 	return(true);
@@ -501,6 +533,10 @@ bool BaseGuildManager::SetPublicNote(uint32 charid, const char *note) {
 	if(!DBSetPublicNote(charid, note))
 		return(false);
 
+	CharGuildInfo *cached = FindCachedMember(charid);
+	if(cached != nullptr)
+		cached->public_note = note;
+
 	SendCharRefresh(GUILD_NONE, 0, charid);
 
 	return(true);
@@ -986,6 +1022,16 @@ bool BaseGuildManager::GetCharInfo(const char *char_name, CharGuildInfo &into) {
 }
 
 bool BaseGuildManager::GetCharInfo(uint32 char_id, CharGuildInfo &into) {
+	CharGuildInfo *cached = FindCachedMember(char_id);
+	if(cached != nullptr) {
+		into = *cached;
+		return(true);
+	}
+
+	return(DBGetCharInfo(char_id, into));
+}
+
+bool BaseGuildManager::DBGetCharInfo(uint32 char_id, CharGuildInfo &into) {
 	if(m_db == nullptr) {
 		_log(GUILDS__DB, "Requested char info on %d when we have no database object.", char_id);
 		return false;
@@ -1213,9 +1259,139 @@ bool BaseGuildManager::LocalDeleteGuild(uint32 guild_id) {
 	if(res == m_guilds.end())
 		return(false);	//invalid guild
 	m_guilds.erase(res);
+	DropRoster(guild_id);
 	return(true);
 }
 
+const BaseGuildManager::GuildRoster *BaseGuildManager::GetRoster(uint32 guild_id) const {
+	std::map<uint32, GuildRoster>::const_iterator res;
+	res = m_rosters.find(guild_id);
+	if(res == m_rosters.end())
+		return(nullptr);
+	return(&res->second);
+}
+
+bool BaseGuildManager::LoadRoster(uint32 guild_id) {
+	std::vector<CharGuildInfo *> members;
+	if(!GetEntireGuild(guild_id, members))
+		return(false);
+
+	DropRoster(guild_id);
+	GuildRoster &roster = m_rosters[guild_id];
+
+	std::vector<CharGuildInfo *>::iterator cur, end;
+	cur = members.begin();
+	end = members.end();
+	for(; cur != end; ++cur) {
+		roster[(*cur)->char_id] = **cur;
+		m_roster_index[(*cur)->char_id] = guild_id;
+		delete *cur;
+	}
+
+	return(true);
+}
+
+void BaseGuildManager::StoreMember(const CharGuildInfo &info) {
+	std::map<uint32, uint32>::iterator idx = m_roster_index.find(info.char_id);
+	if(idx != m_roster_index.end()) {
+		if(idx->second == info.guild_id) {
+			m_rosters[info.guild_id][info.char_id] = info;
+			return;
+		}
+		m_rosters[idx->second].erase(info.char_id);
+		m_roster_index.erase(idx);
+	}
+
+	//only guilds we hold a complete roster for get new members
+	std::map<uint32, GuildRoster>::iterator res = m_rosters.find(info.guild_id);
+	if(info.guild_id == GUILD_NONE || res == m_rosters.end())
+		return;
+
+	res->second[info.char_id] = info;
+	m_roster_index[info.char_id] = info.guild_id;
+}
+
+void BaseGuildManager::DropRoster(uint32 guild_id) {
+	std::map<uint32, GuildRoster>::iterator res = m_rosters.find(guild_id);
+	if(res == m_rosters.end())
+		return;
+
+	GuildRoster::iterator cur, end;
+	cur = res->second.begin();
+	end = res->second.end();
+	for(; cur != end; ++cur)
+		m_roster_index.erase(cur->first);
+
+	m_rosters.erase(res);
+}
+
+void BaseGuildManager::ClearRosters() {
+	m_rosters.clear();
+	m_roster_index.clear();
+}
+
+void BaseGuildManager::PackMember(const CharGuildInfo &info, ServerGuildMember_Struct *into) {
+	memset(into, 0, sizeof(ServerGuildMember_Struct));
+	into->char_id = info.char_id;
+	strn0cpy(into->char_name, info.char_name.c_str(), sizeof(into->char_name));
+	into->class_ = info.class_;
+	into->level = info.level;
+	into->time_last_on = info.time_last_on;
+	into->zone_id = info.zone_id;
+	into->guild_id = info.guild_id;
+	into->rank = info.rank;
+	into->tribute_enable = info.tribute_enable;
+	into->total_tribute = info.total_tribute;
+	into->last_tribute = info.last_tribute;
+	into->banker = info.banker;
+	into->alt = info.alt;
+	strn0cpy(into->public_note, info.public_note.c_str(), sizeof(into->public_note));
+}
+
+void BaseGuildManager::UnpackMember(const ServerGuildMember_Struct *member, CharGuildInfo &into) {
+	into.char_id = member->char_id;
+	into.char_name.assign(member->char_name, strnlen(member->char_name, sizeof(member->char_name)));
+	into.class_ = member->class_;
+	into.level = member->level;
+	into.time_last_on = member->time_last_on;
+	into.zone_id = member->zone_id;
+	into.guild_id = member->guild_id;
+	into.rank = member->rank;
+	into.tribute_enable = member->tribute_enable != 0;
+	into.total_tribute = member->total_tribute;
+	into.last_tribute = member->last_tribute;
+	into.banker = member->banker != 0;
+	into.alt = member->alt != 0;
+	into.public_note.assign(member->public_note, strnlen(member->public_note, sizeof(member->public_note)));
+}
+
+CharGuildInfo *BaseGuildManager::FindCachedMember(uint32 char_id) {
+	std::map<uint32, uint32>::iterator idx = m_roster_index.find(char_id);
+	if(idx == m_roster_index.end())
+		return(nullptr);
+
+	GuildRoster &roster = m_rosters[idx->second];
+	GuildRoster::iterator res = roster.find(char_id);
+	if(res == roster.end())
+		return(nullptr);
+	return(&res->second);
+}
+
+CharGuildInfo *BaseGuildManager::FindCachedMember(uint32 guild_id, const char *char_name) {
+	std::map<uint32, GuildRoster>::iterator res = m_rosters.find(guild_id);
+	if(res == m_rosters.end())
+		return(nullptr);
+
+	GuildRoster::iterator cur, end;
+	cur = res->second.begin();
+	end = res->second.end();
+	for(; cur != end; ++cur) {
+		if(cur->second.char_name == char_name)
+			return(&cur->second);
+	}
+	return(nullptr);
+}
+
 void BaseGuildManager::ClearGuilds() {
 	std::map<uint32, GuildInfo *>::iterator cur, end;
 	cur = m_guilds.begin();
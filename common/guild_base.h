@@ -7,6 +7,7 @@
 #include <vector>
 
 class Database;
+struct ServerGuildMember_Struct;
 
 class CharGuildInfo
 {
@@ -70,6 +71,17 @@ class BaseGuildManager
 		bool	GetCharInfo(const char *char_name, CharGuildInfo &into);
 		bool	GetCharInfo(uint32 char_id, CharGuildInfo &into);
 		bool	GetEntireGuild(uint32 guild_id, std::vector<CharGuildInfo *> &members);	//caller is responsible for deleting each pointer in the resulting vector.
+
+		//member lists kept in memory for guilds whose roster has been asked for.
+		//world fills its copy from the database and zones fill theirs from world.
+		typedef std::map<uint32, CharGuildInfo> GuildRoster;	//char_id -> member
+		const GuildRoster *GetRoster(uint32 guild_id) const;
+		bool	LoadRoster(uint32 guild_id);
+		void	StoreMember(const CharGuildInfo &info);	//moves the member between cached rosters as needed
+		void	DropRoster(uint32 guild_id);
+		void	ClearRosters();
+		static void PackMember(const CharGuildInfo &info, ServerGuildMember_Struct *into);
+		static void UnpackMember(const ServerGuildMember_Struct *member, CharGuildInfo &into);
 		bool	GuildExists(uint32 guild_id) const;
 		bool	GetGuildMOTD(uint32 guild_id, char *motd_buffer, char *setter_buffer) const;
 		bool	GetGuildURL(uint32 GuildID, char *URLBuffer) const;
@@ -115,6 +127,9 @@ class BaseGuildManager
 		bool	DBSetTributeFlag(uint32 charid, bool enabled);
 		bool	DBSetPublicNote(uint32 charid, const char *note);
 		bool	QueryWithLogging(std::string query, const char *errmsg);
+		bool	DBGetCharInfo(uint32 char_id, CharGuildInfo &into);
+		CharGuildInfo *FindCachedMember(uint32 char_id);
+		CharGuildInfo *FindCachedMember(uint32 guild_id, const char *char_name);
 //	void	DBSetPublicNote(uint32 guild_id,char* charname, char* note);
 
 		bool	LocalDeleteGuild(uint32 guild_id);
@@ -143,6 +158,8 @@ class BaseGuildManager
 		};
 
 		std::map<uint32, GuildInfo *> m_guilds;	//we own the pointers in this map
+		std::map<uint32, GuildRoster> m_rosters;	//guild_id -> cached members
+		std::map<uint32, uint32> m_roster_index;	//char_id -> guild_id, for members in m_rosters
 		void ClearGuilds();	//clears internal structure
 
 		Database *m_db;	//we do not own this
@@ -25,6 +25,10 @@
 #include "string_util.h"
 
 #include <limits.h>
+#include <string.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 #include <iostream>
 
@@ -51,6 +55,132 @@ static inline int32 GetNextItemInstSerialNumber() {
 	return NextItemInstSerialNumber;
 }
 
+// Pops the lowest set bit off of mask, returning its position
+static inline int NextSetBit(uint32& mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+#else
+	int index = __builtin_ctz(mask);
+#endif
+	mask &= (mask - 1);
+	return static_cast<int>(index);
+}
+
+
+//
+// class ItemInstBucket
+//
+ItemInstBucket::ItemInstBucket() {
+	m_range_count = 0;
+	m_size = 0;
+	m_occupied = 0;
+	memset(m_slot_ids, 0, sizeof(m_slot_ids));
+	memset(m_slots, 0, sizeof(m_slots));
+}
+
+void ItemInstBucket::AddRange(int16 slot_begin, int16 slot_end) {
+	int count = slot_end - slot_begin + 1;
+	if (m_range_count >= (sizeof(m_ranges) / sizeof(m_ranges[0])) || count <= 0 || (m_size + count) > MaxSlots) {
+		LogFile->write(EQEmuLog::Error, "ItemInstBucket::AddRange: Unable to map slots %i through %i", slot_begin, slot_end);
+		return;
+	}
+
+	SlotRange& range = m_ranges[m_range_count++];
+	range.slot_begin = slot_begin;
+	range.slot_end = slot_end;
+	range.base = m_size;
+
+	for (int16 slot_id = slot_begin; slot_id <= slot_end; ++slot_id)
+		m_slot_ids[m_size++] = slot_id;
+}
+
+// Dense index for slot_id, or -1 when the slot is not part of this bucket
+int ItemInstBucket::_IndexOf(int16 slot_id) const {
+	for (int i = 0; i < m_range_count; ++i) {
+		if (slot_id >= m_ranges[i].slot_begin && slot_id <= m_ranges[i].slot_end)
+			return m_ranges[i].base + (slot_id - m_ranges[i].slot_begin);
+	}
+
+	return -1;
+}
+
+ItemInst* ItemInstBucket::Get(int16 slot_id) const {
+	int index = _IndexOf(slot_id);
+	if (index < 0)
+		return nullptr;
+
+	return m_slots[index];
+}
+
+ItemInst* ItemInstBucket::Put(int16 slot_id, ItemInst* inst) {
+	int index = _IndexOf(slot_id);
+	if (index < 0)
+		return nullptr;
+
+	ItemInst* previous = m_slots[index];
+	if (previous)
+		_IndexRemove(index);
+
+	m_slots[index] = inst;
+	if (inst)
+		_IndexAdd(index);
+
+	return previous;
+}
+
+void ItemInstBucket::Clear() {
+	for (uint32 occupied = m_occupied; occupied; ) {
+		int index = NextSetBit(occupied);
+		safe_delete(m_slots[index]);
+	}
+	m_occupied = 0;
+	m_id_index.clear();
+}
+
+uint32 ItemInstBucket::FindByID(uint32 item_id) const {
+	auto it = m_id_index.find(item_id);
+	if (it == m_id_index.end())
+		return 0;
+
+	return it->second;
+}
+
+int16 ItemInstBucket::FirstFreeSlot() const {
+	uint32 free_slots = ~m_occupied;
+	if (m_size < MaxSlots)
+		free_slots &= ((1u << m_size) - 1);
+
+	if (!free_slots)
+		return INVALID_INDEX;
+
+	return m_slot_ids[NextSetBit(free_slots)];
+}
+
+void ItemInstBucket::_IndexAdd(int index) {
+	m_occupied |= (1u << index);
+
+	const Item_Struct* item = m_slots[index]->GetUnscaledItem();
+	if (item)
+		m_id_index[item->ID] |= (1u << index);
+}
+
+void ItemInstBucket::_IndexRemove(int index) {
+	m_occupied &= ~(1u << index);
+
+	const Item_Struct* item = m_slots[index]->GetUnscaledItem();
+	if (!item)
+		return;
+
+	auto it = m_id_index.find(item->ID);
+	if (it == m_id_index.end())
+		return;
+
+	it->second &= ~(1u << index);
+	if (!it->second)
+		m_id_index.erase(it);
+}
+
 
 //
 // class ItemInstQueue
@@ -110,48 +240,26 @@ ItemInst* ItemInstQueue::peek_front() const
 //
 // class Inventory
 //
-Inventory::~Inventory() {
-	std::map<int16, ItemInst*>::iterator cur, end;
-
-	cur = m_worn.begin();
-	end = m_worn.end();
-	for (; cur != end; ++cur) {
-		ItemInst *tmp = cur->second;
-		safe_delete(tmp);
-	}
-	m_worn.clear();
-
-	cur = m_inv.begin();
-	end = m_inv.end();
-	for (; cur != end; ++cur) {
-		ItemInst *tmp = cur->second;
-		safe_delete(tmp);
-	}
-	m_inv.clear();
-
-	cur = m_bank.begin();
-	end = m_bank.end();
-	for (; cur != end; ++cur) {
-		ItemInst *tmp = cur->second;
-		safe_delete(tmp);
-	}
-	m_bank.clear();
+Inventory::Inventory()
+{
+	m_version = EQClientUnknown;
+	m_versionset = false;
 
-	cur = m_shbank.begin();
-	end = m_shbank.end();
-	for (; cur != end; ++cur) {
-		ItemInst *tmp = cur->second;
-		safe_delete(tmp);
-	}
-	m_shbank.clear();
+	m_worn.AddRange(EmuConstants::EQUIPMENT_BEGIN, EmuConstants::EQUIPMENT_END);
+	m_worn.AddRange(EmuConstants::TRIBUTE_BEGIN, EmuConstants::TRIBUTE_END);
+	m_worn.AddRange(MainPowerSource, MainPowerSource);
+	m_inv.AddRange(EmuConstants::GENERAL_BEGIN, EmuConstants::GENERAL_END);
+	m_bank.AddRange(EmuConstants::BANK_BEGIN, EmuConstants::BANK_END);
+	m_shbank.AddRange(EmuConstants::SHARED_BANK_BEGIN, EmuConstants::SHARED_BANK_END);
+	m_trade.AddRange(EmuConstants::TRADE_BEGIN, EmuConstants::TRADE_END);
+}
 
-	cur = m_trade.begin();
-	end = m_trade.end();
-	for (; cur != end; ++cur) {
-		ItemInst *tmp = cur->second;
-		safe_delete(tmp);
-	}
-	m_trade.clear();
+Inventory::~Inventory() {
+	m_worn.Clear();
+	m_inv.Clear();
+	m_bank.Clear();
+	m_shbank.Clear();
+	m_trade.Clear();
 }
 
 void Inventory::CleanDirty() {
@@ -350,28 +458,22 @@ ItemInst* Inventory::PopItem(int16 slot_id)
 		p = m_cursor.pop();
 	}
 	else if ((slot_id >= EmuConstants::EQUIPMENT_BEGIN && slot_id <= EmuConstants::EQUIPMENT_END) || (slot_id == MainPowerSource)) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
+		p = m_worn.Pop(slot_id);
 	}
 	else if ((slot_id >= EmuConstants::GENERAL_BEGIN && slot_id <= EmuConstants::GENERAL_END)) {
-		p = m_inv[slot_id];
-		m_inv.erase(slot_id);
+		p = m_inv.Pop(slot_id);
 	}
 	else if (slot_id >= EmuConstants::TRIBUTE_BEGIN && slot_id <= EmuConstants::TRIBUTE_END) {
-		p = m_worn[slot_id];
-		m_worn.erase(slot_id);
+		p = m_worn.Pop(slot_id);
 	}
 	else if (slot_id >= EmuConstants::BANK_BEGIN && slot_id <= EmuConstants::BANK_END) {
-		p = m_bank[slot_id];
-		m_bank.erase(slot_id);
+		p = m_bank.Pop(slot_id);
 	}
 	else if (slot_id >= EmuConstants::SHARED_BANK_BEGIN && slot_id <= EmuConstants::SHARED_BANK_END) {
-		p = m_shbank[slot_id];
-		m_shbank.erase(slot_id);
+		p = m_shbank.Pop(slot_id);
 	}
 	else if (slot_id >= EmuConstants::TRADE_BEGIN && slot_id <= EmuConstants::TRADE_END) {
-		p = m_trade[slot_id];
-		m_trade.erase(slot_id);
+		p = m_trade.Pop(slot_id);
 	}
 	else {
 		// Is slot inside bag?
@@ -629,16 +731,17 @@ int16 Inventory::HasItemByLoreGroup(uint32 loregroup, uint8 where)
 int16 Inventory::FindFreeSlot(bool for_bag, bool try_cursor, uint8 min_size, bool is_arrow)
 {
 	// Check basic inventory
-	for (int16 i = EmuConstants::GENERAL_BEGIN; i <= EmuConstants::GENERAL_END; i++) {
-		if (!GetItem(i))
-			// Found available slot in personal inventory
-			return i;
-	}
+	int16 free_slot = m_inv.FirstFreeSlot();
+	if (free_slot != INVALID_INDEX)
+		// Found available slot in personal inventory
+		return free_slot;
 
 	if (!for_bag) {
-		for (int16 i = EmuConstants::GENERAL_BEGIN; i <= EmuConstants::GENERAL_END; i++) {
-			const ItemInst* inst = GetItem(i);
-			if (inst && inst->IsType(ItemClassContainer)
+		for (uint32 occupied = m_inv.Occupied(); occupied; ) {
+			int index = NextSetBit(occupied);
+			int16 i = m_inv.SlotAt(index);
+			const ItemInst* inst = m_inv.At(index);
+			if (inst->IsType(ItemClassContainer)
 				&& inst->GetItem()->BagSize >= min_size)
 			{
 				if (inst->GetItem()->BagType == BagTypeQuiver && inst->GetItem()->ItemType != ItemTypeArrow)
@@ -681,7 +784,7 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 	// step 1: find room for bags (caller should really ask for slots for bags first to avoid sending them to cursor..and bag item loss)
 	if (inst->IsType(ItemClassContainer)) {
 		for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot)
-			if (!m_inv[free_slot])
+			if (!m_inv.Get(free_slot))
 				return free_slot;
 
 		return MainCursor; // return cursor since bags do not stack and will not fit inside other bags..yet...)
@@ -690,7 +793,7 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 	// step 2: find partial room for stackables
 	if (inst->IsStackable()) {
 		for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-			const ItemInst* main_inst = m_inv[free_slot];
+			const ItemInst* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst)
 				continue;
@@ -700,7 +803,7 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 		}
 
 		for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-			const ItemInst* main_inst = m_inv[free_slot];
+			const ItemInst* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst)
 				continue;
@@ -722,7 +825,7 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 	// step 3a: find room for container-specific items (ItemClassArrow)
 	if (inst->GetItem()->ItemType == ItemTypeArrow) {
 		for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-			const ItemInst* main_inst = m_inv[free_slot];
+			const ItemInst* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst || (main_inst->GetItem()->BagType != BagTypeQuiver) || !main_inst->IsType(ItemClassContainer))
 				continue;
@@ -736,7 +839,7 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 	// step 3b: find room for container-specific items (ItemClassSmallThrowing)
 	if (inst->GetItem()->ItemType == ItemTypeSmallThrowing) {
 		for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-			const ItemInst* main_inst = m_inv[free_slot];
+			const ItemInst* main_inst = m_inv.Get(free_slot);
 
 			if (!main_inst || (main_inst->GetItem()->BagType != BagTypeBandolier) || !main_inst->IsType(ItemClassContainer))
 				continue;
@@ -749,14 +852,14 @@ int16 Inventory::FindFreeSlotForTradeItem(const ItemInst* inst) {
 
 	// step 4: just find an empty slot
 	for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-		const ItemInst* main_inst = m_inv[free_slot];
+		const ItemInst* main_inst = m_inv.Get(free_slot);
 
 		if (!main_inst)
 			return free_slot;
 	}
 
 	for (int16 free_slot = EmuConstants::GENERAL_BEGIN; free_slot <= EmuConstants::GENERAL_END; ++free_slot) {
-		const ItemInst* main_inst = m_inv[free_slot];
+		const ItemInst* main_inst = m_inv.Get(free_slot);
 
 		if (main_inst && main_inst->IsType(ItemClassContainer)) {
 			if ((main_inst->GetItem()->BagSize < inst->GetItem()->Size) || (main_inst->GetItem()->BagType == BagTypeBandolier) || (main_inst->GetItem()->BagType == BagTypeQuiver))
@@ -1029,17 +1132,19 @@ void Inventory::dumpSharedBankItems() {
 	dumpItemCollection(m_shbank);
 }
 
-int Inventory::GetSlotByItemInstCollection(const std::map<int16, ItemInst*> &collection, ItemInst *inst) {
-	for (auto iter = collection.begin(); iter != collection.end(); ++iter) {
-		ItemInst *t_inst = iter->second;
+int Inventory::GetSlotByItemInstCollection(const ItemInstBucket &collection, ItemInst *inst) {
+	for (uint32 occupied = collection.Occupied(); occupied; ) {
+		int index = NextSetBit(occupied);
+		ItemInst *t_inst = collection.At(index);
 		if (t_inst == inst) {
-			return iter->first;
+			return collection.SlotAt(index);
 		}
 
-		if (t_inst && !t_inst->IsType(ItemClassContainer)) {
-			for (auto b_iter = t_inst->_begin(); b_iter != t_inst->_end(); ++b_iter) {
-				if (b_iter->second == inst) {
-					return Inventory::CalcSlotId(iter->first, b_iter->first);
+		if (!t_inst->IsType(ItemClassContainer)) {
+			for (uint32 contents = t_inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				if (t_inst->m_contents[b_index] == inst) {
+					return Inventory::CalcSlotId(collection.SlotAt(index), b_index);
 				}
 			}
 		}
@@ -1048,36 +1153,34 @@ int Inventory::GetSlotByItemInstCollection(const std::map<int16, ItemInst*> &col
 	return -1;
 }
 
-void Inventory::dumpItemCollection(const std::map<int16, ItemInst*> &collection) {
-	iter_inst it;
-	iter_contents itb;
+void Inventory::dumpItemCollection(const ItemInstBucket &collection) {
 	ItemInst* inst = nullptr;
 
-	for (it = collection.begin(); it != collection.end(); ++it) {
-		inst = it->second;
-		if (!inst || !inst->GetItem())
+	for (uint32 occupied = collection.Occupied(); occupied; ) {
+		int index = NextSetBit(occupied);
+		inst = collection.At(index);
+		if (!inst->GetItem())
 			continue;
 
-		std::string slot = StringFormat("Slot %d: %s (%d)", it->first, it->second->GetItem()->Name, (inst->GetCharges() <= 0) ? 1 : inst->GetCharges());
+		std::string slot = StringFormat("Slot %d: %s (%d)", collection.SlotAt(index), inst->GetItem()->Name, (inst->GetCharges() <= 0) ? 1 : inst->GetCharges());
 		std::cout << slot << std::endl;
 
-		dumpBagContents(inst, &it);
+		dumpBagContents(inst, collection.SlotAt(index));
 	}
 }
 
-void Inventory::dumpBagContents(ItemInst *inst, iter_inst *it) {
-	iter_contents itb;
-
+void Inventory::dumpBagContents(ItemInst *inst, int16 slot_id) {
 	if (!inst || !inst->IsType(ItemClassContainer))
 		return;
 
 	// Go through bag, if bag
-	for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-		ItemInst* baginst = itb->second;
-		if (!baginst || !baginst->GetItem())
+	for (uint32 contents = inst->_ContentsMask(); contents; ) {
+		uint8 b_index = NextSetBit(contents);
+		ItemInst* baginst = inst->m_contents[b_index];
+		if (!baginst->GetItem())
 			continue;
 
-		std::string subSlot = StringFormat("	Slot %d: %s (%d)", Inventory::CalcSlotId((*it)->first, itb->first),
+		std::string subSlot = StringFormat("	Slot %d: %s (%d)", Inventory::CalcSlotId(slot_id, b_index),
 			baginst->GetItem()->Name, (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges());
 		std::cout << subSlot << std::endl;
 	}
@@ -1085,15 +1188,9 @@ void Inventory::dumpBagContents(ItemInst *inst, iter_inst *it) {
 }
 
 // Internal Method: Retrieves item within an inventory bucket
-ItemInst* Inventory::_GetItem(const std::map<int16, ItemInst*>& bucket, int16 slot_id) const
+ItemInst* Inventory::_GetItem(const ItemInstBucket& bucket, int16 slot_id) const
 {
-	iter_inst it = bucket.find(slot_id);
-	if (it != bucket.end()) {
-		return it->second;
-	}
-
-	// Not found!
-	return nullptr;
+	return bucket.Get(slot_id);
 }
 
 // Internal Method: "put" item into bucket, without regard for what is currently in bucket
@@ -1117,27 +1214,27 @@ int16 Inventory::_PutItem(int16 slot_id, ItemInst* inst)
 		result = slot_id;
 	}
 	else if ((slot_id >= EmuConstants::EQUIPMENT_BEGIN && slot_id <= EmuConstants::EQUIPMENT_END) || (slot_id == MainPowerSource)) {
-		m_worn[slot_id] = inst;
+		m_worn.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else if ((slot_id >= EmuConstants::GENERAL_BEGIN && slot_id <= EmuConstants::GENERAL_END)) {
-		m_inv[slot_id] = inst;
+		m_inv.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= EmuConstants::TRIBUTE_BEGIN && slot_id <= EmuConstants::TRIBUTE_END) {
-		m_worn[slot_id] = inst;
+		m_worn.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= EmuConstants::BANK_BEGIN && slot_id <= EmuConstants::BANK_END) {
-		m_bank[slot_id] = inst;
+		m_bank.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= EmuConstants::SHARED_BANK_BEGIN && slot_id <= EmuConstants::SHARED_BANK_END) {
-		m_shbank[slot_id] = inst;
+		m_shbank.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else if (slot_id >= EmuConstants::TRADE_BEGIN && slot_id <= EmuConstants::TRADE_END) {
-		m_trade[slot_id] = inst;
+		m_trade.Put(slot_id, inst);
 		result = slot_id;
 	}
 	else
@@ -1161,40 +1258,50 @@ int16 Inventory::_PutItem(int16 slot_id, ItemInst* inst)
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 Inventory::_HasItem(std::map<int16, ItemInst*>& bucket, uint32 item_id, uint8 quantity)
+int16 Inventory::_HasItem(ItemInstBucket& bucket, uint32 item_id, uint8 quantity)
 {
-	iter_inst it;
-	iter_contents itb;
 	ItemInst* inst = nullptr;
 	uint8 quantity_found = 0;
 
+	// Top-level stacks are indexed by item id; use them directly when they satisfy the request
+	for (uint32 matches = bucket.FindByID(item_id); matches; ) {
+		int index = NextSetBit(matches);
+		inst = bucket.At(index);
+		quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
+		if (quantity_found >= quantity)
+			return bucket.SlotAt(index);
+	}
+
+	quantity_found = 0;
+
 	// Check item: After failed checks, check bag contents (if bag)
-	for (it = bucket.begin(); it != bucket.end(); ++it) {
-		inst = it->second;
-		if (inst) {
-			if (inst->GetID() == item_id) {
-				quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
-				if (quantity_found >= quantity)
-					return it->first;
-			}
+	for (uint32 occupied = bucket.Occupied(); occupied; ) {
+		int index = NextSetBit(occupied);
+		inst = bucket.At(index);
+		if (inst->GetID() == item_id) {
+			quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
+			if (quantity_found >= quantity)
+				return bucket.SlotAt(index);
+		}
 
-			for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
-				if (inst->GetAugmentItemID(i) == item_id && quantity <= 1)
-					return legacy::SLOT_AUGMENT; // Only one augment per slot.
-			}
+		for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
+			if (inst->GetAugmentItemID(i) == item_id && quantity <= 1)
+				return legacy::SLOT_AUGMENT; // Only one augment per slot.
 		}
+
 		// Go through bag, if bag
-		if (inst && inst->IsType(ItemClassContainer)) {
+		if (inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->GetID() == item_id) {
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->GetID() == item_id) {
 					quantity_found += (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges();
 					if (quantity_found >= quantity)
-						return Inventory::CalcSlotId(it->first, itb->first);
+						return Inventory::CalcSlotId(bucket.SlotAt(index), b_index);
 				}
 				for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
-					if (baginst && baginst->GetAugmentItemID(i) == item_id && quantity <= 1)
+					if (baginst->GetAugmentItemID(i) == item_id && quantity <= 1)
 						return legacy::SLOT_AUGMENT; // Only one augment per slot.
 				}
 			}
@@ -1209,7 +1316,6 @@ int16 Inventory::_HasItem(std::map<int16, ItemInst*>& bucket, uint32 item_id, ui
 int16 Inventory::_HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity)
 {
 	iter_queue it;
-	iter_contents itb;
 	uint8 quantity_found = 0;
 
 	// Read-only iteration of queue
@@ -1230,15 +1336,16 @@ int16 Inventory::_HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity)
 		// Go through bag, if bag
 		if (inst && inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->GetID() == item_id) {
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->GetID() == item_id) {
 					quantity_found += (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges();
 					if (quantity_found >= quantity)
-						return Inventory::CalcSlotId(MainCursor, itb->first);
+						return Inventory::CalcSlotId(MainCursor, b_index);
 				}
 				for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
-					if (baginst && baginst->GetAugmentItemID(i) == item_id && quantity <= 1)
+					if (baginst->GetAugmentItemID(i) == item_id && quantity <= 1)
 						return legacy::SLOT_AUGMENT; // Only one augment per slot.
 				}
 
@@ -1251,31 +1358,31 @@ int16 Inventory::_HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity)
 }
 
 // Internal Method: Checks an inventory bucket for a particular item
-int16 Inventory::_HasItemByUse(std::map<int16, ItemInst*>& bucket, uint8 use, uint8 quantity)
+int16 Inventory::_HasItemByUse(ItemInstBucket& bucket, uint8 use, uint8 quantity)
 {
-	iter_inst it;
-	iter_contents itb;
 	ItemInst* inst = nullptr;
 	uint8 quantity_found = 0;
 
 	// Check item: After failed checks, check bag contents (if bag)
-	for (it = bucket.begin(); it != bucket.end(); ++it) {
-		inst = it->second;
-		if (inst && inst->IsType(ItemClassCommon) && inst->GetItem()->ItemType == use) {
+	for (uint32 occupied = bucket.Occupied(); occupied; ) {
+		int index = NextSetBit(occupied);
+		inst = bucket.At(index);
+		if (inst->IsType(ItemClassCommon) && inst->GetItem()->ItemType == use) {
 			quantity_found += (inst->GetCharges() <= 0) ? 1 : inst->GetCharges();
 			if (quantity_found >= quantity)
-				return it->first;
+				return bucket.SlotAt(index);
 		}
 
 		// Go through bag, if bag
-		if (inst && inst->IsType(ItemClassContainer)) {
+		if (inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); itb++) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->IsType(ItemClassCommon) && baginst->GetItem()->ItemType == use) {
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->IsType(ItemClassCommon) && baginst->GetItem()->ItemType == use) {
 					quantity_found += (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges();
 					if (quantity_found >= quantity)
-						return Inventory::CalcSlotId(it->first, itb->first);
+						return Inventory::CalcSlotId(bucket.SlotAt(index), b_index);
 				}
 			}
 		}
@@ -1289,7 +1396,6 @@ int16 Inventory::_HasItemByUse(std::map<int16, ItemInst*>& bucket, uint8 use, ui
 int16 Inventory::_HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity)
 {
 	iter_queue it;
-	iter_contents itb;
 	uint8 quantity_found = 0;
 
 	// Read-only iteration of queue
@@ -1304,12 +1410,13 @@ int16 Inventory::_HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity)
 		// Go through bag, if bag
 		if (inst && inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->IsType(ItemClassCommon) && baginst->GetItem()->ItemType == use) {
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->IsType(ItemClassCommon) && baginst->GetItem()->ItemType == use) {
 					quantity_found += (baginst->GetCharges() <= 0) ? 1 : baginst->GetCharges();
 					if (quantity_found >= quantity)
-						return Inventory::CalcSlotId(MainCursor, itb->first);
+						return Inventory::CalcSlotId(MainCursor, b_index);
 				}
 			}
 		}
@@ -1319,33 +1426,32 @@ int16 Inventory::_HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity)
 	return INVALID_INDEX;
 }
 
-int16 Inventory::_HasItemByLoreGroup(std::map<int16, ItemInst*>& bucket, uint32 loregroup)
+int16 Inventory::_HasItemByLoreGroup(ItemInstBucket& bucket, uint32 loregroup)
 {
-	iter_inst it;
-	iter_contents itb;
 	ItemInst* inst = nullptr;
 
 	// Check item: After failed checks, check bag contents (if bag)
-	for (it = bucket.begin(); it != bucket.end(); ++it) {
-		inst = it->second;
-		if (inst) {
-			if (inst->GetItem()->LoreGroup == loregroup)
-				return it->first;
-
-			ItemInst* Aug = nullptr;
-			for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
-				Aug = inst->GetAugment(i);
-				if (Aug && Aug->GetItem()->LoreGroup == loregroup)
-					return legacy::SLOT_AUGMENT; // Only one augment per slot.
-			}
+	for (uint32 occupied = bucket.Occupied(); occupied; ) {
+		int index = NextSetBit(occupied);
+		inst = bucket.At(index);
+		if (inst->GetItem()->LoreGroup == loregroup)
+			return bucket.SlotAt(index);
+
+		ItemInst* Aug = nullptr;
+		for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
+			Aug = inst->GetAugment(i);
+			if (Aug && Aug->GetItem()->LoreGroup == loregroup)
+				return legacy::SLOT_AUGMENT; // Only one augment per slot.
 		}
+
 		// Go through bag, if bag
-		if (inst && inst->IsType(ItemClassContainer)) {
+		if (inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->IsType(ItemClassCommon) && baginst->GetItem()->LoreGroup == loregroup)
-					return Inventory::CalcSlotId(it->first, itb->first);
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->IsType(ItemClassCommon) && baginst->GetItem()->LoreGroup == loregroup)
+					return Inventory::CalcSlotId(bucket.SlotAt(index), b_index);
 
 				ItemInst* Aug2 = nullptr;
 				for (int i = AUG_BEGIN; i < EmuConstants::ITEM_COMMON_SIZE; i++) {
@@ -1365,7 +1471,6 @@ int16 Inventory::_HasItemByLoreGroup(std::map<int16, ItemInst*>& bucket, uint32
 int16 Inventory::_HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 loregroup)
 {
 	iter_queue it;
-	iter_contents itb;
 
 	// Read-only iteration of queue
 	for (it = iqueue.begin(); it != iqueue.end(); ++it) {
@@ -1385,10 +1490,11 @@ int16 Inventory::_HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 loregroup)
 		// Go through bag, if bag
 		if (inst && inst->IsType(ItemClassContainer)) {
 
-			for (itb = inst->_begin(); itb != inst->_end(); ++itb) {
-				ItemInst* baginst = itb->second;
-				if (baginst && baginst->IsType(ItemClassCommon) && baginst->GetItem()->LoreGroup == loregroup)
-					return Inventory::CalcSlotId(MainCursor, itb->first);
+			for (uint32 contents = inst->_ContentsMask(); contents; ) {
+				uint8 b_index = NextSetBit(contents);
+				ItemInst* baginst = inst->m_contents[b_index];
+				if (baginst->IsType(ItemClassCommon) && baginst->GetItem()->LoreGroup == loregroup)
+					return Inventory::CalcSlotId(MainCursor, b_index);
 
 
 				ItemInst* Aug2 = nullptr;
@@ -1433,6 +1539,9 @@ ItemInst::ItemInst(const Item_Struct* item, int16 charges) {
 	m_ornamenticon = 0;
 	m_ornamentidfile = 0;
 	m_ornament_hero_model = 0;
+
+	memset(m_contents, 0, sizeof(m_contents));
+	m_contents_mask = 0;
 }
 
 ItemInst::ItemInst(SharedDatabase *db, uint32 item_id, int16 charges) {
@@ -1458,6 +1567,9 @@ ItemInst::ItemInst(SharedDatabase *db, uint32 item_id, int16 charges) {
 	m_ornamenticon = 0;
 	m_ornamentidfile = 0;
 	m_ornament_hero_model = 0;
+
+	memset(m_contents, 0, sizeof(m_contents));
+	m_contents_mask = 0;
 }
 
 ItemInst::ItemInst(ItemInstTypes use_type) {
@@ -1478,6 +1590,9 @@ ItemInst::ItemInst(ItemInstTypes use_type) {
 	m_ornamenticon = 0;
 	m_ornamentidfile = 0;
 	m_ornament_hero_model = 0;
+
+	memset(m_contents, 0, sizeof(m_contents));
+	m_contents_mask = 0;
 }
 
 // Make a copy of an ItemInst object
@@ -1493,18 +1608,11 @@ ItemInst::ItemInst(const ItemInst& copy)
 	m_attuned=copy.m_attuned;
 	m_merchantcount=copy.m_merchantcount;
 	// Copy container contents
-	iter_contents it;
-	for (it=copy.m_contents.begin(); it!=copy.m_contents.end(); ++it) {
-		ItemInst* inst_old = it->second;
-		ItemInst* inst_new = nullptr;
-
-		if (inst_old) {
-			inst_new = inst_old->Clone();
-		}
-
-		if (inst_new != nullptr) {
-			m_contents[it->first] = inst_new;
-		}
+	memset(m_contents, 0, sizeof(m_contents));
+	m_contents_mask = 0;
+	for (uint32 contents = copy.m_contents_mask; contents; ) {
+		uint8 index = NextSetBit(contents);
+		_PutItem(index, copy.m_contents[index]->Clone());
 	}
 	std::map<std::string, std::string>::const_iterator iter;
 	for (iter = copy.m_custom_data.begin(); iter != copy.m_custom_data.end(); ++iter) {
@@ -1647,11 +1755,8 @@ bool ItemInst::IsAugmentSlotAvailable(int32 augtype, uint8 slot) const {
 // Retrieve item inside container
 ItemInst* ItemInst::GetItem(uint8 index) const
 {
-	iter_contents it = m_contents.find(index);
-	if (it != m_contents.end()) {
-		ItemInst* inst = it->second;
-		return inst;
-	}
+	if (index < EmuConstants::ITEM_CONTAINER_SIZE)
+		return m_contents[index];
 
 	return nullptr;
 }
@@ -1687,10 +1792,10 @@ void ItemInst::DeleteItem(uint8 index)
 // Hands over memory ownership to client of this function call
 ItemInst* ItemInst::PopItem(uint8 index)
 {
-	iter_contents it = m_contents.find(index);
-	if (it != m_contents.end()) {
-		ItemInst* inst = it->second;
-		m_contents.erase(index);
+	if (index < EmuConstants::ITEM_CONTAINER_SIZE && m_contents[index]) {
+		ItemInst* inst = m_contents[index];
+		m_contents[index] = nullptr;
+		m_contents_mask &= ~(1 << index);
 		return inst;
 	}
 
@@ -1698,46 +1803,51 @@ ItemInst* ItemInst::PopItem(uint8 index)
 	return nullptr;
 }
 
+// Internal Method: store item in container without regard for what is currently there
+void ItemInst::_PutItem(uint8 index, ItemInst* inst)
+{
+	if (index >= EmuConstants::ITEM_CONTAINER_SIZE) {
+		LogFile->write(EQEmuLog::Error, "ItemInst::_PutItem: Invalid container index specified (%i)", index);
+		Inventory::MarkDirty(inst); // Index not usable, clean up
+		return;
+	}
+
+	m_contents[index] = inst;
+	if (inst)
+		m_contents_mask |= (1 << index);
+	else
+		m_contents_mask &= ~(1 << index);
+}
+
 // Remove all items from container
 void ItemInst::Clear()
 {
 	// Destroy container contents
-	iter_contents cur, end;
-	cur = m_contents.begin();
-	end = m_contents.end();
-	for (; cur != end; ++cur) {
-		ItemInst* inst = cur->second;
-		safe_delete(inst);
+	for (uint32 contents = m_contents_mask; contents; ) {
+		uint8 index = NextSetBit(contents);
+		safe_delete(m_contents[index]);
 	}
-	m_contents.clear();
+	m_contents_mask = 0;
 }
 
 // Remove all items from container
 void ItemInst::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is_norent)
 {
 	// Destroy container contents
-	iter_contents cur, end, del;
-	cur = m_contents.begin();
-	end = m_contents.end();
-	for (; cur != end;) {
-		ItemInst* inst = cur->second;
-		if (inst == nullptr)
-			continue;
+	for (uint32 contents = m_contents_mask; contents; ) {
+		uint8 index = NextSetBit(contents);
+		ItemInst* inst = m_contents[index];
 		const Item_Struct* item = inst->GetItem();
-		del = cur;
-		++cur;
 
 		switch (is_nodrop) {
 		case byFlagSet:
 			if (item->NoDrop == 0) {
-				safe_delete(inst);
-				m_contents.erase(del->first);
+				delete PopItem(index);
 				continue;
 			}
 		case byFlagNotSet:
 			if (item->NoDrop != 0) {
-				safe_delete(inst);
-				m_contents.erase(del->first);
+				delete PopItem(index);
 				continue;
 			}
 		default:
@@ -1747,14 +1857,12 @@ void ItemInst::ClearByFlags(byFlagSetting is_nodrop, byFlagSetting is_norent)
 		switch (is_norent) {
 		case byFlagSet:
 			if (item->NoRent == 0) {
-				safe_delete(inst);
-				m_contents.erase(del->first);
+				delete PopItem(index);
 				continue;
 			}
 		case byFlagNotSet:
 			if (item->NoRent != 0) {
-				safe_delete(inst);
-				m_contents.erase(del->first);
+				delete PopItem(index);
 				continue;
 			}
 		default:
@@ -27,16 +27,16 @@ class ItemParse;			// Parses item packets
 class EvolveInfo;			// Stores information about an evolving item family
 
 #include "../common/eq_constants.h"
+#include "../common/eq_dictionary.h"
 #include "../common/item_struct.h"
 #include "../common/timer.h"
 
 #include <list>
 #include <map>
+#include <unordered_map>
 
 // Helper typedefs
 typedef std::list<ItemInst*>::const_iterator				iter_queue;
-typedef std::map<int16, ItemInst*>::const_iterator			iter_inst;
-typedef std::map<uint8, ItemInst*>::const_iterator			iter_contents;
 
 namespace ItemField
 {
@@ -106,6 +106,71 @@ protected:
 
 };
 
+// ########################################
+// Class: ItemInstBucket
+//	Fixed-size slot table backing an inventory bucket. Slots are laid out
+//	densely in ascending slot_id order; an occupancy bitmap drives iteration
+//	and an item id -> slot bitmap index answers HasItem() lookups.
+class ItemInstBucket
+{
+public:
+	/////////////////////////
+	// Public Methods
+	/////////////////////////
+
+	enum { MaxSlots = 32 };
+
+	ItemInstBucket();
+
+	// Map a contiguous run of slot ids onto the table; runs are added in ascending order
+	void AddRange(int16 slot_begin, int16 slot_end);
+
+	ItemInst* Get(int16 slot_id) const;
+
+	// Stores inst (or nullptr) at slot_id without memory delete, returning the previous occupant
+	ItemInst* Put(int16 slot_id, ItemInst* inst);
+	ItemInst* Pop(int16 slot_id) { return Put(slot_id, nullptr); }
+
+	// Deletes every occupant
+	void Clear();
+
+	// Dense index access; bit n of Occupied() is set when At(n) holds an item
+	inline uint32 Occupied() const			{ return m_occupied; }
+	inline ItemInst* At(int index) const	{ return m_slots[index]; }
+	inline int16 SlotAt(int index) const	{ return m_slot_ids[index]; }
+
+	// Bitmap of dense indexes holding item_id at the top level
+	uint32 FindByID(uint32 item_id) const;
+
+	// Lowest empty slot_id, or INVALID_INDEX when full
+	int16 FirstFreeSlot() const;
+
+protected:
+	/////////////////////////
+	// Protected Members
+	/////////////////////////
+
+	int _IndexOf(int16 slot_id) const;
+	void _IndexAdd(int index);
+	void _IndexRemove(int index);
+
+	struct SlotRange
+	{
+		int16 slot_begin;
+		int16 slot_end;
+		uint8 base;
+	};
+
+	SlotRange	m_ranges[3];
+	uint8		m_range_count;
+	uint8		m_size;
+	uint32		m_occupied;
+	int16		m_slot_ids[MaxSlots];
+	ItemInst*	m_slots[MaxSlots];
+
+	std::unordered_map<uint32, uint32> m_id_index;	// item id -> bitmap of dense indexes
+};
+
 // ########################################
 // Class: Inventory
 //	Character inventory
@@ -117,7 +182,7 @@ public:
 	// Public Methods
 	///////////////////////////////
 
-	Inventory() { m_version = EQClientUnknown; m_versionset = false; }
+	Inventory();
 	~Inventory();
 
 	// Inventory v2 creep
@@ -221,32 +286,32 @@ protected:
 	// Protected Methods
 	///////////////////////////////
 
-	int GetSlotByItemInstCollection(const std::map<int16, ItemInst*> &collection, ItemInst *inst);
-	void dumpItemCollection(const std::map<int16, ItemInst*> &collection);
-	void dumpBagContents(ItemInst *inst, iter_inst *it);
+	int GetSlotByItemInstCollection(const ItemInstBucket &collection, ItemInst *inst);
+	void dumpItemCollection(const ItemInstBucket &collection);
+	void dumpBagContents(ItemInst *inst, int16 slot_id);
 
 	// Retrieves item within an inventory bucket
-	ItemInst* _GetItem(const std::map<int16, ItemInst*>& bucket, int16 slot_id) const;
+	ItemInst* _GetItem(const ItemInstBucket& bucket, int16 slot_id) const;
 
 	// Private "put" item into bucket, without regard for what is currently in bucket
 	int16 _PutItem(int16 slot_id, ItemInst* inst);
 
 	// Checks an inventory bucket for a particular item
-	int16 _HasItem(std::map<int16, ItemInst*>& bucket, uint32 item_id, uint8 quantity);
+	int16 _HasItem(ItemInstBucket& bucket, uint32 item_id, uint8 quantity);
 	int16 _HasItem(ItemInstQueue& iqueue, uint32 item_id, uint8 quantity);
-	int16 _HasItemByUse(std::map<int16, ItemInst*>& bucket, uint8 use, uint8 quantity);
+	int16 _HasItemByUse(ItemInstBucket& bucket, uint8 use, uint8 quantity);
 	int16 _HasItemByUse(ItemInstQueue& iqueue, uint8 use, uint8 quantity);
-	int16 _HasItemByLoreGroup(std::map<int16, ItemInst*>& bucket, uint32 loregroup);
+	int16 _HasItemByLoreGroup(ItemInstBucket& bucket, uint32 loregroup);
 	int16 _HasItemByLoreGroup(ItemInstQueue& iqueue, uint32 loregroup);
 
 
 	// Player inventory
-	std::map<int16, ItemInst*>	m_worn;		// Items worn by character
-	std::map<int16, ItemInst*>	m_inv;		// Items in character personal inventory
-	std::map<int16, ItemInst*>	m_bank;		// Items in character bank
-	std::map<int16, ItemInst*>	m_shbank;	// Items in character shared bank
-	std::map<int16, ItemInst*>	m_trade;	// Items in a trade session
-	ItemInstQueue				m_cursor;	// Items on cursor: FIFO
+	ItemInstBucket	m_worn;		// Items worn by character
+	ItemInstBucket	m_inv;		// Items in character personal inventory
+	ItemInstBucket	m_bank;		// Items in character bank
+	ItemInstBucket	m_shbank;	// Items in character shared bank
+	ItemInstBucket	m_trade;	// Items in a trade session
+	ItemInstQueue	m_cursor;	// Items on cursor: FIFO
 
 private:
 	// Active inventory version
@@ -316,7 +381,6 @@ public:
 	uint8 FirstOpenSlot() const;
 	uint8 GetTotalItemCount() const;
 	bool IsNoneEmptyContainer();
-	std::map<uint8, ItemInst*>* GetContents() { return &m_contents; }
 
 	//
 	// Augments
@@ -419,13 +483,12 @@ protected:
 	//////////////////////////
 	// Protected Members
 	//////////////////////////
-	iter_contents _begin()		{ return m_contents.begin(); }
-	iter_contents _end()		{ return m_contents.end(); }
+	inline uint32 _ContentsMask() const	{ return m_contents_mask; }
 
 	friend class Inventory;
 
 
-	void _PutItem(uint8 index, ItemInst* inst) { m_contents[index] = inst; }
+	void _PutItem(uint8 index, ItemInst* inst);
 
 	ItemInstTypes		m_use_type;	// Usage type for item
 	const Item_Struct*	m_item;		// Ptr to item data
@@ -449,7 +512,8 @@ protected:
 
 	//
 	// Items inside of this item (augs or contents);
-	std::map<uint8, ItemInst*>			m_contents; // Zero-based index: min=0, max=9
+	ItemInst*							m_contents[EmuConstants::ITEM_CONTAINER_SIZE]; // Zero-based index: min=0, max=9
+	uint32								m_contents_mask; // Bit n set when m_contents[n] is occupied
 	std::map<std::string, std::string>	m_custom_data;
 	std::map<std::string, Timer>		m_timers;
 };
@@ -0,0 +1,106 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_LOG_QUEUE_H
+#define _EQEMU_LOG_QUEUE_H
+
+#include "types.h"
+#include <atomic>
+#include <time.h>
+
+//! Number of messages the log queue holds, must be a power of two
+#ifndef EQEMU_LOG_QUEUE_SIZE
+#define EQEMU_LOG_QUEUE_SIZE 2048
+#endif
+
+//! Longest formatted message that fits in the queue, longer ones are written synchronously
+#ifndef EQEMU_LOG_RECORD_SIZE
+#define EQEMU_LOG_RECORD_SIZE 512
+#endif
+
+namespace EQEmu {
+
+	//! Fixed size multi-producer single-consumer queue of formatted log messages
+	/*!
+		Any thread may Reserve() a record, fill it in and Commit() it without taking a lock. Only one thread at a
+		time may Peek() and Release(); the log serializes its consumers with a mutex. When the queue is full
+		Reserve() fails instead of blocking and the caller is expected to count the message as dropped.
+	*/
+	class LogQueue {
+	public:
+		struct Record {
+			std::atomic<uint32> sequence;
+			uint8 id;
+			uint16 length;
+			time_t when;
+			char text[EQEMU_LOG_RECORD_SIZE];
+		};
+
+		//! Constructor
+		LogQueue() : enqueue_pos_(0), dequeue_pos_(0) {
+			for(uint32 i = 0; i < EQEMU_LOG_QUEUE_SIZE; ++i)
+				records_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		//! Claims a record to fill in, nullptr if the queue is full
+		Record *Reserve() {
+			uint32 pos = enqueue_pos_.load(std::memory_order_relaxed);
+			for(;;) {
+				Record *r = &records_[pos & (EQEMU_LOG_QUEUE_SIZE - 1)];
+				int32 diff = (int32)(r->sequence.load(std::memory_order_acquire) - pos);
+				if(diff == 0) {
+					if(enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						return r;
+				} else if(diff < 0) {
+					return nullptr;
+				} else {
+					pos = enqueue_pos_.load(std::memory_order_relaxed);
+				}
+			}
+		}
+
+		//! Publishes a record claimed with Reserve() to the consumer
+		void Commit(Record *r) {
+			r->sequence.store(r->sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+		}
+
+		//! Oldest published record, nullptr if there is none yet
+		Record *Peek() {
+			Record *r = &records_[dequeue_pos_ & (EQEMU_LOG_QUEUE_SIZE - 1)];
+			if(r->sequence.load(std::memory_order_acquire) != dequeue_pos_ + 1)
+				return nullptr;
+			return r;
+		}
+
+		//! Hands the record returned by Peek() back to the producers
+		void Release(Record *r) {
+			r->sequence.store(dequeue_pos_ + EQEMU_LOG_QUEUE_SIZE, std::memory_order_release);
+			++dequeue_pos_;
+		}
+
+	private:
+		LogQueue(const LogQueue&);
+		const LogQueue& operator=(const LogQueue&);
+
+		Record records_[EQEMU_LOG_QUEUE_SIZE];
+		std::atomic<uint32> enqueue_pos_;
+		uint32 dequeue_pos_; //!< Only touched by the consumer
+	};
+}
+
+#endif
@@ -94,182 +94,134 @@ void eqemu_free_func(voidpf opaque, voidpf address) {
 #endif
 
 
-int DeflatePacket(const unsigned char* in_data, int in_length, unsigned char* out_data, int max_out_length) {
-#ifdef REUSE_ZLIB
-	static bool inited = false;
-	static z_stream zstream;
-	int zerror;
-
-	if(in_data == nullptr && out_data == nullptr && in_length == 0 && max_out_length == 0) {
-		//special delete state
-		deflateEnd(&zstream);
-		return(0);
-	}
-	if(!inited) {
-		memset(&zstream, 0, sizeof(zstream));
-		zstream.zalloc	= eqemu_alloc_func;
-		zstream.zfree	= eqemu_free_func;
-		zstream.opaque	= Z_NULL;
-		deflateInit(&zstream, Z_FINISH);
+/*
+	Each thread keeps one deflate and one inflate stream for its lifetime and
+	resets them between packets, so the zlib window is only allocated once
+	per thread instead of once per packet. The stream factory reader/writer
+	threads and the TCP connection threads all compress independently, which
+	is why this can't be a single process-wide stream.
+*/
+static volatile int deflate_level = 4;
+
+class ZlibContext {
+public:
+	ZlibContext() : deflate_ready(false), inflate_ready(false), level(0) { }
+	~ZlibContext() {
+		if(deflate_ready)
+			deflateEnd(&dstream);
+		if(inflate_ready)
+			inflateEnd(&istream);
 	}
 
-	zstream.next_in		= const_cast<unsigned char *>(in_data);
-	zstream.avail_in	= in_length;
-/*	zstream.zalloc	= Z_NULL;
-	zstream.zfree	= Z_NULL;
-	zstream.opaque	= Z_NULL;
-	deflateInit(&zstream, Z_FINISH);*/
-	zstream.next_out = out_data;
-	zstream.avail_out = max_out_length;
-	zerror = deflate(&zstream, Z_FINISH);
-
-	deflateReset(&zstream);
-
-	if (zerror == Z_STREAM_END)
-	{
-//		deflateEnd(&zstream);
-		return zstream.total_out;
-	}
-	else
-	{
-//		zerror = deflateEnd(&zstream);
-		return 0;
-	}
-#else
-	if(in_data == nullptr) {
-		return(0);
+	z_stream *GetDeflate() {
+		int want = deflate_level;
+		if(deflate_ready && level != want) {
+			deflateEnd(&dstream);
+			deflate_ready = false;
+		}
+		if(!deflate_ready) {
+			memset(&dstream, 0, sizeof(dstream));
+			dstream.zalloc = eqemu_alloc_func;
+			dstream.zfree = eqemu_free_func;
+			dstream.opaque = Z_NULL;
+			if(deflateInit(&dstream, want) != Z_OK)
+				return nullptr;
+			deflate_ready = true;
+			level = want;
+		} else {
+			deflateReset(&dstream);
+		}
+		return &dstream;
 	}
 
-	z_stream zstream;
-	memset(&zstream, 0, sizeof(zstream));
-	int zerror;
-
-	zstream.next_in		= const_cast<unsigned char *>(in_data);
-	zstream.avail_in	= in_length;
-	zstream.zalloc	= eqemu_alloc_func;
-	zstream.zfree	= eqemu_free_func;
-	zstream.opaque	= Z_NULL;
-	deflateInit(&zstream, Z_FINISH);
-	zstream.next_out = out_data;
-	zstream.avail_out = max_out_length;
-	zerror = deflate(&zstream, Z_FINISH);
-
-	if (zerror == Z_STREAM_END)
-	{
-		deflateEnd(&zstream);
-		return zstream.total_out;
-	}
-	else
-	{
-		zerror = deflateEnd(&zstream);
-		return 0;
+	z_stream *GetInflate() {
+		if(!inflate_ready) {
+			memset(&istream, 0, sizeof(istream));
+			istream.zalloc = eqemu_alloc_func;
+			istream.zfree = eqemu_free_func;
+			istream.opaque = Z_NULL;
+			if(inflateInit2(&istream, 15) != Z_OK)
+				return nullptr;
+			inflate_ready = true;
+		} else {
+			inflateReset(&istream);
+		}
+		return &istream;
 	}
-#endif
+
+private:
+	z_stream dstream;
+	z_stream istream;
+	bool deflate_ready;
+	bool inflate_ready;
+	int level;
+};
+
+static ZlibContext &GetZlibContext() {
+	static thread_local ZlibContext ctx;
+	return ctx;
 }
 
-uint32 InflatePacket(const uchar* indata, uint32 indatalen, uchar* outdata, uint32 outdatalen, bool iQuiet) {
-#ifdef REUSE_ZLIB
-	static bool inited = false;
-	static z_stream zstream;
-	int zerror;
-
-	if(indata == nullptr && outdata == nullptr && indatalen == 0 && outdatalen == 0) {
-		//special delete state
-		inflateEnd(&zstream);
-		return(0);
-	}
-	if(!inited) {
-		zstream.zalloc	= eqemu_alloc_func;
-		zstream.zfree	= eqemu_free_func;
-		zstream.opaque	= Z_NULL;
-		inflateInit2(&zstream, 15);
-	}
+void SetDeflateLevel(int level) {
+	if(level < Z_NO_COMPRESSION || level > Z_BEST_COMPRESSION)
+		level = Z_DEFAULT_COMPRESSION;
+	deflate_level = level;
+}
 
-	zstream.next_in		= const_cast<unsigned char *>(indata);
-	zstream.avail_in	= indatalen;
-	zstream.next_out	= outdata;
-	zstream.avail_out	= outdatalen;
-	zstream.zalloc		= eqemu_alloc_func;
-	zstream.zfree		= eqemu_free_func;
-	zstream.opaque		= Z_NULL;
+int GetDeflateLevel() {
+	return deflate_level;
+}
 
-	i = inflateInit2( &zstream, 15 );
-	if (i != Z_OK) {
-		return 0;
+int DeflatePacket(const unsigned char* in_data, int in_length, unsigned char* out_data, int max_out_length) {
+	if(in_data == nullptr || out_data == nullptr) {
+		return(0);
 	}
 
-	zerror = inflate( &zstream, Z_FINISH );
+	z_stream *zstream = GetZlibContext().GetDeflate();
+	if(zstream == nullptr)
+		return 0;
 
-	inflateReset(&zstream);
+	zstream->next_in	= const_cast<unsigned char *>(in_data);
+	zstream->avail_in	= in_length;
+	zstream->next_out	= out_data;
+	zstream->avail_out	= max_out_length;
 
-	if(zerror == Z_STREAM_END) {
-		return zstream.total_out;
-	}
-	else {
-		if (!iQuiet) {
-			std::cout << "Error: InflatePacket: inflate() returned " << zerror << " '";
-			if (zstream.msg)
-				std::cout << zstream.msg;
-			std::cout << "'" << std::endl;
-#ifdef EQDEBUG
-			DumpPacket(indata-16, indatalen+16);
-#endif
-		}
+	if (deflate(zstream, Z_FINISH) == Z_STREAM_END)
+		return zstream->total_out;
 
-		if (zerror == -4 && zstream.msg == 0)
-		{
-			return 0;
-		}
+	return 0;
+}
 
-		return 0;
-	}
-#else
-	if(indata == nullptr)
+uint32 InflatePacket(const uchar* indata, uint32 indatalen, uchar* outdata, uint32 outdatalen, bool iQuiet) {
+	if(indata == nullptr || outdata == nullptr)
 		return(0);
 
-	z_stream zstream;
-	int zerror = 0;
-	int i;
-
-	zstream.next_in		= const_cast<unsigned char *>(indata);
-	zstream.avail_in	= indatalen;
-	zstream.next_out	= outdata;
-	zstream.avail_out	= outdatalen;
-	zstream.zalloc		= eqemu_alloc_func;
-	zstream.zfree		= eqemu_free_func;
-	zstream.opaque		= Z_NULL;
-
-	i = inflateInit2( &zstream, 15 );
-	if (i != Z_OK) {
+	z_stream *zstream = GetZlibContext().GetInflate();
+	if(zstream == nullptr)
 		return 0;
-	}
 
-	zerror = inflate( &zstream, Z_FINISH );
+	zstream->next_in	= const_cast<unsigned char *>(indata);
+	zstream->avail_in	= indatalen;
+	zstream->next_out	= outdata;
+	zstream->avail_out	= outdatalen;
+
+	int zerror = inflate(zstream, Z_FINISH);
 
 	if(zerror == Z_STREAM_END) {
-		inflateEnd( &zstream );
-		return zstream.total_out;
+		return zstream->total_out;
 	}
-	else {
-		if (!iQuiet) {
-			std::cout << "Error: InflatePacket: inflate() returned " << zerror << " '";
-			if (zstream.msg)
-				std::cout << zstream.msg;
-			std::cout << "'" << std::endl;
+
+	if (!iQuiet) {
+		std::cout << "Error: InflatePacket: inflate() returned " << zerror << " '";
+		if (zstream->msg)
+			std::cout << zstream->msg;
+		std::cout << "'" << std::endl;
 #ifdef EQDEBUG
-			DumpPacket(indata-16, indatalen+16);
+		DumpPacket(indata-16, indatalen+16);
 #endif
-		}
-
-		if (zerror == -4 && zstream.msg == 0)
-		{
-			return 0;
-		}
-
-		zerror = inflateEnd( &zstream );
-		return 0;
 	}
-#endif
+
+	return 0;
 }
 
 uint32 roll(uint32 in, uint8 bits) {
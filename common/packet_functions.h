@@ -36,6 +36,9 @@ void EncryptProfilePacket(uchar* pBuffer, uint32 size);
 void EncryptZoneSpawnPacket(EQApplicationPacket* app);
 void EncryptZoneSpawnPacket(uchar* pBuffer, uint32 size);
 
+//deflate level for outbound packets, shared by every thread's stream
+void SetDeflateLevel(int level);
+int GetDeflateLevel();
 int DeflatePacket(const unsigned char* in_data, int in_length, unsigned char* out_data, int max_out_length);
 uint32 InflatePacket(const uchar* indata, uint32 indatalen, uchar* outdata, uint32 outdatalen, bool iQuiet = false);
 uint32 GenerateCRC(uint32 b, uint32 bufsize, uchar *buf);
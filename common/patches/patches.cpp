@@ -26,3 +26,9 @@ void ReloadAllPatches() {
 	RoF::Reload();
 	RoF2::Reload();
 }
+
+// Item data was reloaded, so serializations built from it are stale
+void ClearPatchItemCaches() {
+	RoF::ClearItemCache();
+	RoF2::ClearItemCache();
+}
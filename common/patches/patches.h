@@ -11,5 +11,6 @@ class EQStreamIdentifier;
 
 void RegisterAllPatches(EQStreamIdentifier &into);
 void ReloadAllPatches();
+void ClearPatchItemCaches();
 
 #endif /*PATCHES_H_*/
@@ -10,6 +10,7 @@ namespace RoF {
 	//these are the only public member of this namespace.
 	extern void Register(EQStreamIdentifier &into);
 	extern void Reload();
+	extern void ClearItemCache();
 
 
 
@@ -11,9 +11,11 @@
 #include "../item.h"
 #include "rof2_structs.h"
 #include "../rulesys.h"
+#include "../serialized_item_cache.h"
 
 #include <iostream>
 #include <sstream>
+#include <cstddef>
 
 namespace RoF2
 {
@@ -22,6 +24,12 @@ namespace RoF2
 	static Strategy struct_strategy;
 
 	char* SerializeItem(const ItemInst *inst, int16 slot_id, uint32 *length, uint8 depth, ItemPacketType packet_type);
+	static void SerializeItemInto(std::string &ss, const ItemInst *inst, int16 slot_id_in, uint8 depth, ItemPacketType packet_type);
+	static void SerializeItemBody(std::string &ss, const Item_Struct *item);
+
+	// static part of each item's serialization, see SerializeItemBody()
+	static EQEmu::SerializedItemCache item_cache;
+	static const size_t SERIALIZED_ITEM_RESERVE = 2048;
 
 	// server to client inventory location converters
 	static inline structs::ItemSlotStruct ServerToRoF2Slot(uint32 ServerSlot, ItemPacketType PacketType = ItemPacketInvalid);
@@ -99,6 +107,11 @@ namespace RoF2
 		}
 	}
 
+	void ClearItemCache()
+	{
+		item_cache.Clear();
+	}
+
 	Strategy::Strategy() : StructStrategy()
 	{
 		//all opcodes default to passthrough.
@@ -5038,127 +5051,44 @@ namespace RoF2
 		return NextItemInstSerialNumber;
 	}
 
-	char* SerializeItem(const ItemInst *inst, int16 slot_id_in, uint32 *length, uint8 depth, ItemPacketType packet_type)
+	// everything from the item name through the quaternary body, less its subitem
+	// count, depends only on the Item_Struct and is kept in item_cache
+	static void SerializeItemBody(std::string &ss, const Item_Struct *item)
 	{
-		int ornamentationAugtype = RuleI(Character, OrnamentationAugmentType);
 		uint8 null_term = 0;
-		bool stackable = inst->IsStackable();
-		uint32 merchant_slot = inst->GetMerchantSlot();
-		uint32 charges = inst->GetCharges();
-		if (!stackable && charges > 254)
-			charges = 0xFFFFFFFF;
-
-		std::stringstream ss(std::stringstream::in | std::stringstream::out | std::stringstream::binary);
-
-		const Item_Struct *item = inst->GetUnscaledItem();
-		//_log(NET__ERROR, "Serialize called for: %s", item->Name);
-
-		RoF2::structs::ItemSerializationHeader hdr;
-
-		//sprintf(hdr.unknown000, "06e0002Y1W00");
-
-		snprintf(hdr.unknown000, sizeof(hdr.unknown000), "%012d", item->ID);
-
-		hdr.stacksize = stackable ? charges : 1;
-		hdr.unknown004 = 0;
-
-		structs::ItemSlotStruct slot_id = ServerToRoF2Slot(slot_id_in, packet_type);
-
-		hdr.slot_type = (merchant_slot == 0) ? slot_id.SlotType : 9; // 9 is merchant 20 is reclaim items?
-		hdr.main_slot = (merchant_slot == 0) ? slot_id.MainSlot : merchant_slot;
-		hdr.sub_slot = (merchant_slot == 0) ? slot_id.SubSlot : 0xffff;
-		hdr.aug_slot = (merchant_slot == 0) ? slot_id.AugSlot : 0xffff;
-		hdr.price = inst->GetPrice();
-		hdr.merchant_slot = (merchant_slot == 0) ? 1 : inst->GetMerchantCount();
-		hdr.scaled_value = inst->IsScaling() ? inst->GetExp() / 100 : 0;
-		hdr.instance_id = (merchant_slot == 0) ? inst->GetSerialNumber() : merchant_slot;
-		hdr.unknown028 = 0;
-		hdr.last_cast_time = ((item->RecastDelay > 1) ? 1212693140 : 0);
-		hdr.charges = (stackable ? (item->MaxCharges ? 1 : 0) : charges);
-		hdr.inst_nodrop = inst->IsAttuned() ? 1 : 0;
-		hdr.unknown044 = 0;
-		hdr.unknown048 = 0;
-		hdr.unknown052 = 0;
-		hdr.isEvolving = item->EvolvingLevel > 0 ? 1 : 0;
-		ss.write((const char*)&hdr, sizeof(RoF2::structs::ItemSerializationHeader));
-
-		if (item->EvolvingLevel > 0) {
-			RoF2::structs::EvolvingItem evotop;
-			evotop.unknown001 = 0;
-			evotop.unknown002 = 0;
-			evotop.unknown003 = 0;
-			evotop.unknown004 = 0;
-			evotop.evoLevel = item->EvolvingLevel;
-			evotop.progress = 95.512;
-			evotop.Activated = 1;
-			evotop.evomaxlevel = 7;
-			ss.write((const char*)&evotop, sizeof(RoF2::structs::EvolvingItem));
-		}
-		//ORNAMENT IDFILE / ICON
-		uint32 ornaIcon = 0;
-		uint32 heroModel = 0;
-
-		if (inst->GetOrnamentationIDFile() && inst->GetOrnamentationIcon())
-		{
-			char tmp[30]; memset(tmp, 0x0, 30); sprintf(tmp, "IT%d", inst->GetOrnamentationIDFile());
-			//Mainhand
-			ss.write(tmp, strlen(tmp));
-			ss.write((const char*)&null_term, sizeof(uint8));
-			//Offhand
-			ss.write(tmp, strlen(tmp));
-			ss.write((const char*)&null_term, sizeof(uint8));
-			ornaIcon = inst->GetOrnamentationIcon();
-			heroModel = inst->GetOrnamentHeroModel(Inventory::CalcMaterialFromSlot(slot_id_in));
-		}
-		else
-		{
-			ss.write((const char*)&null_term, sizeof(uint8)); // no main hand Ornamentation
-			ss.write((const char*)&null_term, sizeof(uint8)); // no off hand Ornamentation
-		}
-
-		RoF2::structs::ItemSerializationHeaderFinish hdrf;
-		hdrf.ornamentIcon = ornaIcon;
-		hdrf.unknowna1 = 0xffffffff;
-		hdrf.ornamentHeroModel = heroModel;
-		hdrf.unknown063 = 0;
-		hdrf.Copied = 0;
-		hdrf.unknowna4 = 0xffffffff;
-		hdrf.unknowna5 = 0;
-		hdrf.ItemClass = item->ItemClass;
-
-		ss.write((const char*)&hdrf, sizeof(RoF2::structs::ItemSerializationHeaderFinish));
+		bool stackable = item->Stackable;
 
 		if (strlen(item->Name) > 0)
 		{
-			ss.write(item->Name, strlen(item->Name));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append(item->Name, strlen(item->Name));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
 		if (strlen(item->Lore) > 0)
 		{
-			ss.write(item->Lore, strlen(item->Lore));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append(item->Lore, strlen(item->Lore));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
 		if (strlen(item->IDFile) > 0)
 		{
-			ss.write(item->IDFile, strlen(item->IDFile));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append(item->IDFile, strlen(item->IDFile));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&null_term, sizeof(uint8));
+		ss.append((const char*)&null_term, sizeof(uint8));
 		//_log(NET__ERROR, "ItemBody struct is %i bytes", sizeof(RoF2::structs::ItemBodyStruct));
 		RoF2::structs::ItemBodyStruct ibs;
 		memset(&ibs, 0, sizeof(RoF2::structs::ItemBodyStruct));
@@ -5253,17 +5183,17 @@ namespace RoF2
 		ibs.FactionAmt4 = item->FactionAmt4;
 		ibs.FactionMod4 = item->FactionMod4;
 
-		ss.write((const char*)&ibs, sizeof(RoF2::structs::ItemBodyStruct));
+		ss.append((const char*)&ibs, sizeof(RoF2::structs::ItemBodyStruct));
 
 		//charm text
 		if (strlen(item->CharmFile) > 0)
 		{
-			ss.write((const char*)item->CharmFile, strlen(item->CharmFile));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->CharmFile, strlen(item->CharmFile));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
 		//_log(NET__ERROR, "ItemBody secondary struct is %i bytes", sizeof(RoF2::structs::ItemSecondaryBodyStruct));
@@ -5295,16 +5225,16 @@ namespace RoF2
 		isbs.book = item->Book;
 		isbs.booktype = item->BookType;
 
-		ss.write((const char*)&isbs, sizeof(RoF2::structs::ItemSecondaryBodyStruct));
+		ss.append((const char*)&isbs, sizeof(RoF2::structs::ItemSecondaryBodyStruct));
 
 		if (strlen(item->Filename) > 0)
 		{
-			ss.write((const char*)item->Filename, strlen(item->Filename));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->Filename, strlen(item->Filename));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
 		//_log(NET__ERROR, "ItemBody tertiary struct is %i bytes", sizeof(RoF2::structs::ItemTertiaryBodyStruct));
@@ -5341,7 +5271,7 @@ namespace RoF2
 		itbs.unknown13 = 0;
 		itbs.unknown14 = 0;
 
-		ss.write((const char*)&itbs, sizeof(RoF2::structs::ItemTertiaryBodyStruct));
+		ss.append((const char*)&itbs, sizeof(RoF2::structs::ItemTertiaryBodyStruct));
 
 		// Effect Structures Broken down to allow variable length strings for effect names
 		int32 effect_unknown = 0;
@@ -5359,19 +5289,19 @@ namespace RoF2
 		ices.recast = item->RecastDelay;
 		ices.recast_type = item->RecastType;
 
-		ss.write((const char*)&ices, sizeof(RoF2::structs::ClickEffectStruct));
+		ss.append((const char*)&ices, sizeof(RoF2::structs::ClickEffectStruct));
 
 		if (strlen(item->ClickName) > 0)
 		{
-			ss.write((const char*)item->ClickName, strlen(item->ClickName));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->ClickName, strlen(item->ClickName));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// clickunk7
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// clickunk7
 
 		//_log(NET__ERROR, "ItemBody proc effect struct is %i bytes", sizeof(RoF2::structs::ProcEffectStruct));
 		RoF2::structs::ProcEffectStruct ipes;
@@ -5383,19 +5313,19 @@ namespace RoF2
 		ipes.level = item->Proc.Level;
 		ipes.procrate = item->ProcRate;
 
-		ss.write((const char*)&ipes, sizeof(RoF2::structs::ProcEffectStruct));
+		ss.append((const char*)&ipes, sizeof(RoF2::structs::ProcEffectStruct));
 
 		if (strlen(item->ProcName) > 0)
 		{
-			ss.write((const char*)item->ProcName, strlen(item->ProcName));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->ProcName, strlen(item->ProcName));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// unknown5
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// unknown5
 
 		//_log(NET__ERROR, "ItemBody worn effect struct is %i bytes", sizeof(RoF2::structs::WornEffectStruct));
 		RoF2::structs::WornEffectStruct iwes;
@@ -5406,19 +5336,19 @@ namespace RoF2
 		iwes.type = item->Worn.Type;
 		iwes.level = item->Worn.Level;
 
-		ss.write((const char*)&iwes, sizeof(RoF2::structs::WornEffectStruct));
+		ss.append((const char*)&iwes, sizeof(RoF2::structs::WornEffectStruct));
 
 		if (strlen(item->WornName) > 0)
 		{
-			ss.write((const char*)item->WornName, strlen(item->WornName));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->WornName, strlen(item->WornName));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// unknown6
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// unknown6
 
 		RoF2::structs::WornEffectStruct ifes;
 		memset(&ifes, 0, sizeof(RoF2::structs::WornEffectStruct));
@@ -5428,19 +5358,19 @@ namespace RoF2
 		ifes.type = item->Focus.Type;
 		ifes.level = item->Focus.Level;
 
-		ss.write((const char*)&ifes, sizeof(RoF2::structs::WornEffectStruct));
+		ss.append((const char*)&ifes, sizeof(RoF2::structs::WornEffectStruct));
 
 		if (strlen(item->FocusName) > 0)
 		{
-			ss.write((const char*)item->FocusName, strlen(item->FocusName));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->FocusName, strlen(item->FocusName));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// unknown6
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// unknown6
 
 		RoF2::structs::WornEffectStruct ises;
 		memset(&ises, 0, sizeof(RoF2::structs::WornEffectStruct));
@@ -5450,19 +5380,19 @@ namespace RoF2
 		ises.type = item->Scroll.Type;
 		ises.level = item->Scroll.Level;
 
-		ss.write((const char*)&ises, sizeof(RoF2::structs::WornEffectStruct));
+		ss.append((const char*)&ises, sizeof(RoF2::structs::WornEffectStruct));
 
 		if (strlen(item->ScrollName) > 0)
 		{
-			ss.write((const char*)item->ScrollName, strlen(item->ScrollName));
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)item->ScrollName, strlen(item->ScrollName));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else
 		{
-			ss.write((const char*)&null_term, sizeof(uint8));
+			ss.append((const char*)&null_term, sizeof(uint8));
 		}
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// unknown6
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// unknown6
 
 		// Bard Effect?
 		RoF2::structs::WornEffectStruct ibes;
@@ -5474,18 +5404,18 @@ namespace RoF2
 		ibes.level = 0;
 		//ibes.unknown6 = 0xffffffff;
 
-		ss.write((const char*)&ibes, sizeof(RoF2::structs::WornEffectStruct));
+		ss.append((const char*)&ibes, sizeof(RoF2::structs::WornEffectStruct));
 
 		/*
 		if(strlen(item->BardName) > 0)
 		{
-		ss.write((const char*)item->BardName, strlen(item->BardName));
-		ss.write((const char*)&null_term, sizeof(uint8));
+		ss.append((const char*)item->BardName, strlen(item->BardName));
+		ss.append((const char*)&null_term, sizeof(uint8));
 		}
 		else */
-		ss.write((const char*)&null_term, sizeof(uint8));
+		ss.append((const char*)&null_term, sizeof(uint8));
 
-		ss.write((const char*)&effect_unknown, sizeof(int32));	// unknown6
+		ss.append((const char*)&effect_unknown, sizeof(int32));	// unknown6
 		// End of Effects
 
 		//_log(NET__ERROR, "ItemBody Quaternary effect struct is %i bytes", sizeof(RoF2::structs::ItemQuaternaryBodyStruct));
@@ -5532,15 +5462,109 @@ namespace RoF2
 
 		iqbs.unknown39 = 1;
 
-		iqbs.subitem_count = 0;
+		ss.append((const char*)&iqbs, offsetof(RoF2::structs::ItemQuaternaryBodyStruct, subitem_count));
+	}
+
+	static void SerializeItemInto(std::string &ss, const ItemInst *inst, int16 slot_id_in, uint8 depth, ItemPacketType packet_type)
+	{
+		int ornamentationAugtype = RuleI(Character, OrnamentationAugmentType);
+		uint8 null_term = 0;
+		bool stackable = inst->IsStackable();
+		uint32 merchant_slot = inst->GetMerchantSlot();
+		uint32 charges = inst->GetCharges();
+		if (!stackable && charges > 254)
+			charges = 0xFFFFFFFF;
+
+		const Item_Struct *item = inst->GetUnscaledItem();
+		//_log(NET__ERROR, "Serialize called for: %s", item->Name);
 
-		char *SubSerializations[10]; // <watch>
+		RoF2::structs::ItemSerializationHeader hdr;
 
-		uint32 SubLengths[10];
+		//sprintf(hdr.unknown000, "06e0002Y1W00");
 
-		for (int x = SUB_BEGIN; x < EmuConstants::ITEM_CONTAINER_SIZE; ++x) {
+		snprintf(hdr.unknown000, sizeof(hdr.unknown000), "%012d", item->ID);
+
+		hdr.stacksize = stackable ? charges : 1;
+		hdr.unknown004 = 0;
+
+		structs::ItemSlotStruct slot_id = ServerToRoF2Slot(slot_id_in, packet_type);
 
-			SubSerializations[x] = nullptr;
+		hdr.slot_type = (merchant_slot == 0) ? slot_id.SlotType : 9; // 9 is merchant 20 is reclaim items?
+		hdr.main_slot = (merchant_slot == 0) ? slot_id.MainSlot : merchant_slot;
+		hdr.sub_slot = (merchant_slot == 0) ? slot_id.SubSlot : 0xffff;
+		hdr.aug_slot = (merchant_slot == 0) ? slot_id.AugSlot : 0xffff;
+		hdr.price = inst->GetPrice();
+		hdr.merchant_slot = (merchant_slot == 0) ? 1 : inst->GetMerchantCount();
+		hdr.scaled_value = inst->IsScaling() ? inst->GetExp() / 100 : 0;
+		hdr.instance_id = (merchant_slot == 0) ? inst->GetSerialNumber() : merchant_slot;
+		hdr.unknown028 = 0;
+		hdr.last_cast_time = ((item->RecastDelay > 1) ? 1212693140 : 0);
+		hdr.charges = (stackable ? (item->MaxCharges ? 1 : 0) : charges);
+		hdr.inst_nodrop = inst->IsAttuned() ? 1 : 0;
+		hdr.unknown044 = 0;
+		hdr.unknown048 = 0;
+		hdr.unknown052 = 0;
+		hdr.isEvolving = item->EvolvingLevel > 0 ? 1 : 0;
+		ss.append((const char*)&hdr, sizeof(RoF2::structs::ItemSerializationHeader));
+
+		if (item->EvolvingLevel > 0) {
+			RoF2::structs::EvolvingItem evotop;
+			evotop.unknown001 = 0;
+			evotop.unknown002 = 0;
+			evotop.unknown003 = 0;
+			evotop.unknown004 = 0;
+			evotop.evoLevel = item->EvolvingLevel;
+			evotop.progress = 95.512;
+			evotop.Activated = 1;
+			evotop.evomaxlevel = 7;
+			ss.append((const char*)&evotop, sizeof(RoF2::structs::EvolvingItem));
+		}
+		//ORNAMENT IDFILE / ICON
+		uint32 ornaIcon = 0;
+		uint32 heroModel = 0;
+
+		if (inst->GetOrnamentationIDFile() && inst->GetOrnamentationIcon())
+		{
+			char tmp[30]; memset(tmp, 0x0, 30); sprintf(tmp, "IT%d", inst->GetOrnamentationIDFile());
+			//Mainhand
+			ss.append(tmp, strlen(tmp));
+			ss.append((const char*)&null_term, sizeof(uint8));
+			//Offhand
+			ss.append(tmp, strlen(tmp));
+			ss.append((const char*)&null_term, sizeof(uint8));
+			ornaIcon = inst->GetOrnamentationIcon();
+			heroModel = inst->GetOrnamentHeroModel(Inventory::CalcMaterialFromSlot(slot_id_in));
+		}
+		else
+		{
+			ss.append((const char*)&null_term, sizeof(uint8)); // no main hand Ornamentation
+			ss.append((const char*)&null_term, sizeof(uint8)); // no off hand Ornamentation
+		}
+
+		RoF2::structs::ItemSerializationHeaderFinish hdrf;
+		hdrf.ornamentIcon = ornaIcon;
+		hdrf.unknowna1 = 0xffffffff;
+		hdrf.ornamentHeroModel = heroModel;
+		hdrf.unknown063 = 0;
+		hdrf.Copied = 0;
+		hdrf.unknowna4 = 0xffffffff;
+		hdrf.unknowna5 = 0;
+		hdrf.ItemClass = item->ItemClass;
+
+		ss.append((const char*)&hdrf, sizeof(RoF2::structs::ItemSerializationHeaderFinish));
+
+		if (!item_cache.Append(item, ss)) {
+			size_t body_begin = ss.size();
+			SerializeItemBody(ss, item);
+			item_cache.Store(item, ss.data() + body_begin, ss.size() - body_begin);
+		}
+
+		// bag contents are serialized straight into this buffer after the count
+		uint32 subitem_count = 0;
+		size_t subitem_count_pos = ss.size();
+		ss.append((const char*)&subitem_count, sizeof(uint32));
+
+		for (int x = SUB_BEGIN; x < EmuConstants::ITEM_CONTAINER_SIZE; ++x) {
 
 			const ItemInst* subitem = ((const ItemInst*)inst)->GetItem(x);
 
@@ -5548,7 +5572,7 @@ namespace RoF2
 
 				int SubSlotNumber;
 
-				iqbs.subitem_count++;
+				subitem_count++;
 
 				if (slot_id_in >= EmuConstants::GENERAL_BEGIN && slot_id_in <= EmuConstants::GENERAL_END) // (< 30) - no cursor?
 					//SubSlotNumber = (((slot_id_in + 3) * 10) + x + 1);
@@ -5567,29 +5591,25 @@ namespace RoF2
 				SubSlotNumber = Inventory::CalcSlotID(slot_id_in, x);
 				*/
 
-				SubSerializations[x] = SerializeItem(subitem, SubSlotNumber, &SubLengths[x], depth + 1, packet_type);
+				ss.append((const char*)&x, sizeof(uint32));
+
+				SerializeItemInto(ss, subitem, SubSlotNumber, depth + 1, packet_type);
 			}
 		}
 
-		ss.write((const char*)&iqbs, sizeof(RoF2::structs::ItemQuaternaryBodyStruct));
-
-		for (int x = SUB_BEGIN; x < EmuConstants::ITEM_CONTAINER_SIZE; ++x) {
-
-			if (SubSerializations[x]) {
-
-				ss.write((const char*)&x, sizeof(uint32));
-
-				ss.write(SubSerializations[x], SubLengths[x]);
+		memcpy(&ss[subitem_count_pos], &subitem_count, sizeof(uint32));
+	}
 
-				safe_delete_array(SubSerializations[x]);
-			}
-		}
+	char* SerializeItem(const ItemInst *inst, int16 slot_id_in, uint32 *length, uint8 depth, ItemPacketType packet_type)
+	{
+		std::string ss;
+		ss.reserve(SERIALIZED_ITEM_RESERVE);
+		SerializeItemInto(ss, inst, slot_id_in, depth, packet_type);
 
-		char* item_serial = new char[ss.tellp()];
-		memset(item_serial, 0, ss.tellp());
-		memcpy(item_serial, ss.str().c_str(), ss.tellp());
+		char* item_serial = new char[ss.size()];
+		memcpy(item_serial, ss.data(), ss.size());
 
-		*length = ss.tellp();
+		*length = ss.size();
 		return item_serial;
 	}
 
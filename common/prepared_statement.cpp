@@ -0,0 +1,284 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "debug.h"
+#include "prepared_statement.h"
+#include "mutex.h"
+#include <stdio.h>
+
+EQEmu::PreparedStatement::PreparedStatement(MYSQL *mysql, const std::string &query)
+: statement_(nullptr), metadata_(nullptr), query_(query), error_number_(0), param_count_(0), column_count_(0),
+	has_result_(false)
+{
+	Prepare(mysql);
+}
+
+EQEmu::PreparedStatement::~PreparedStatement() {
+	Invalidate();
+}
+
+bool EQEmu::PreparedStatement::Prepare(MYSQL *mysql) {
+	Invalidate();
+	error_number_ = 0;
+	error_.clear();
+
+	MYSQL_STMT *statement = mysql_stmt_init(mysql);
+	if(statement == nullptr) {
+		error_number_ = mysql_errno(mysql);
+		error_ = "mysql_stmt_init failed, out of memory";
+		return false;
+	}
+
+	if(mysql_stmt_prepare(statement, query_.c_str(), query_.length()) != 0) {
+		statement_ = statement;
+		SetError();
+		mysql_stmt_close(statement);
+		statement_ = nullptr;
+		return false;
+	}
+
+	statement_ = statement;
+	param_count_ = mysql_stmt_param_count(statement_);
+	column_count_ = mysql_stmt_field_count(statement_);
+	params_.resize(param_count_);
+	param_values_.resize(param_count_);
+	columns_.resize(column_count_);
+	column_state_.resize(column_count_);
+
+	if(column_count_ > 0) {
+		metadata_ = mysql_stmt_result_metadata(statement_);
+
+		//have the client work out the longest value in each column so string buffers are sized once per result
+		my_bool update_max_length = 1;
+		mysql_stmt_attr_set(statement_, STMT_ATTR_UPDATE_MAX_LENGTH, &update_max_length);
+	}
+
+	return true;
+}
+
+void EQEmu::PreparedStatement::Invalidate() {
+	if(metadata_) {
+		mysql_free_result(metadata_);
+		metadata_ = nullptr;
+	}
+	if(statement_) {
+		Reset();
+		mysql_stmt_close(statement_);
+		statement_ = nullptr;
+		error_number_ = 0;
+		error_ = "Statement was invalidated by a reconnect";
+	}
+}
+
+uint32 EQEmu::PreparedStatement::RowCount() const {
+	return has_result_ ? (uint32)mysql_stmt_num_rows(statement_) : 0;
+}
+
+uint32 EQEmu::PreparedStatement::AffectedRows() const {
+	return statement_ ? (uint32)mysql_stmt_affected_rows(statement_) : 0;
+}
+
+uint32 EQEmu::PreparedStatement::LastInsertID() const {
+	return statement_ ? (uint32)mysql_stmt_insert_id(statement_) : 0;
+}
+
+void EQEmu::PreparedStatement::Reset() {
+	if(has_result_) {
+		mysql_stmt_free_result(statement_);
+		has_result_ = false;
+	}
+}
+
+void EQEmu::PreparedStatement::SetError() {
+	char buffer[MYSQL_ERRMSG_SIZE];
+	error_number_ = mysql_stmt_errno(statement_);
+	snprintf(buffer, sizeof(buffer), "#%i: %s", error_number_, mysql_stmt_error(statement_));
+	error_ = buffer;
+}
+
+bool EQEmu::PreparedStatement::BeginExecute(uint32 count) {
+	if(statement_ == nullptr)
+		return false;
+
+	if(count != param_count_) {
+		error_number_ = 0;
+		error_ = "Statement takes a different number of parameters than were given";
+		LogFile->write(EQEmuLog::Error, "Prepared statement '%s' takes %u parameters, %u given", query_.c_str(), param_count_, count);
+		return false;
+	}
+
+	Reset();
+	error_number_ = 0;
+	error_.clear();
+	return true;
+}
+
+bool EQEmu::PreparedStatement::FinishExecute() {
+	if(param_count_ > 0 && mysql_stmt_bind_param(statement_, &params_[0]) != 0) {
+		SetError();
+		return false;
+	}
+
+	if(mysql_stmt_execute(statement_) != 0) {
+		SetError();
+		return false;
+	}
+
+	if(column_count_ == 0)
+		return true;
+
+	//buffer the whole result so the connection is free for other queries while rows are read
+	if(mysql_stmt_store_result(statement_) != 0) {
+		SetError();
+		mysql_stmt_free_result(statement_);
+		return false;
+	}
+	has_result_ = true;
+
+	MYSQL_FIELD *fields = mysql_fetch_fields(metadata_);
+	for(uint32 r = 0; r < column_count_; r++) {
+		std::vector<char> &buffer = column_state_[r].buffer;
+		if(buffer.size() <= fields[r].max_length)
+			buffer.resize(fields[r].max_length + 1);
+	}
+
+	return true;
+}
+
+void EQEmu::PreparedStatement::BindParam(uint32 index, const std::string &value) {
+	MYSQL_BIND &bind = params_[index];
+	memset(&bind, 0, sizeof(bind));
+	bind.buffer_type = MYSQL_TYPE_STRING;
+	bind.buffer = (void *) value.data();
+	bind.buffer_length = value.length();
+}
+
+void EQEmu::PreparedStatement::BindParam(uint32 index, const char *value) {
+	MYSQL_BIND &bind = params_[index];
+	memset(&bind, 0, sizeof(bind));
+	if(value == nullptr) {
+		bind.buffer_type = MYSQL_TYPE_NULL;
+		return;
+	}
+	bind.buffer_type = MYSQL_TYPE_STRING;
+	bind.buffer = (void *) value;
+	bind.buffer_length = strlen(value);
+}
+
+void EQEmu::PreparedStatement::BindColumn(uint32 index, std::string &value) {
+	ColumnState &state = column_state_[index];
+	MYSQL_BIND &bind = columns_[index];
+	memset(&bind, 0, sizeof(bind));
+	if(state.buffer.empty())
+		state.buffer.resize(1);
+	bind.buffer_type = MYSQL_TYPE_STRING;
+	bind.buffer = &state.buffer[0];
+	bind.buffer_length = state.buffer.size();
+	bind.length = &state.length;
+	bind.is_null = &state.is_null;
+	bind.error = &state.error;
+	state.text = &value;
+}
+
+bool EQEmu::PreparedStatement::BeginFetch(uint32 count) {
+	if(!has_result_)
+		return false;
+
+	if(count != column_count_) {
+		error_number_ = 0;
+		error_ = "Statement returns a different number of columns than were given";
+		LogFile->write(EQEmuLog::Error, "Prepared statement '%s' returns %u columns, %u given", query_.c_str(), column_count_, count);
+		return false;
+	}
+
+	return true;
+}
+
+bool EQEmu::PreparedStatement::FinishFetch() {
+	if(column_count_ > 0 && mysql_stmt_bind_result(statement_, &columns_[0]) != 0) {
+		SetError();
+		return false;
+	}
+
+	int status = mysql_stmt_fetch(statement_);
+	if(status == MYSQL_NO_DATA)
+		return false;
+	if(status != 0 && status != MYSQL_DATA_TRUNCATED) {
+		SetError();
+		return false;
+	}
+
+	for(uint32 r = 0; r < column_count_; r++) {
+		ColumnState &state = column_state_[r];
+		MYSQL_BIND &bind = columns_[r];
+
+		if(state.text == nullptr) {
+			//a number that doesn't fit its variable can't be read again, the row is wrong
+			if(status == MYSQL_DATA_TRUNCATED && state.error) {
+				error_number_ = 0;
+				error_ = "Column value truncated";
+				LogFile->write(EQEmuLog::Error, "Prepared statement '%s' column %u does not fit the variable it is fetched into", query_.c_str(), r);
+				return false;
+			}
+			//numbers are written in place, only NULL needs fixing up to match the old atoi() behaviour
+			if(state.is_null)
+				memset(bind.buffer, 0, bind.buffer_length);
+			continue;
+		}
+
+		if(state.is_null) {
+			state.text->clear();
+			continue;
+		}
+
+		if(state.length > bind.buffer_length) {
+			//max_length is only a hint for some column types, read the rest of a value that didn't fit
+			state.buffer.resize(state.length + 1);
+			bind.buffer = &state.buffer[0];
+			bind.buffer_length = state.buffer.size();
+			if(mysql_stmt_fetch_column(statement_, &bind, r, 0) != 0) {
+				SetError();
+				return false;
+			}
+		}
+
+		state.text->assign(&state.buffer[0], state.length);
+	}
+
+	return true;
+}
+
+EQEmu::PreparedQuery::PreparedQuery(Mutex *lock, PreparedStatement *statement)
+: lock_(lock), statement_(statement)
+{
+	lock_->lock();
+}
+
+EQEmu::PreparedQuery::PreparedQuery(PreparedQuery &&other)
+: lock_(other.lock_), statement_(other.statement_)
+{
+	other.lock_ = nullptr;
+	other.statement_ = nullptr;
+}
+
+EQEmu::PreparedQuery::~PreparedQuery() {
+	if(statement_)
+		statement_->Reset();
+	if(lock_)
+		lock_->unlock();
+}
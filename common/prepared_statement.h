@@ -0,0 +1,201 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_PREPARED_STATEMENT_H
+#define _EQEMU_PREPARED_STATEMENT_H
+
+#ifdef _WINDOWS
+	#include <winsock.h>
+	#include <windows.h>
+#endif
+
+#include "types.h"
+#include <mysql.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+class Mutex;
+
+namespace EQEmu {
+
+	//! Maps a C++ type onto the MySQL binary protocol type it is sent and received as
+	template<typename T> struct BindType;
+	template<> struct BindType<int8> { static const enum_field_types field = MYSQL_TYPE_TINY; static const bool is_unsigned = false; };
+	template<> struct BindType<uint8> { static const enum_field_types field = MYSQL_TYPE_TINY; static const bool is_unsigned = true; };
+	template<> struct BindType<int16> { static const enum_field_types field = MYSQL_TYPE_SHORT; static const bool is_unsigned = false; };
+	template<> struct BindType<uint16> { static const enum_field_types field = MYSQL_TYPE_SHORT; static const bool is_unsigned = true; };
+	template<> struct BindType<int32> { static const enum_field_types field = MYSQL_TYPE_LONG; static const bool is_unsigned = false; };
+	template<> struct BindType<uint32> { static const enum_field_types field = MYSQL_TYPE_LONG; static const bool is_unsigned = true; };
+	template<> struct BindType<int64> { static const enum_field_types field = MYSQL_TYPE_LONGLONG; static const bool is_unsigned = false; };
+	template<> struct BindType<uint64> { static const enum_field_types field = MYSQL_TYPE_LONGLONG; static const bool is_unsigned = true; };
+	template<> struct BindType<float> { static const enum_field_types field = MYSQL_TYPE_FLOAT; static const bool is_unsigned = false; };
+	template<> struct BindType<double> { static const enum_field_types field = MYSQL_TYPE_DOUBLE; static const bool is_unsigned = false; };
+
+	//! A server side prepared statement with typed parameter and result binding
+	/*!
+		Parameters are passed straight to Execute() and each row is fetched into a list of variables, so
+		numbers travel in the binary protocol and are never formatted or parsed as text. Supported types are
+		the fixed width integers, float, double and std::string. A NULL column reads as 0 or an empty string.
+
+		Statements belong to the connection they were prepared on; get them from DBcore::Prepare(), which
+		caches them by their text and keeps the connection locked while they are in use.
+	*/
+	class PreparedStatement {
+	public:
+		//! Prepares query on mysql, check IsValid() afterwards
+		PreparedStatement(MYSQL *mysql, const std::string &query);
+		~PreparedStatement();
+
+		//! False if the server rejected the statement or its connection was reset
+		bool IsValid() const { return statement_ != nullptr; }
+		//! Prepares the statement again on mysql, in place so handles to it stay usable
+		bool Prepare(MYSQL *mysql);
+		//! Drops the server side statement, it fails cleanly until Prepare() is called again
+		void Invalidate();
+		//! Text the statement was prepared from
+		const std::string &GetQuery() const { return query_; }
+		//! Message of the last failure, formatted like MySQLRequestResult's
+		const std::string &GetError() const { return error_; }
+		//! MySQL error number of the last failure, 0 if the last call succeeded
+		uint32 GetErrorNumber() const { return error_number_; }
+
+		//! Binds one argument per placeholder and runs the statement, buffering any result set
+		template<typename... Args>
+		bool Execute(const Args&... args) {
+			if(!BeginExecute(sizeof...(Args)))
+				return false;
+			BindParams(0, args...);
+			return FinishExecute();
+		}
+
+		//! Reads the next row into one variable per column, false once the rows run out or on error
+		template<typename... Columns>
+		bool Fetch(Columns&... columns) {
+			if(!BeginFetch(sizeof...(Columns)))
+				return false;
+			BindColumns(0, columns...);
+			return FinishFetch();
+		}
+
+		//! Rows in the result of the last Execute()
+		uint32 RowCount() const;
+		//! Rows changed by the last Execute()
+		uint32 AffectedRows() const;
+		//! Auto increment id generated by the last Execute()
+		uint32 LastInsertID() const;
+		//! Frees the buffered result of the last Execute()
+		void Reset();
+
+	private:
+		PreparedStatement(const PreparedStatement&);
+		const PreparedStatement& operator=(const PreparedStatement&);
+
+		bool BeginExecute(uint32 count);
+		bool FinishExecute();
+		bool BeginFetch(uint32 count);
+		bool FinishFetch();
+		void SetError();
+
+		void BindParams(uint32) { }
+		template<typename T, typename... Rest>
+		void BindParams(uint32 index, const T &value, const Rest&... rest) {
+			BindParam(index, value);
+			BindParams(index + 1, rest...);
+		}
+
+		template<typename T>
+		void BindParam(uint32 index, const T &value) {
+			MYSQL_BIND &bind = params_[index];
+			memset(&bind, 0, sizeof(bind));
+			memcpy(&param_values_[index], &value, sizeof(T));
+			bind.buffer_type = BindType<T>::field;
+			bind.is_unsigned = BindType<T>::is_unsigned;
+			bind.buffer = &param_values_[index];
+		}
+		void BindParam(uint32 index, const std::string &value);
+		void BindParam(uint32 index, const char *value);
+
+		void BindColumns(uint32) { }
+		template<typename T, typename... Rest>
+		void BindColumns(uint32 index, T &value, Rest&... rest) {
+			BindColumn(index, value);
+			BindColumns(index + 1, rest...);
+		}
+
+		template<typename T>
+		void BindColumn(uint32 index, T &value) {
+			MYSQL_BIND &bind = columns_[index];
+			memset(&bind, 0, sizeof(bind));
+			bind.buffer_type = BindType<T>::field;
+			bind.is_unsigned = BindType<T>::is_unsigned;
+			bind.buffer = &value;
+			bind.buffer_length = sizeof(T);
+			bind.is_null = &column_state_[index].is_null;
+			bind.error = &column_state_[index].error;
+			column_state_[index].text = nullptr;
+		}
+		void BindColumn(uint32 index, std::string &value);
+
+		struct ColumnState {
+			my_bool is_null;
+			my_bool error;
+			unsigned long length;
+			std::string *text; //!< Destination of a string column, buffer holds the raw bytes
+			std::vector<char> buffer;
+		};
+
+		MYSQL_STMT *statement_;
+		MYSQL_RES *metadata_;
+		std::string query_;
+		std::string error_;
+		uint32 error_number_;
+		uint32 param_count_;
+		uint32 column_count_;
+		bool has_result_;
+		std::vector<MYSQL_BIND> params_;
+		std::vector<uint64> param_values_;
+		std::vector<MYSQL_BIND> columns_;
+		std::vector<ColumnState> column_state_;
+	};
+
+	//! Locked use of a statement from DBcore::Prepare()
+	/*!
+		The connection stays locked from Prepare() until the handle goes out of scope, so the statement and its
+		buffered result can't be touched by another thread in between. The result is freed on release.
+	*/
+	class PreparedQuery {
+	public:
+		PreparedQuery(Mutex *lock, PreparedStatement *statement);
+		PreparedQuery(PreparedQuery &&other);
+		~PreparedQuery();
+
+		//! False if the statement could not be prepared, GetError() says why
+		bool IsValid() const { return statement_ != nullptr && statement_->IsValid(); }
+		PreparedStatement *operator->() { return statement_; }
+
+	private:
+		PreparedQuery(const PreparedQuery&);
+		const PreparedQuery& operator=(const PreparedQuery&);
+
+		Mutex *lock_;
+		PreparedStatement *statement_;
+	};
+}
+
+#endif
@@ -175,6 +175,11 @@ RULE_CATEGORY_END()
 
 RULE_CATEGORY( Zone )
 RULE_INT ( Zone, NPCPositonUpdateTicCount, 32 ) //ms between intervals of sending a position update to the entire zone.
+RULE_REAL ( Zone, PositionUpdateNearRange, 150 ) // clients this close to a moving spawn get every position update as it happens
+RULE_REAL ( Zone, PositionUpdateMidRange, 400 ) // clients past the near range but within this one get PositionUpdateMidInterval updates
+RULE_INT ( Zone, PositionUpdateMidInterval, 250 ) // ms between position updates of one spawn to a client in the mid range, 0 sends every update
+RULE_INT ( Zone, PositionUpdateFarInterval, 1000 ) // ms between position updates of one spawn to a client past the mid range, 0 sends every update
+RULE_REAL ( Zone, NPCDormantRange, 1500 ) // NPCs with no client this close stop processing until one comes back or something acts on them, 0 disables
 RULE_INT ( Zone, ClientLinkdeadMS, 180000) //the time a client remains link dead on the server after a sudden disconnection
 RULE_INT ( Zone, GraveyardTimeMS, 1200000) //ms time until a player corpse is moved to a zone's graveyard, if one is specified for the zone
 RULE_BOOL ( Zone, EnableShadowrest, 1 ) // enables or disables the shadowrest zone feature for player corpses. Default is turned on.
@@ -596,6 +601,10 @@ RULE_CATEGORY( Client )
 RULE_BOOL( Client, UseLiveFactionMessage, false) // Allows players to see faction adjustments like Live
 RULE_CATEGORY_END()
 
+RULE_CATEGORY( Network )
+RULE_INT( Network, CompressionLevel, 4 ) // zlib level (0-9) for outbound client packets
+RULE_CATEGORY_END()
+
 #undef RULE_CATEGORY
 #undef RULE_INT
 #undef RULE_REAL
@@ -0,0 +1,61 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "serialized_item_cache.h"
+#include "item_struct.h"
+
+namespace EQEmu {
+
+	SerializedItemCache::SerializedItemCache(uint32 max_entries) : max_entries(max_entries), hits(0), misses(0) {
+	}
+
+	SerializedItemCache::~SerializedItemCache() {
+	}
+
+	bool SerializedItemCache::Append(const Item_Struct *item, std::string &out) {
+		LockMutex lck(&lock);
+		auto iter = entries.find(item->ID);
+		if(iter == entries.end() || iter->second.item != item) {
+			++misses;
+			return false;
+		}
+
+		out.append(iter->second.body);
+		++hits;
+		return true;
+	}
+
+	void SerializedItemCache::Store(const Item_Struct *item, const char *data, size_t length) {
+		LockMutex lck(&lock);
+		auto iter = entries.find(item->ID);
+		if(iter == entries.end()) {
+			if(entries.size() >= max_entries)
+				return;
+
+			iter = entries.insert(std::make_pair(item->ID, Entry())).first;
+		}
+
+		iter->second.item = item;
+		iter->second.body.assign(data, length);
+	}
+
+	void SerializedItemCache::Clear() {
+		LockMutex lck(&lock);
+		entries.clear();
+	}
+}
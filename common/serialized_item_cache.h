@@ -0,0 +1,85 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_SERIALIZEDITEMCACHE_H_
+#define _EQEMU_SERIALIZEDITEMCACHE_H_
+
+#include <string>
+#include <unordered_map>
+#include "types.h"
+#include "mutex.h"
+
+struct Item_Struct;
+
+namespace EQEmu {
+
+	//! Per-client item serialization cache
+	/*!
+		Holds the part of a client item serialization that only depends on the Item_Struct
+		(names, stats, effects) so inventory, merchant and bazaar sends only have to write the
+		per-instance header and bag contents. Each patch owns one cache, which makes the key
+		(item id, client version). An entry is only used while the Item_Struct pointer it was
+		built from is unchanged.
+	*/
+	class SerializedItemCache {
+	public:
+		//! Constructor
+		/*!
+			\param max_entries Number of items after which new bodies are no longer stored.
+		*/
+		SerializedItemCache(uint32 max_entries = 65536);
+		~SerializedItemCache();
+
+		//! Append Cached Body
+		/*!
+			Appends the cached body for item to out.
+			\return False if the body is not cached and must be serialized.
+		*/
+		bool Append(const Item_Struct *item, std::string &out);
+
+		//! Store Body
+		/*!
+			\param item The item the body was serialized from.
+			\param data Start of the serialized body.
+			\param length Length of the serialized body.
+		*/
+		void Store(const Item_Struct *item, const char *data, size_t length);
+
+		//! Drops every cached body, used when item data is reloaded.
+		void Clear();
+
+		uint64 GetHits() const { return hits; }
+		uint64 GetMisses() const { return misses; }
+	private:
+		SerializedItemCache(const SerializedItemCache&);
+		const SerializedItemCache& operator=(const SerializedItemCache&);
+
+		struct Entry {
+			const Item_Struct *item;
+			std::string body;
+		};
+
+		std::unordered_map<uint32, Entry> entries;
+		uint32 max_entries;
+		uint64 hits;
+		uint64 misses;
+		Mutex lock;
+	};
+}
+
+#endif
@@ -77,6 +77,9 @@
 #define ServerOP_GroupJoin			0x003e //for joining ooz folks
 #define ServerOP_UpdateSpawn		0x003f
 #define ServerOP_SpawnStatusChange	0x0040
+#define ServerOP_GuildRosterRequest	0x0041	// zone asks world for a guild's member list
+#define ServerOP_GuildRoster		0x0042	// world's cached member list, in chunks
+#define ServerOP_GuildMemberDelta	0x0043	// one member's current guild info, after any change
 #define ServerOP_ReloadTasks		0x0060
 #define ServerOP_DepopAllPlayersCorpses	0x0061
 #define ServerOP_ReloadTitles		0x0062
@@ -105,6 +108,9 @@
 #define ServerOP_GroupFollowAck		0x0111
 #define ServerOP_GroupCancelInvite	0x0112
 #define ServerOP_RaidMOTD			0x0113
+#define ServerOP_RaidMemberDelta	0x0114
+#define ServerOP_RaidSnapshotRequest	0x0115
+#define ServerOP_RaidSnapshot		0x0116
 
 #define ServerOP_InstanceUpdateTime			0x014F
 #define ServerOP_AdventureRequest			0x0150
@@ -190,6 +196,7 @@
 #define ServerOP_QSSendQuery						0x4016
 #define ServerOP_CZSignalNPC						0x4017
 #define ServerOP_CZSetEntityVariableByNPCTypeID		0x4018
+#define ServerOP_SharedMemoryGeneration				0x4019
 
 /* Query Serv Generic Packet Flag/Type Enumeration */
 enum { QSG_LFGuild = 0 }; 
@@ -801,6 +808,43 @@ struct ServerGuildMemberUpdate_Struct {
 	uint32 LastSeen;
 };
 
+struct ServerGuildMember_Struct {
+	uint32	char_id;
+	char	char_name[64];
+	uint8	class_;
+	uint16	level;
+	uint32	time_last_on;
+	uint32	zone_id;
+	uint32	guild_id;
+	uint8	rank;
+	uint8	tribute_enable;
+	uint32	total_tribute;
+	uint32	last_tribute;
+	uint8	banker;
+	uint8	alt;
+	char	public_note[256];
+};
+
+struct ServerGuildRosterRequest_Struct {
+	uint32	guild_id;
+	uint32	zone_id;
+	uint16	instance_id;
+};
+
+struct ServerGuildRoster_Struct {
+	uint32	guild_id;
+	uint8	first;	// starts a new list
+	uint8	last;	// list is complete
+	uint8	failed;	// world couldn't load it, read the database instead
+	uint32	count;
+	ServerGuildMember_Struct members[0];
+};
+
+struct ServerGuildMemberDelta_Struct {
+	uint32	old_guild_id;
+	ServerGuildMember_Struct member;	// guild_id is GUILD_NONE when they left
+};
+
 struct SpawnPlayerCorpse_Struct {
 	uint32 player_corpse_id;
 	uint32 zone_id;
@@ -860,6 +904,42 @@ struct ServerRaidMOTD_Struct {
 	char motd[0];
 };
 
+enum { RaidDeltaUpsert = 0, RaidDeltaRemove = 1, RaidDeltaDisband = 2 };
+
+struct ServerRaidMember_Struct {
+	char name[64];
+	uint32 charid;
+	uint32 groupid;
+	uint8 _class;
+	uint8 level;
+	uint8 isgroupleader;
+	uint8 israidleader;
+	uint8 islooter;
+};
+
+// Zone -> world with version 0; world stamps the raid's new version and sends it to every zone
+struct ServerRaidMemberDelta_Struct {
+	uint32 zoneid;
+	uint16 instance_id;
+	uint32 rid;
+	uint32 version;
+	uint8 action;
+	ServerRaidMember_Struct member;
+};
+
+struct ServerRaidSnapshotRequest_Struct {
+	uint32 zoneid;
+	uint16 instance_id;
+	uint32 rid;
+};
+
+struct ServerRaidSnapshot_Struct {
+	uint32 rid;
+	uint32 version;
+	uint32 count;
+	ServerRaidMember_Struct members[0];
+};
+
 struct ServerLFGMatchesRequest_Struct {
 	uint32	FromID;
 	uint8	QuerierLevel;
@@ -1262,6 +1342,12 @@ struct ServerRequestTellQueue_Struct {
 	char	name[64];
 };
 
+// shared_memory published a new generation of a segment, see SharedMemoryGeneration
+struct ServerSharedMemoryGeneration_Struct {
+	char	segment[32];
+	uint32	generation;
+};
+
 #pragma pack()
 
 #endif
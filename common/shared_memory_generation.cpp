@@ -0,0 +1,81 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "shared_memory_generation.h"
+#include "memory_mapped_file.h"
+#include <atomic>
+#include <stdio.h>
+
+namespace EQEmu {
+
+	//! Contents of shared/<segment>.generation
+	struct SharedMemoryGenerationHeader {
+		std::atomic<uint32> generation;
+	};
+
+	std::string SharedMemoryGeneration::HeaderName(const std::string &segment) {
+		return "shared/" + segment + ".generation";
+	}
+
+	uint32 SharedMemoryGeneration::Current(const std::string &segment) {
+		std::string filename = HeaderName(segment);
+
+		//no header yet means only the unversioned files exist
+		FILE *f = fopen(filename.c_str(), "rb");
+		if(!f) {
+			return 0;
+		}
+		fseek(f, 0U, SEEK_END);
+		long length = ftell(f);
+		fclose(f);
+
+		//Publish() hasn't finished sizing a brand new header, which MemoryMappedFile prefixes with its own size
+		if(length < static_cast<long>(2 * sizeof(uint32) + sizeof(SharedMemoryGenerationHeader))) {
+			return 0;
+		}
+
+		MemoryMappedFile header(filename);
+
+		return reinterpret_cast<SharedMemoryGenerationHeader*>(header.Get())->generation.load(std::memory_order_acquire);
+	}
+
+	void SharedMemoryGeneration::Publish(const std::string &segment, uint32 generation) {
+		//the file is created zeroed the first time, later calls only swap the number
+		MemoryMappedFile header(HeaderName(segment), sizeof(SharedMemoryGenerationHeader));
+		reinterpret_cast<SharedMemoryGenerationHeader*>(header.Get())->generation.store(generation, std::memory_order_release);
+	}
+
+	std::string SharedMemoryGeneration::FileName(const std::string &file, uint32 generation) {
+		if(generation == 0) {
+			return file;
+		}
+
+		return file + "." + std::to_string(generation);
+	}
+
+	void SharedMemoryGeneration::Retire(const std::string &file, uint32 generation) {
+		//zones that haven't reloaded yet still map the previous generation, anything older is unused
+		if(generation >= 2) {
+			Remove(file, generation - 2);
+		}
+	}
+
+	void SharedMemoryGeneration::Remove(const std::string &file, uint32 generation) {
+		remove(FileName(file, generation).c_str());
+	}
+} // EQEmu
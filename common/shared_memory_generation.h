@@ -0,0 +1,62 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_SHARED_MEMORY_GENERATION_H_
+#define _EQEMU_SHARED_MEMORY_GENERATION_H_
+
+#include <string>
+#include "types.h"
+
+namespace EQEmu {
+
+	//! Generation numbered shared memory segments
+	/*!
+		Every rebuild of a segment is written to new files named after its generation, e.g. shared/items.4, and
+		only becomes current once it is complete and Publish() swaps the generation in the segment's header
+		file. A process that already mapped an older generation keeps reading it untouched, and picks up the
+		new one by mapping it again. Generation 0 is the plain file name used before segments were versioned.
+
+		Callers hold the segment's IPCMutex around Current() and the open, and around a rebuild and its
+		Publish(), so a reader never opens a generation that is being written or removed.
+	*/
+	class SharedMemoryGeneration {
+	public:
+		//! Generation the segment's header points at, 0 if it has never been published
+		static uint32 Current(const std::string &segment);
+
+		//! Generation a rebuild of the segment should be written as
+		static uint32 Next(const std::string &segment) { return Current(segment) + 1; }
+
+		//! Makes generation current for segment
+		static void Publish(const std::string &segment, uint32 generation);
+
+		//! Deletes what file's older generations left behind once generation has been published
+		static void Retire(const std::string &file, uint32 generation);
+
+		//! Name of the file holding generation of a segment file, e.g. shared/items
+		static std::string FileName(const std::string &file, uint32 generation);
+
+	private:
+		//! Deletes the file holding generation if nothing has it open on Windows, mapped views stay valid elsewhere
+		static void Remove(const std::string &file, uint32 generation);
+
+		static std::string HeaderName(const std::string &segment);
+	};
+} // EQEmu
+
+#endif
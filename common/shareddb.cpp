@@ -10,6 +10,7 @@
 #include "item.h"
 #include "loottable.h"
 #include "memory_mapped_file.h"
+#include "shared_memory_generation.h"
 #include "mysql.h"
 #include "rulesys.h"
 #include "shareddb.h"
@@ -17,14 +18,16 @@
 
 SharedDatabase::SharedDatabase()
 : Database(), skill_caps_mmf(nullptr), items_mmf(nullptr), items_hash(nullptr), faction_mmf(nullptr), faction_hash(nullptr),
-	loot_table_mmf(nullptr), loot_table_hash(nullptr), loot_drop_mmf(nullptr), loot_drop_hash(nullptr), base_data_mmf(nullptr)
+	loot_table_mmf(nullptr), loot_table_hash(nullptr), loot_drop_mmf(nullptr), loot_drop_hash(nullptr), base_data_mmf(nullptr),
+	skill_caps_generation(0), items_generation(0), faction_generation(0), loot_generation(0), base_data_generation(0)
 {
 }
 
 SharedDatabase::SharedDatabase(const char* host, const char* user, const char* passwd, const char* database, uint32 port)
 : Database(host, user, passwd, database, port), skill_caps_mmf(nullptr), items_mmf(nullptr), items_hash(nullptr),
 	faction_mmf(nullptr), faction_hash(nullptr), loot_table_mmf(nullptr), loot_table_hash(nullptr), loot_drop_mmf(nullptr),
-	loot_drop_hash(nullptr), base_data_mmf(nullptr)
+	loot_drop_hash(nullptr), base_data_mmf(nullptr), skill_caps_generation(0), items_generation(0), faction_generation(0),
+	loot_generation(0), base_data_generation(0)
 {
 }
 
@@ -39,6 +42,30 @@ SharedDatabase::~SharedDatabase() {
 	safe_delete(loot_table_hash);
 	safe_delete(loot_drop_hash);
 	safe_delete(base_data_mmf);
+	for(size_t i = 0; i < retired_mmfs.size(); ++i)
+		safe_delete(retired_mmfs[i]);
+}
+
+bool SharedDatabase::ReloadSharedMemory() {
+	//each load is a no-op unless shared_memory published a newer generation of that segment
+	bool success = true;
+	if(items_mmf && !LoadItems())
+		success = false;
+	if(faction_mmf && !LoadNPCFactionLists())
+		success = false;
+	if(loot_table_mmf && !LoadLoot())
+		success = false;
+	if(skill_caps_mmf && !LoadSkillCaps())
+		success = false;
+	if(base_data_mmf && !LoadBaseData())
+		success = false;
+	return success;
+}
+
+void SharedDatabase::RetireSharedMemory(EQEmu::MemoryMappedFile *mmf) {
+	//item, spell and loot pointers into an old generation live on in instances, so it stays mapped
+	if(mmf)
+		retired_mmfs.push_back(mmf);
 }
 
 bool SharedDatabase::SetHideMe(uint32 account_id, uint8 hideme)
@@ -487,37 +514,31 @@ bool SharedDatabase::GetSharedBank(uint32 id, Inventory* inv, bool is_charid) {
 
 // Overloaded: Retrieve character inventory based on character id
 bool SharedDatabase::GetInventory(uint32 char_id, Inventory* inv) {
-	// Retrieve character inventory
-	std::string query = StringFormat("SELECT slotid, itemid, charges, color, augslot1, "
+	// Retrieve character inventory. Every zone-in runs this, so it is prepared once and the rows come back
+	// as binary values instead of text that has to be parsed.
+	auto stmt = Prepare("SELECT slotid, itemid, charges, color, augslot1, "
                                     "augslot2, augslot3, augslot4, augslot5, augslot6, instnodrop, custom_data, ornamenticon, ornamentidfile, ornament_hero_model "
-                                    "FROM inventory WHERE charid = %i ORDER BY slotid", char_id);
-    auto results = QueryDatabase(query);
-    if (!results.Success()) {
-    		LogFile->write(EQEmuLog::Error, "GetInventory query '%s' %s", query.c_str(), results.ErrorMessage().c_str());
+                                    "FROM inventory WHERE charid = ? ORDER BY slotid");
+    if (!stmt.IsValid() || !stmt->Execute(char_id)) {
+    		LogFile->write(EQEmuLog::Error, "GetInventory query '%s' %s", stmt->GetQuery().c_str(), stmt->GetError().c_str());
             LogFile->write(EQEmuLog::Error, "If you got an error related to the 'instnodrop' field, run the following SQL Queries:\nalter table inventory add instnodrop tinyint(1) unsigned default 0 not null;\n");
         return false;
     }
 
-    for (auto row = results.begin(); row != results.end(); ++row) {
-        int16 slot_id	= atoi(row[0]);
-        uint32 item_id	= atoi(row[1]);
-        uint16 charges	= atoi(row[2]);
-        uint32 color	= atoul(row[3]);
-
-        uint32 aug[EmuConstants::ITEM_COMMON_SIZE];
-
-        aug[0] = (uint32)atoul(row[4]);
-        aug[1] = (uint32)atoul(row[5]);
-        aug[2] = (uint32)atoul(row[6]);
-        aug[3] = (uint32)atoul(row[7]);
-        aug[4] = (uint32)atoul(row[8]);
-		aug[5] = (uint32)atoul(row[9]);
-
-        bool instnodrop	= (row[10] && (uint16)atoi(row[10]))? true: false;
-
-		uint32 ornament_icon = (uint32)atoul(row[12]);
-		uint32 ornament_idfile = (uint32)atoul(row[13]);
-		uint32 ornament_hero_model = (uint32)atoul(row[14]);
+    int16 slot_id;
+    uint32 item_id;
+    uint16 charges;
+    uint32 color;
+    uint32 aug[EmuConstants::ITEM_COMMON_SIZE];
+    uint16 instnodrop_value;
+    std::string data_str;
+    uint32 ornament_icon;
+    uint32 ornament_idfile;
+    uint32 ornament_hero_model;
+
+    while (stmt->Fetch(slot_id, item_id, charges, color, aug[0], aug[1], aug[2], aug[3], aug[4], aug[5],
+                       instnodrop_value, data_str, ornament_icon, ornament_idfile, ornament_hero_model)) {
+        bool instnodrop	= instnodrop_value ? true : false;
 
         const Item_Struct* item = GetItem(item_id);
 
@@ -533,8 +554,7 @@ bool SharedDatabase::GetInventory(uint32 char_id, Inventory* inv) {
 		if (inst == nullptr)
 			continue;
 
-        if(row[11]) {
-            std::string data_str(row[11]);
+        if(!data_str.empty()) {
             std::string idAsString;
             std::string value;
             bool use_id = true;
@@ -604,6 +624,11 @@ bool SharedDatabase::GetInventory(uint32 char_id, Inventory* inv) {
         }
     }
 
+    if (stmt->GetErrorNumber() != 0) {
+        LogFile->write(EQEmuLog::Error, "GetInventory query '%s' %s", stmt->GetQuery().c_str(), stmt->GetError().c_str());
+        return false;
+    }
+
     // Retrieve shared inventory
 	return GetSharedBank(char_id, inv, true);
 }
@@ -738,14 +763,17 @@ void SharedDatabase::GetItemsCount(int32 &item_count, uint32 &max_id) {
 }
 
 bool SharedDatabase::LoadItems() {
-	if(items_mmf) {
-		return true;
-	}
+	EQEmu::MemoryMappedFile *mmf = nullptr;
+	EQEmu::FixedMemoryHashSet<Item_Struct> *hash = nullptr;
 
 	try {
 		EQEmu::IPCMutex mutex("items");
 		mutex.Lock();
-		items_mmf = new EQEmu::MemoryMappedFile("shared/items");
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("items");
+		if(items_mmf && generation == items_generation) {
+			return true;
+		}
+		mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/items", generation));
 
 		int32 items = -1;
 		uint32 max_item = 0;
@@ -754,13 +782,21 @@ bool SharedDatabase::LoadItems() {
 			EQ_EXCEPT("SharedDatabase", "Database returned no result");
 		}
 		uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<Item_Struct>::estimated_size(items, max_item));
-		if(items_mmf->Size() != size) {
+		if(mmf->Size() != size) {
 			EQ_EXCEPT("SharedDatabase", "Couldn't load items because items_mmf->Size() != size");
 		}
 
-		items_hash = new EQEmu::FixedMemoryHashSet<Item_Struct>(reinterpret_cast<uint8*>(items_mmf->Get()), size);
+		hash = new EQEmu::FixedMemoryHashSet<Item_Struct>(reinterpret_cast<uint8*>(mmf->Get()), size);
 		mutex.Unlock();
+
+		RetireSharedMemory(items_mmf);
+		safe_delete(items_hash);
+		items_mmf = mmf;
+		items_hash = hash;
+		items_generation = generation;
 	} catch(std::exception& ex) {
+		safe_delete(hash);
+		safe_delete(mmf);
 		LogFile->write(EQEmuLog::Error, "Error Loading Items: %s", ex.what());
 		return false;
 	}
@@ -768,7 +804,7 @@ bool SharedDatabase::LoadItems() {
 	return true;
 }
 
-void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id) {
+bool SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id) {
 	EQEmu::FixedMemoryHashSet<Item_Struct> hash(reinterpret_cast<uint8*>(data), size, items, max_item_id);
 
 	char ndbuffer[4];
@@ -804,10 +840,10 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
 #include "item_fieldlist.h"
 #undef F
 		"updated FROM items ORDER BY id";
-	auto results = QueryDatabase(query);
+	auto results = QueryDatabaseUnbuffered(query);
     if (!results.Success()) {
         LogFile->write(EQEmuLog::Error, "LoadItems '%s', %s", query.c_str(), results.ErrorMessage().c_str());
-        return;
+        return false;
     }
 
     for(auto row = results.begin(); row != results.end(); ++row) {
@@ -1020,10 +1056,17 @@ void SharedDatabase::LoadItems(void *data, uint32 size, int32 items, uint32 max_
             hash.insert(item.ID, item);
         } catch(std::exception &ex) {
             LogFile->write(EQEmuLog::Error, "Database::LoadItems: %s", ex.what());
-            break;
+            return false;
         }
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadItems stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
+	return true;
 }
 
 const Item_Struct* SharedDatabase::GetItem(uint32 id) {
@@ -1123,7 +1166,7 @@ const NPCFactionList* SharedDatabase::GetNPCFactionEntry(uint32 id) {
 	return nullptr;
 }
 
-void SharedDatabase::LoadNPCFactionLists(void *data, uint32 size, uint32 list_count, uint32 max_lists) {
+bool SharedDatabase::LoadNPCFactionLists(void *data, uint32 size, uint32 list_count, uint32 max_lists) {
 	EQEmu::FixedMemoryHashSet<NPCFactionList> hash(reinterpret_cast<uint8*>(data), size, list_count, max_lists);
 	NPCFactionList faction;
 
@@ -1131,10 +1174,10 @@ void SharedDatabase::LoadNPCFactionLists(void *data, uint32 size, uint32 list_co
                             "npc_faction_entries.faction_id, npc_faction_entries.value, npc_faction_entries.npc_value, "
                             "npc_faction_entries.temp FROM npc_faction LEFT JOIN npc_faction_entries "
                             "ON npc_faction.id = npc_faction_entries.npc_faction_id ORDER BY npc_faction.id;";
-    auto results = QueryDatabase(query);
+    auto results = QueryDatabaseUnbuffered(query);
     if (!results.Success()) {
 		LogFile->write(EQEmuLog::Error, "Error getting npc faction info from database: %s, %s", query.c_str(), results.ErrorMessage().c_str());
-		return;
+		return false;
     }
 
     uint32 current_id = 0;
@@ -1168,20 +1211,30 @@ void SharedDatabase::LoadNPCFactionLists(void *data, uint32 size, uint32 list_co
         ++current_entry;
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadNPCFactionLists stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
     if(current_id != 0)
         hash.insert(current_id, faction);
 
+	return true;
 }
 
 bool SharedDatabase::LoadNPCFactionLists() {
-	if(faction_hash) {
-		return true;
-	}
+	EQEmu::MemoryMappedFile *mmf = nullptr;
+	EQEmu::FixedMemoryHashSet<NPCFactionList> *hash = nullptr;
 
 	try {
 		EQEmu::IPCMutex mutex("faction");
 		mutex.Lock();
-		faction_mmf = new EQEmu::MemoryMappedFile("shared/faction");
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("faction");
+		if(faction_hash && generation == faction_generation) {
+			return true;
+		}
+		mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/faction", generation));
 
 		uint32 list_count = 0;
 		uint32 max_lists = 0;
@@ -1192,13 +1245,21 @@ bool SharedDatabase::LoadNPCFactionLists() {
 		uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<NPCFactionList>::estimated_size(
 			list_count, max_lists));
 
-		if(faction_mmf->Size() != size) {
+		if(mmf->Size() != size) {
 			EQ_EXCEPT("SharedDatabase", "Couldn't load npc factions because faction_mmf->Size() != size");
 		}
 
-		faction_hash = new EQEmu::FixedMemoryHashSet<NPCFactionList>(reinterpret_cast<uint8*>(faction_mmf->Get()), size);
+		hash = new EQEmu::FixedMemoryHashSet<NPCFactionList>(reinterpret_cast<uint8*>(mmf->Get()), size);
 		mutex.Unlock();
+
+		RetireSharedMemory(faction_mmf);
+		safe_delete(faction_hash);
+		faction_mmf = mmf;
+		faction_hash = hash;
+		faction_generation = generation;
 	} catch(std::exception& ex) {
+		safe_delete(hash);
+		safe_delete(mmf);
 		LogFile->write(EQEmuLog::Error, "Error Loading npc factions: %s", ex.what());
 		return false;
 	}
@@ -1327,8 +1388,7 @@ bool SharedDatabase::GetCommandSettings(std::map<std::string,uint8> &commands) {
 }
 
 bool SharedDatabase::LoadSkillCaps() {
-	if(skill_caps_mmf)
-		return true;
+	EQEmu::MemoryMappedFile *mmf = nullptr;
 
 	uint32 class_count = PLAYER_CLASS_COUNT;
 	uint32 skill_count = HIGHEST_SKILL + 1;
@@ -1338,13 +1398,22 @@ bool SharedDatabase::LoadSkillCaps() {
 	try {
 		EQEmu::IPCMutex mutex("skill_caps");
 		mutex.Lock();
-		skill_caps_mmf = new EQEmu::MemoryMappedFile("shared/skill_caps");
-		if(skill_caps_mmf->Size() != size) {
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("skill_caps");
+		if(skill_caps_mmf && generation == skill_caps_generation)
+			return true;
+
+		mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/skill_caps", generation));
+		if(mmf->Size() != size) {
 			EQ_EXCEPT("SharedDatabase", "Unable to load skill caps: skill_caps_mmf->Size() != size");
 		}
 
 		mutex.Unlock();
+
+		RetireSharedMemory(skill_caps_mmf);
+		skill_caps_mmf = mmf;
+		skill_caps_generation = generation;
 	} catch(std::exception &ex) {
+		safe_delete(mmf);
 		LogFile->write(EQEmuLog::Error, "Error loading skill caps: %s", ex.what());
 		return false;
 	}
@@ -1352,17 +1421,17 @@ bool SharedDatabase::LoadSkillCaps() {
 	return true;
 }
 
-void SharedDatabase::LoadSkillCaps(void *data) {
+bool SharedDatabase::LoadSkillCaps(void *data) {
 	uint32 class_count = PLAYER_CLASS_COUNT;
 	uint32 skill_count = HIGHEST_SKILL + 1;
 	uint32 level_count = HARD_LEVEL_CAP + 1;
 	uint16 *skill_caps_table = reinterpret_cast<uint16*>(data);
 
 	const std::string query = "SELECT skillID, class, level, cap FROM skill_caps ORDER BY skillID, class, level";
-	auto results = QueryDatabase(query);
+	auto results = QueryDatabaseUnbuffered(query);
 	if (!results.Success()) {
         LogFile->write(EQEmuLog::Error, "Error loading skill caps from database: %s", results.ErrorMessage().c_str());
-        return;
+        return false;
 	}
 
     for(auto row = results.begin(); row != results.end(); ++row) {
@@ -1377,6 +1446,14 @@ void SharedDatabase::LoadSkillCaps(void *data) {
         uint32 index = (((class_ * skill_count) + skillID) * level_count) + level;
         skill_caps_table[index] = cap;
     }
+
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadSkillCaps stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
+	return true;
 }
 
 uint16 SharedDatabase::GetSkillCap(uint8 Class_, SkillUseTypes Skill, uint8 Level) {
@@ -1492,19 +1569,19 @@ int SharedDatabase::GetMaxSpellID() {
 	return atoi(row[0]);
 }
 
-void SharedDatabase::LoadSpells(void *data, int max_spells) {
+bool SharedDatabase::LoadSpells(void *data, int max_spells) {
 	SPDat_Spell_Struct *sp = reinterpret_cast<SPDat_Spell_Struct*>(data);
 
 	const std::string query = "SELECT * FROM spells_new ORDER BY id ASC";
-    auto results = QueryDatabase(query);
+    auto results = QueryDatabaseUnbuffered(query);
     if (!results.Success()) {
         _log(SPELLS__LOAD_ERR, "Error in LoadSpells query '%s' %s", query.c_str(), results.ErrorMessage().c_str());
-        return;
+        return false;
     }
 
     if(results.ColumnCount() <= SPELL_LOAD_FIELD_COUNT) {
 		_log(SPELLS__LOAD_ERR, "Fatal error loading spells: Spell field count < SPELL_LOAD_FIELD_COUNT(%u)", SPELL_LOAD_FIELD_COUNT);
-		return;
+		return false;
     }
 
     int tempid = 0;
@@ -1652,7 +1729,19 @@ void SharedDatabase::LoadSpells(void *data, int max_spells) {
 		sp[tempid].DamageShieldType = 0;
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadSpells stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
     LoadDamageShieldTypes(sp, max_spells);
+
+	SpellHotTable hot;
+	MapSpellHotTable(data, max_spells, hot);
+	BuildSpellHotTable(sp, max_spells, hot);
+
+	return true;
 }
 
 int SharedDatabase::GetMaxBaseDataLevel() {
@@ -1672,26 +1761,33 @@ int SharedDatabase::GetMaxBaseDataLevel() {
 }
 
 bool SharedDatabase::LoadBaseData() {
-	if(base_data_mmf) {
-		return true;
-	}
+	EQEmu::MemoryMappedFile *mmf = nullptr;
 
 	try {
 		EQEmu::IPCMutex mutex("base_data");
 		mutex.Lock();
-		base_data_mmf = new EQEmu::MemoryMappedFile("shared/base_data");
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("base_data");
+		if(base_data_mmf && generation == base_data_generation) {
+			return true;
+		}
+		mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/base_data", generation));
 
 		int size = 16 * (GetMaxBaseDataLevel() + 1) * sizeof(BaseDataStruct);
 		if(size == 0) {
 			EQ_EXCEPT("SharedDatabase", "Base Data size is zero");
 		}
 
-		if(base_data_mmf->Size() != size) {
+		if(mmf->Size() != size) {
 			EQ_EXCEPT("SharedDatabase", "Couldn't load base data because base_data_mmf->Size() != size");
 		}
 
 		mutex.Unlock();
+
+		RetireSharedMemory(base_data_mmf);
+		base_data_mmf = mmf;
+		base_data_generation = generation;
 	} catch(std::exception& ex) {
+		safe_delete(mmf);
 		LogFile->write(EQEmuLog::Error, "Error Loading Base Data: %s", ex.what());
 		return false;
 	}
@@ -1699,14 +1795,14 @@ bool SharedDatabase::LoadBaseData() {
 	return true;
 }
 
-void SharedDatabase::LoadBaseData(void *data, int max_level) {
+bool SharedDatabase::LoadBaseData(void *data, int max_level) {
 	char *base_ptr = reinterpret_cast<char*>(data);
 
 	const std::string query = "SELECT * FROM base_data ORDER BY level, class ASC";
-	auto results = QueryDatabase(query);
+	auto results = QueryDatabaseUnbuffered(query);
 	if (!results.Success()) {
         LogFile->write(EQEmuLog::Error, "Error in LoadBaseData query '%s' %s", query.c_str(), results.ErrorMessage().c_str());
-        return;
+        return false;
 	}
 
     int lvl = 0;
@@ -1747,6 +1843,13 @@ void SharedDatabase::LoadBaseData(void *data, int max_level) {
 		bd->endurance_factor = atof(row[9]);
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadBaseData stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
+	return true;
 }
 
 const BaseDataStruct* SharedDatabase::GetBaseData(int lvl, int cl) {
@@ -1821,7 +1924,7 @@ void SharedDatabase::GetLootDropInfo(uint32 &loot_drop_count, uint32 &max_loot_d
 	loot_drop_entries = static_cast<uint32>(atoul(row[2]));
 }
 
-void SharedDatabase::LoadLootTables(void *data, uint32 size) {
+bool SharedDatabase::LoadLootTables(void *data, uint32 size) {
 	EQEmu::FixedMemoryVariableHashSet<LootTable_Struct> hash(reinterpret_cast<uint8*>(data), size);
 
 	uint8 loot_table[sizeof(LootTable_Struct) + (sizeof(LootTableEntries_Struct) * 128)];
@@ -1831,10 +1934,10 @@ void SharedDatabase::LoadLootTables(void *data, uint32 size) {
                             "loottable_entries.lootdrop_id, loottable_entries.multiplier, loottable_entries.droplimit, "
                             "loottable_entries.mindrop, loottable_entries.probability FROM loottable LEFT JOIN loottable_entries "
                             "ON loottable.id = loottable_entries.loottable_id ORDER BY id";
-    auto results = QueryDatabase(query);
+    auto results = QueryDatabaseUnbuffered(query);
     if (!results.Success()) {
         LogFile->write(EQEmuLog::Error, "Error getting loot table info from database: %s, %s", query.c_str(), results.ErrorMessage().c_str());
-        return;
+        return false;
     }
 
     uint32 current_id = 0;
@@ -1870,12 +1973,19 @@ void SharedDatabase::LoadLootTables(void *data, uint32 size) {
         ++current_entry;
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadLootTables stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
     if(current_id != 0)
         hash.insert(current_id, loot_table, (sizeof(LootTable_Struct) + (sizeof(LootTableEntries_Struct) * lt->NumEntries)));
 
+	return true;
 }
 
-void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
+bool SharedDatabase::LoadLootDrops(void *data, uint32 size) {
 
 	EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct> hash(reinterpret_cast<uint8*>(data), size);
 	uint8 loot_drop[sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * 1260)];
@@ -1885,9 +1995,10 @@ void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
                             "lootdrop_entries.equip_item, lootdrop_entries.chance, lootdrop_entries.minlevel, "
                             "lootdrop_entries.maxlevel, lootdrop_entries.multiplier FROM lootdrop JOIN lootdrop_entries "
                             "ON lootdrop.id = lootdrop_entries.lootdrop_id ORDER BY lootdrop_id";
-    auto results = QueryDatabase(query);
+    auto results = QueryDatabaseUnbuffered(query);
     if (!results.Success()) {
         LogFile->write(EQEmuLog::Error, "Error getting loot drop info from database: %s, %s", query.c_str(), results.ErrorMessage().c_str());
+        return false;
     }
 
     uint32 current_id = 0;
@@ -1919,28 +2030,55 @@ void SharedDatabase::LoadLootDrops(void *data, uint32 size) {
         ++current_entry;
     }
 
+	std::string error;
+	if (!UnbufferedResultComplete(error)) {
+		LogFile->write(EQEmuLog::Error, "LoadLootDrops stopped before the last row: %s", error.c_str());
+		return false;
+	}
+
     if(current_id != 0)
         hash.insert(current_id, loot_drop, (sizeof(LootDrop_Struct) + (sizeof(LootDropEntries_Struct) * ld->NumEntries)));
 
+	return true;
 }
 
 bool SharedDatabase::LoadLoot() {
-	if(loot_table_mmf || loot_drop_mmf)
-		return true;
+	EQEmu::MemoryMappedFile *table_mmf = nullptr;
+	EQEmu::MemoryMappedFile *drop_mmf = nullptr;
+	EQEmu::FixedMemoryVariableHashSet<LootTable_Struct> *table_hash = nullptr;
+	EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct> *drop_hash = nullptr;
 
 	try {
 		EQEmu::IPCMutex mutex("loot");
 		mutex.Lock();
-		loot_table_mmf = new EQEmu::MemoryMappedFile("shared/loot_table");
-		loot_table_hash = new EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>(
-			reinterpret_cast<uint8*>(loot_table_mmf->Get()),
-			loot_table_mmf->Size());
-		loot_drop_mmf = new EQEmu::MemoryMappedFile("shared/loot_drop");
-		loot_drop_hash = new EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>(
-			reinterpret_cast<uint8*>(loot_drop_mmf->Get()),
-			loot_drop_mmf->Size());
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("loot");
+		if((loot_table_mmf || loot_drop_mmf) && generation == loot_generation)
+			return true;
+
+		table_mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/loot_table", generation));
+		table_hash = new EQEmu::FixedMemoryVariableHashSet<LootTable_Struct>(
+			reinterpret_cast<uint8*>(table_mmf->Get()),
+			table_mmf->Size());
+		drop_mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/loot_drop", generation));
+		drop_hash = new EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct>(
+			reinterpret_cast<uint8*>(drop_mmf->Get()),
+			drop_mmf->Size());
 		mutex.Unlock();
+
+		RetireSharedMemory(loot_table_mmf);
+		RetireSharedMemory(loot_drop_mmf);
+		safe_delete(loot_table_hash);
+		safe_delete(loot_drop_hash);
+		loot_table_mmf = table_mmf;
+		loot_drop_mmf = drop_mmf;
+		loot_table_hash = table_hash;
+		loot_drop_hash = drop_hash;
+		loot_generation = generation;
 	} catch(std::exception &ex) {
+		safe_delete(table_hash);
+		safe_delete(drop_hash);
+		safe_delete(table_mmf);
+		safe_delete(drop_mmf);
 		LogFile->write(EQEmuLog::Error, "Error loading loot: %s", ex.what());
 		return false;
 	}
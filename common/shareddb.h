@@ -11,6 +11,7 @@
 #include "fixed_memory_variable_hash_set.h"
 
 #include <list>
+#include <vector>
 
 class EvolveInfo;
 class Inventory;
@@ -85,9 +86,12 @@ class SharedDatabase : public Database
 		    Shared Memory crap
 		*/
 
+		//maps any segment this process loaded whose generation shared_memory has moved on, call between ticks
+		bool ReloadSharedMemory();
+
 		//items
 		void GetItemsCount(int32 &item_count, uint32 &max_id);
-		void LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id);
+		bool LoadItems(void *data, uint32 size, int32 items, uint32 max_item_id);
 		bool LoadItems();
 		const Item_Struct* IterateItems(uint32* id);
 		const Item_Struct* GetItem(uint32 id);
@@ -96,30 +100,30 @@ class SharedDatabase : public Database
 		//faction lists
 		void GetFactionListInfo(uint32 &list_count, uint32 &max_lists);
 		const NPCFactionList* GetNPCFactionEntry(uint32 id);
-		void LoadNPCFactionLists(void *data, uint32 size, uint32 list_count, uint32 max_lists);
+		bool LoadNPCFactionLists(void *data, uint32 size, uint32 list_count, uint32 max_lists);
 		bool LoadNPCFactionLists();
 
 		//loot
 		void GetLootTableInfo(uint32 &loot_table_count, uint32 &max_loot_table, uint32 &loot_table_entries);
 		void GetLootDropInfo(uint32 &loot_drop_count, uint32 &max_loot_drop, uint32 &loot_drop_entries);
-		void LoadLootTables(void *data, uint32 size);
-		void LoadLootDrops(void *data, uint32 size);
+		bool LoadLootTables(void *data, uint32 size);
+		bool LoadLootDrops(void *data, uint32 size);
 		bool LoadLoot();
 		const LootTable_Struct* GetLootTable(uint32 loottable_id);
 		const LootDrop_Struct* GetLootDrop(uint32 lootdrop_id);
 
-		void LoadSkillCaps(void *data);
+		bool LoadSkillCaps(void *data);
 		bool LoadSkillCaps();
 		uint16 GetSkillCap(uint8 Class_, SkillUseTypes Skill, uint8 Level);
 		uint8 GetTrainLevel(uint8 Class_, SkillUseTypes Skill, uint8 Level);
 
 		int GetMaxSpellID();
-		void LoadSpells(void *data, int max_spells);
+		bool LoadSpells(void *data, int max_spells);
 		void LoadDamageShieldTypes(SPDat_Spell_Struct* sp, int32 iMaxSpellID);
 
 		int GetMaxBaseDataLevel();
 		bool LoadBaseData();
-		void LoadBaseData(void *data, int max_level);
+		bool LoadBaseData(void *data, int max_level);
 		const BaseDataStruct* GetBaseData(int lvl, int cl);
 
 	protected:
@@ -134,6 +138,17 @@ class SharedDatabase : public Database
 		EQEmu::MemoryMappedFile *loot_drop_mmf;
 		EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct> *loot_drop_hash;
 		EQEmu::MemoryMappedFile *base_data_mmf;
+
+		//generation of each segment mapped above, see SharedMemoryGeneration
+		uint32 skill_caps_generation;
+		uint32 items_generation;
+		uint32 faction_generation;
+		uint32 loot_generation;
+		uint32 base_data_generation;
+
+		//mappings replaced by a reload, kept until exit for the pointers still held into them
+		std::vector<EQEmu::MemoryMappedFile*> retired_mmfs;
+		void RetireSharedMemory(EQEmu::MemoryMappedFile *mmf);
 };
 
 #endif /*SHAREDDB_H_*/
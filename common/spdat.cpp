@@ -86,7 +86,7 @@
 
 bool IsTargetableAESpell(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && spells[spell_id].targettype == ST_AETarget)
+	if (IsValidSpell(spell_id) && spells_hot.targettype[spell_id] == ST_AETarget)
 		return true;
 
 	return false;
@@ -111,12 +111,12 @@ bool IsLifetapSpell(uint16 spell_id)
 
 bool IsMezSpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_Mez);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Mez);
 }
 
 bool IsStunSpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_Stun);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Stun);
 }
 
 bool IsSummonSpell(uint16 spellid)
@@ -151,7 +151,7 @@ bool IsDamageSpell(uint16 spellid)
 
 bool IsFearSpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_Fear);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Fear);
 }
 
 bool IsCureSpell(uint16 spell_id)
@@ -174,31 +174,18 @@ bool IsCureSpell(uint16 spell_id)
 
 bool IsSlowSpell(uint16 spell_id)
 {
-	const SPDat_Spell_Struct &sp = spells[spell_id];
-
-	for(int i = 0; i < EFFECT_COUNT; i++)
-		if ((sp.effectid[i] == SE_AttackSpeed && sp.base[i] < 100) ||
-				(sp.effectid[i] == SE_AttackSpeed4))
-			return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Slow);
 }
 
 bool IsHasteSpell(uint16 spell_id)
 {
-	const SPDat_Spell_Struct &sp = spells[spell_id];
-
-	for(int i = 0; i < EFFECT_COUNT; i++)
-		if(sp.effectid[i] == SE_AttackSpeed)
-			return (sp.base[i] < 100);
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Haste);
 }
 
 bool IsHarmonySpell(uint16 spell_id)
 {
-	// IsEffectInSpell(spell_id, SE_Lull) - Lull is not calculated anywhere atm
-	return (IsEffectInSpell(spell_id, SE_Harmony) || IsEffectInSpell(spell_id, SE_ChangeFrenzyRad));
+	// SE_Lull is not calculated anywhere atm, see CalcSpellPropertyFlags()
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Harmony);
 }
 
 bool IsPercentalHealSpell(uint16 spell_id)
@@ -213,42 +200,7 @@ bool IsGroupOnlySpell(uint16 spell_id)
 
 bool IsBeneficialSpell(uint16 spell_id)
 {
-	if (!IsValidSpell(spell_id))
-		return false;
-
-	// You'd think just checking goodEffect flag would be enough?
-	if (spells[spell_id].goodEffect == 1) {
-		// If the target type is ST_Self or ST_Pet and is a SE_CancleMagic spell
-		// it is not Beneficial
-		SpellTargetType tt = spells[spell_id].targettype;
-		if (tt != ST_Self && tt != ST_Pet &&
-				IsEffectInSpell(spell_id, SE_CancelMagic))
-			return false;
-
-		// When our targettype is ST_Target, ST_AETarget, ST_Aniaml, ST_Undead, or ST_Pet
-		// We need to check more things!
-		if (tt == ST_Target || tt == ST_AETarget || tt == ST_Animal ||
-				tt == ST_Undead || tt == ST_Pet) {
-			uint16 sai = spells[spell_id].SpellAffectIndex;
-
-			// If the resisttype is magic and SpellAffectIndex is Calm/memblur/dispell sight
-			// it's not beneficial
-			if (spells[spell_id].resisttype == RESIST_MAGIC) {
-				if (sai == SAI_Calm || sai == SAI_Dispell_Sight ||
-						sai == SAI_Memory_Blur || sai == SAI_Calm_Song)
-					return false;
-			} else {
-				// If the resisttype is not magic and spell is Bind Sight or Cast Sight
-				// It's not beneficial
-				if (sai == SAI_Dispell_Sight && spells[spell_id].skill == 18 &&
-						!IsEffectInSpell(spell_id, SE_VoiceGraft))
-					return false;
-			}
-		}
-	}
-
-	// And finally, if goodEffect is not 0 or if it's a group spell it's beneficial
-	return spells[spell_id].goodEffect != 0 || IsGroupSpell(spell_id);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Beneficial);
 }
 
 bool IsDetrimentalSpell(uint16 spell_id)
@@ -258,7 +210,7 @@ bool IsDetrimentalSpell(uint16 spell_id)
 
 bool IsInvulnerabilitySpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_DivineAura);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Invulnerability);
 }
 
 bool IsCHDurationSpell(uint16 spell_id)
@@ -288,11 +240,7 @@ bool IsSummonSkeletonSpell(uint16 spell_id)
 
 bool IsSummonPetSpell(uint16 spell_id)
 {
-	if (IsEffectInSpell(spell_id, SE_SummonPet) ||
-			IsEffectInSpell(spell_id, SE_SummonBSTPet))
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_SummonPet);
 }
 
 bool IsSummonPCSpell(uint16 spell_id)
@@ -302,12 +250,12 @@ bool IsSummonPCSpell(uint16 spell_id)
 
 bool IsCharmSpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_Charm);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Charm);
 }
 
 bool IsBlindSpell(uint16 spell_id)
 {
-	return IsEffectInSpell(spell_id, SE_Blind);
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Blind);
 }
 
 bool IsEffectHitpointsSpell(uint16 spell_id)
@@ -424,13 +372,11 @@ bool IsResistableSpell(uint16 spell_id)
 // checks if this spell affects your group
 bool IsGroupSpell(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) &&
-			(spells[spell_id].targettype == ST_AEBard ||
-			 spells[spell_id].targettype == ST_Group ||
-			 spells[spell_id].targettype == ST_GroupTeleport))
-		return true;
+	if (!IsValidSpell(spell_id))
+		return false;
 
-	return false;
+	uint8 tt = spells_hot.targettype[spell_id];
+	return tt == ST_AEBard || tt == ST_Group || tt == ST_GroupTeleport;
 }
 
 // checks if this spell can be targeted
@@ -446,10 +392,7 @@ bool IsTGBCompatibleSpell(uint16 spell_id)
 
 bool IsBardSong(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && spells[spell_id].classes[BARD - 1] < 255)
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_BardSong);
 }
 
 bool IsEffectInSpell(uint16 spellid, int effect)
@@ -489,11 +432,8 @@ bool IsBlankSpellEffect(uint16 spellid, int effect_index)
 // checks some things about a spell id, to see if we can proceed
 bool IsValidSpell(uint32 spellid)
 {
-	if (SPDAT_RECORDS > 0 && spellid != 0 && spellid != 1 &&
-			spellid != 0xFFFFFFFF && spellid < SPDAT_RECORDS && spells[spellid].player_1[0])
-		return true;
-
-	return false;
+	// SPF_Valid covers the spellid != 0/1 and player_1[0] checks
+	return SpellHasProperties(spellid, SPF_Valid);
 }
 
 // returns the lowest level of any caster which can use the spell
@@ -993,26 +933,17 @@ bool IsSelfConversionSpell(uint16 spell_id)
 // returns true for both detrimental and beneficial buffs
 bool IsBuffSpell(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && (spells[spell_id].buffduration || spells[spell_id].buffdurationformula))
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Buff);
 }
 
 bool IsPersistDeathSpell(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && spells[spell_id].persistdeath)
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_PersistDeath);
 }
 
 bool IsSuspendableSpell(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && spells[spell_id].suspendable)
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_Suspendable);
 }
 
 uint32 GetMorphTrigger(uint32 spell_id)
@@ -1026,15 +957,7 @@ uint32 GetMorphTrigger(uint32 spell_id)
 
 bool IsCastonFadeDurationSpell(uint16 spell_id)
 {
-	for (int i = 0; i < EFFECT_COUNT; ++i) {
-		if (spells[spell_id].effectid[i] == SE_CastOnFadeEffect
-			|| spells[spell_id].effectid[i] == SE_CastOnFadeEffectNPC
-			|| spells[spell_id].effectid[i] == SE_CastOnFadeEffectAlways){
-
-		return true;
-		}
-	}
-	return false;
+	return SpellHasProperties(spell_id, SPF_CastOnFade);
 }
 
 bool IsPowerDistModSpell(uint16 spell_id)
@@ -1121,10 +1044,7 @@ int32 GetFuriousBash(uint16 spell_id)
 
 bool IsShortDurationBuff(uint16 spell_id)
 {
-	if (IsValidSpell(spell_id) && spells[spell_id].short_buff_box != 0)
-		return true;
-
-	return false;
+	return SpellHasProperties(spell_id, SPF_Valid | SPF_ShortDurationBuff);
 }
 
 bool IsSpellUsableThisZoneType(uint16 spell_id, uint8 zone_type)
@@ -761,9 +761,60 @@ struct SPDat_Spell_Struct
 			uint8 DamageShieldType; // This field does not exist in spells_us.txt
 };
 
+// Properties derived from a spell's effect list, computed once when the
+// shared spells segment is built so hot predicates don't rescan effectid[].
+enum SpellPropertyFlags
+{
+	SPF_Valid				= (1 << 0),	// passes IsValidSpell's data checks
+	SPF_Beneficial			= (1 << 1),
+	SPF_Buff				= (1 << 2),
+	SPF_ShortDurationBuff	= (1 << 3),
+	SPF_Suspendable			= (1 << 4),
+	SPF_PersistDeath		= (1 << 5),
+	SPF_BardSong			= (1 << 6),
+	SPF_Mez					= (1 << 7),
+	SPF_Stun				= (1 << 8),
+	SPF_Fear				= (1 << 9),
+	SPF_Charm				= (1 << 10),
+	SPF_Blind				= (1 << 11),
+	SPF_Slow				= (1 << 12),
+	SPF_Haste				= (1 << 13),
+	SPF_Harmony				= (1 << 14),
+	SPF_Invulnerability		= (1 << 15),
+	SPF_SummonPet			= (1 << 16),
+	SPF_CastOnFade			= (1 << 17)
+};
+
+// Struct-of-arrays copy of the spell fields read per buff per tick and per
+// AI spell scan. The arrays live directly after the SPDat_Spell_Struct array
+// in the shared spells segment; see MapSpellHotTable().
+struct SpellHotTable
+{
+	uint32 *flags;
+	float *range;
+	float *aoerange;
+	uint32 *buffdurationformula;
+	uint32 *buffduration;
+	uint16 *mana;
+	uint8 *targettype;
+};
+
 extern const SPDat_Spell_Struct* spells;
+extern SpellHotTable spells_hot;
 extern int32 SPDAT_RECORDS;
 
+uint32 GetSpellsSegmentSize(int32 records);
+void MapSpellHotTable(void *segment, int32 records, SpellHotTable &table);
+void BuildSpellHotTable(const SPDat_Spell_Struct *sp, int32 records, SpellHotTable &table);
+uint32 CalcSpellPropertyFlags(const SPDat_Spell_Struct &sp);
+
+// true if every bit in properties is set for this spell; a single load from spells_hot.flags
+inline bool SpellHasProperties(uint32 spell_id, uint32 properties)
+{
+	return SPDAT_RECORDS > 0 && spell_id < static_cast<uint32>(SPDAT_RECORDS) &&
+		(spells_hot.flags[spell_id] & properties) == properties;
+}
+
 bool IsTargetableAESpell(uint16 spell_id);
 bool IsSacrificeSpell(uint16 spell_id);
 bool IsLifetapSpell(uint16 spell_id);
@@ -0,0 +1,184 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+// Builds the SpellHotTable stored in the shared spells segment. Kept apart
+// from spdat.cpp so shared_memory can link it without the spells globals.
+
+#include "classes.h"
+#include "spdat.h"
+
+static bool SpellDataHasEffect(const SPDat_Spell_Struct &sp, int effect)
+{
+	for (int i = 0; i < EFFECT_COUNT; ++i)
+		if (sp.effectid[i] == effect)
+			return true;
+
+	return false;
+}
+
+// same rules IsBeneficialSpell() used to apply against spells[spell_id]
+static bool IsBeneficialSpellData(const SPDat_Spell_Struct &sp)
+{
+	SpellTargetType tt = sp.targettype;
+
+	// You'd think just checking goodEffect flag would be enough?
+	if (sp.goodEffect == 1) {
+		// If the target type is ST_Self or ST_Pet and is a SE_CancleMagic spell
+		// it is not Beneficial
+		if (tt != ST_Self && tt != ST_Pet && SpellDataHasEffect(sp, SE_CancelMagic))
+			return false;
+
+		// When our targettype is ST_Target, ST_AETarget, ST_Aniaml, ST_Undead, or ST_Pet
+		// We need to check more things!
+		if (tt == ST_Target || tt == ST_AETarget || tt == ST_Animal ||
+				tt == ST_Undead || tt == ST_Pet) {
+			uint16 sai = sp.SpellAffectIndex;
+
+			// If the resisttype is magic and SpellAffectIndex is Calm/memblur/dispell sight
+			// it's not beneficial
+			if (sp.resisttype == RESIST_MAGIC) {
+				if (sai == SAI_Calm || sai == SAI_Dispell_Sight ||
+						sai == SAI_Memory_Blur || sai == SAI_Calm_Song)
+					return false;
+			} else {
+				// If the resisttype is not magic and spell is Bind Sight or Cast Sight
+				// It's not beneficial
+				if (sai == SAI_Dispell_Sight && sp.skill == 18 &&
+						!SpellDataHasEffect(sp, SE_VoiceGraft))
+					return false;
+			}
+		}
+	}
+
+	// And finally, if goodEffect is not 0 or if it's a group spell it's beneficial
+	return sp.goodEffect != 0 || tt == ST_AEBard || tt == ST_Group || tt == ST_GroupTeleport;
+}
+
+uint32 CalcSpellPropertyFlags(const SPDat_Spell_Struct &sp)
+{
+	uint32 flags = 0;
+
+	if (sp.id != 0 && sp.id != 1 && sp.player_1[0])
+		flags |= SPF_Valid;
+	if (IsBeneficialSpellData(sp))
+		flags |= SPF_Beneficial;
+	if (sp.buffduration || sp.buffdurationformula)
+		flags |= SPF_Buff;
+	if (sp.short_buff_box != 0)
+		flags |= SPF_ShortDurationBuff;
+	if (sp.suspendable)
+		flags |= SPF_Suspendable;
+	if (sp.persistdeath)
+		flags |= SPF_PersistDeath;
+	if (sp.classes[BARD - 1] < 255)
+		flags |= SPF_BardSong;
+
+	bool seen_attack_speed = false;
+	for (int i = 0; i < EFFECT_COUNT; ++i) {
+		switch (sp.effectid[i]) {
+		case SE_Mez:
+			flags |= SPF_Mez;
+			break;
+		case SE_Stun:
+			flags |= SPF_Stun;
+			break;
+		case SE_Fear:
+			flags |= SPF_Fear;
+			break;
+		case SE_Charm:
+			flags |= SPF_Charm;
+			break;
+		case SE_Blind:
+			flags |= SPF_Blind;
+			break;
+		case SE_AttackSpeed:
+			if (sp.base[i] < 100) {
+				flags |= SPF_Slow;
+				// haste is decided by the first SE_AttackSpeed slot only
+				if (!seen_attack_speed)
+					flags |= SPF_Haste;
+			}
+			seen_attack_speed = true;
+			break;
+		case SE_AttackSpeed4:
+			flags |= SPF_Slow;
+			break;
+		// SE_Lull - Lull is not calculated anywhere atm
+		case SE_Harmony:
+		case SE_ChangeFrenzyRad:
+			flags |= SPF_Harmony;
+			break;
+		case SE_DivineAura:
+			flags |= SPF_Invulnerability;
+			break;
+		case SE_SummonPet:
+		case SE_SummonBSTPet:
+			flags |= SPF_SummonPet;
+			break;
+		case SE_CastOnFadeEffect:
+		case SE_CastOnFadeEffectNPC:
+		case SE_CastOnFadeEffectAlways:
+			flags |= SPF_CastOnFade;
+			break;
+		default:
+			break;
+		}
+	}
+
+	return flags;
+}
+
+// the spells segment is the SPDat_Spell_Struct array followed by each
+// SpellHotTable column, widest type first so no padding is needed
+uint32 GetSpellsSegmentSize(int32 records)
+{
+	return records * (sizeof(SPDat_Spell_Struct) + sizeof(uint32) + sizeof(float) + sizeof(float) +
+		sizeof(uint32) + sizeof(uint32) + sizeof(uint16) + sizeof(uint8));
+}
+
+void MapSpellHotTable(void *segment, int32 records, SpellHotTable &table)
+{
+	char *ptr = reinterpret_cast<char*>(segment) + records * sizeof(SPDat_Spell_Struct);
+
+	table.flags = reinterpret_cast<uint32*>(ptr);
+	ptr += records * sizeof(uint32);
+	table.range = reinterpret_cast<float*>(ptr);
+	ptr += records * sizeof(float);
+	table.aoerange = reinterpret_cast<float*>(ptr);
+	ptr += records * sizeof(float);
+	table.buffdurationformula = reinterpret_cast<uint32*>(ptr);
+	ptr += records * sizeof(uint32);
+	table.buffduration = reinterpret_cast<uint32*>(ptr);
+	ptr += records * sizeof(uint32);
+	table.mana = reinterpret_cast<uint16*>(ptr);
+	ptr += records * sizeof(uint16);
+	table.targettype = reinterpret_cast<uint8*>(ptr);
+}
+
+void BuildSpellHotTable(const SPDat_Spell_Struct *sp, int32 records, SpellHotTable &table)
+{
+	for (int32 i = 0; i < records; ++i) {
+		table.flags[i] = CalcSpellPropertyFlags(sp[i]);
+		table.range[i] = sp[i].range;
+		table.aoerange[i] = sp[i].aoerange;
+		table.buffdurationformula[i] = sp[i].buffdurationformula;
+		table.buffduration[i] = sp[i].buffduration;
+		table.mana[i] = sp[i].mana;
+		table.targettype[i] = static_cast<uint8>(sp[i].targettype);
+	}
+}
@@ -0,0 +1,130 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "wake_event.h"
+#ifdef _WINDOWS
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#ifdef __linux__
+#include <sys/eventfd.h>
+#endif
+#endif
+#include "eqemu_exception.h"
+
+namespace EQEmu {
+	struct WakeEvent::Implementation {
+#ifdef _WINDOWS
+		HANDLE event_;
+#else
+		int read_fd_;
+		int write_fd_;
+#endif
+	};
+
+	WakeEvent::WakeEvent() : pending_(false) {
+		imp_ = new Implementation;
+#ifdef _WINDOWS
+		imp_->event_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+		if(!imp_->event_) {
+			EQ_EXCEPT("Wake Event", "Could not create event.");
+		}
+#elif defined(__linux__)
+		imp_->read_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if(imp_->read_fd_ == -1) {
+			EQ_EXCEPT("Wake Event", "Could not create eventfd.");
+		}
+		imp_->write_fd_ = imp_->read_fd_;
+#else
+		int fds[2];
+		if(pipe(fds) == -1) {
+			EQ_EXCEPT("Wake Event", "Could not create pipe.");
+		}
+		for(int i = 0; i < 2; ++i) {
+			fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+			fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+		}
+		imp_->read_fd_ = fds[0];
+		imp_->write_fd_ = fds[1];
+#endif
+	}
+
+	WakeEvent::~WakeEvent() {
+#ifdef _WINDOWS
+		CloseHandle(imp_->event_);
+#else
+		if(imp_->write_fd_ != imp_->read_fd_)
+			close(imp_->write_fd_);
+		close(imp_->read_fd_);
+#endif
+		delete imp_;
+	}
+
+	void WakeEvent::Signal() {
+		if(pending_.exchange(true))
+			return;
+
+		Raise();
+	}
+
+	void WakeEvent::Raise() {
+#ifdef _WINDOWS
+		SetEvent(imp_->event_);
+#elif defined(__linux__)
+		uint64 one = 1;
+		ssize_t r = write(imp_->write_fd_, &one, sizeof(one));
+		(void)r;
+#else
+		char one = 1;
+		ssize_t r = write(imp_->write_fd_, &one, sizeof(one));
+		(void)r;
+#endif
+	}
+
+	bool WakeEvent::Wait(uint32 timeout_ms) {
+#ifdef _WINDOWS
+		bool woken = WaitForSingleObject(imp_->event_, timeout_ms) == WAIT_OBJECT_0;
+#else
+		pollfd pfd;
+		pfd.fd = imp_->read_fd_;
+		pfd.events = POLLIN;
+		pfd.revents = 0;
+
+		int r = poll(&pfd, 1, (int)timeout_ms);
+		bool woken = r > 0 && (pfd.revents & POLLIN);
+
+		//cleared before draining so a Signal() from here on writes again instead of being coalesced into this wakeup
+		pending_.store(false);
+		if(woken) {
+			char drain[64];
+			while(read(imp_->read_fd_, drain, sizeof(drain)) > 0) { }
+
+			//a Signal() that landed during the drain may have had its write eaten, put it back for the next Wait()
+			if(pending_.load())
+				Raise();
+		}
+#endif
+#ifdef _WINDOWS
+		pending_.store(false);
+#endif
+		return woken;
+	}
+}
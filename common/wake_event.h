@@ -0,0 +1,66 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef _EQEMU_WAKE_EVENT_H
+#define _EQEMU_WAKE_EVENT_H
+
+#include "types.h"
+#include <atomic>
+
+namespace EQEmu {
+
+	//! Cross-thread wakeup for a main loop
+	/*!
+		Lets a main loop sleep until its next timer is due while still waking up as soon as one of the network
+		threads hands it work. Backed by an eventfd on Linux, a pipe on other unix platforms and an auto-reset
+		event on windows. Signals that arrive while nobody is waiting are coalesced into a single wakeup.
+	*/
+	class WakeEvent {
+		struct Implementation;
+	public:
+		//! Constructor
+		WakeEvent();
+
+		//! Destructor
+		~WakeEvent();
+
+		//! Wakes the thread blocked in Wait(), or makes the next Wait() return immediately
+		/*!
+			Safe to call from any thread; only the first call between two Wait()s touches the kernel.
+		*/
+		void Signal();
+
+		//! Blocks until Signal() is called or the timeout expires
+		/*!
+		\param timeout_ms How long to wait in milliseconds, 0 just polls.
+		\return True if woken by Signal(), false on timeout.
+		*/
+		bool Wait(uint32 timeout_ms);
+	private:
+		WakeEvent(const WakeEvent&);
+		const WakeEvent& operator=(const WakeEvent&);
+
+		//! Makes the kernel object signalled
+		void Raise();
+
+		std::atomic<bool> pending_; //!< Whether a signal has been raised since the last Wait()
+		Implementation *imp_;
+	};
+}
+
+#endif
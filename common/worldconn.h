@@ -44,6 +44,7 @@ public:
 	void	AsyncConnect();
 	void	Disconnect();
 	inline bool		TryReconnect() const { return pTryReconnect; }
+	void	SetWakeEvent(EQEmu::WakeEvent *ev) { tcpc.SetWakeEvent(ev); }
 
 protected:
 	virtual void OnConnected();
@@ -24,6 +24,7 @@
 #include "../common/crash.h"
 #include "worldserver.h"
 #include "zone_launch.h"
+#include "zone_host_launch.h"
 #include <vector>
 #include <map>
 #include <set>
@@ -85,6 +86,16 @@ int main(int argc, char *argv[]) {
 	}
 	#endif
 
+	ZoneHostLaunch *host = nullptr;
+	if(Config->ZoneHostEnabled) {
+#ifdef WIN32
+		_log(LAUNCHER__ERROR, "Zone hosting needs fork(), starting a process for each zone instead.");
+#else
+		host = new ZoneHostLaunch(launcher_name.c_str(), Config);
+		ZoneLaunch::SetHost(host);
+#endif
+	}
+
 	std::map<std::string, ZoneLaunch *> zones;
 	WorldServer world(zones, launcher_name.c_str(), Config);
 	if (!world.Connect()) {
@@ -115,6 +126,8 @@ int main(int argc, char *argv[]) {
 		* Let the process manager look for dead children
 		*/
 		launch->Process();
+		if(host != nullptr)
+			host->Process();
 
 		/*
 		* Give all zones a chance to process.
@@ -164,6 +177,8 @@ int main(int argc, char *argv[]) {
 	}
 	Sleep(1);
 	launch->Process();
+	if(host != nullptr)
+		host->Process();
 	launch->TerminateAll(false);
 	Sleep(1);
 	launch->Process();
@@ -172,6 +187,7 @@ int main(int argc, char *argv[]) {
 	for(; zone != zend; ++zone) {
 		delete zone->second;
 	}
+	safe_delete(host);
 
 	return 0;
 }
@@ -0,0 +1,235 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/debug.h"
+#include "../common/eqemu_config.h"
+#include "zone_host_launch.h"
+
+#ifndef WIN32
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <fcntl.h>
+	#include <poll.h>
+	#include <signal.h>
+	#include <unistd.h>
+	#include <errno.h>
+	#include <string.h>
+	#include <stdlib.h>
+#endif
+
+static const int ZONE_HOST_REPLY_WAIT = 10000;	//milliseconds to wait for the host to answer a launch
+
+ZoneHostLaunch::ZoneHostLaunch(const char *launcher_name, const EQEmuConfig *config)
+: m_launcherName(launcher_name),
+	m_config(config),
+	m_timer(config->RestartWait),
+	m_ref(ProcLauncher::ProcError),
+	m_fd(-1),
+	m_ready(false)
+{
+	//start the host on the first Process()
+	m_timer.Trigger();
+}
+
+ZoneHostLaunch::~ZoneHostLaunch() {
+#ifndef WIN32
+	if(m_fd != -1)
+		close(m_fd);
+#endif
+}
+
+void ZoneHostLaunch::Start() {
+#ifdef WIN32
+	_log(LAUNCHER__ERROR, "Zone hosting needs fork(), which this platform does not have.");
+#else
+	int fds[2];
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1) {
+		_log(LAUNCHER__ERROR, "Unable to create the zone host socket: %s", strerror(errno));
+		m_timer.Start(m_config->RestartWait);
+		return;
+	}
+	//our end stays out of every process we start, theirs is inherited by the host only
+	fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+
+	char fd_arg[16];
+	snprintf(fd_arg, sizeof(fd_arg), "%d", fds[1]);
+
+	ProcLauncher::Spec *spec = new ProcLauncher::Spec();
+	spec->program = m_config->ZoneExe;
+	spec->args.push_back("--host");
+	spec->args.push_back(fd_arg);
+	spec->args.push_back(m_launcherName);
+	spec->handler = this;
+	spec->logFile = m_config->LogPrefix + "host" + m_config->LogSuffix;
+
+	//spec is consumed, even on failure
+	m_ref = ProcLauncher::get()->Launch(spec);
+	close(fds[1]);
+	if(m_ref == ProcLauncher::ProcError) {
+		_log(LAUNCHER__ERROR, "Failure to launch '%s --host %s %s'. ", m_config->ZoneExe.c_str(), fd_arg, m_launcherName);
+		close(fds[0]);
+		m_timer.Start(m_config->RestartWait);
+		return;
+	}
+
+	m_fd = fds[0];
+	m_buffer.clear();
+	_log(LAUNCHER__STATUS, "Zone host has been started, zones will launch once it has loaded.");
+#endif
+}
+
+void ZoneHostLaunch::Process() {
+	if(m_ref == ProcLauncher::ProcError) {
+		if(m_timer.Check(false)) {
+			m_timer.Disable();
+			Start();
+		}
+		return;
+	}
+
+	std::string line;
+	while(ReadLine(line, 0))
+		HandleLine(line);
+}
+
+bool ZoneHostLaunch::ReadLine(std::string &line, int wait) {
+#ifdef WIN32
+	return(false);
+#else
+	while(true) {
+		size_t eol = m_buffer.find('\n');
+		if(eol != std::string::npos) {
+			line = m_buffer.substr(0, eol);
+			m_buffer.erase(0, eol + 1);
+			return(true);
+		}
+
+		if(m_fd == -1)
+			return(false);
+
+		struct pollfd p;
+		p.fd = m_fd;
+		p.events = POLLIN;
+		p.revents = 0;
+		int res = poll(&p, 1, wait);
+		if(res == -1 && errno == EINTR)
+			continue;
+		if(res <= 0)
+			return(false);
+
+		char chunk[512];
+		ssize_t len = read(m_fd, chunk, sizeof(chunk));
+		if(len == -1 && errno == EINTR)
+			continue;
+		if(len <= 0) {
+			//the host is going down, its zones are reported when ProcLauncher sees it exit
+			_log(LAUNCHER__ERROR, "Lost the connection to the zone host.");
+			close(m_fd);
+			m_fd = -1;
+			m_ready = false;
+			return(false);
+		}
+		m_buffer.append(chunk, len);
+	}
+#endif
+}
+
+void ZoneHostLaunch::HandleLine(const std::string &line) {
+	if(line == "ready") {
+		_log(LAUNCHER__STATUS, "Zone host has finished loading.");
+		m_ready = true;
+	} else if(line.compare(0, 7, "exited ") == 0) {
+		ProcLauncher::ProcRef ref = atoi(line.c_str() + 7);
+		std::map<ProcLauncher::ProcRef, ProcLauncher::EventHandler *>::iterator res = m_running.find(ref);
+		if(res == m_running.end())
+			return;
+		ProcLauncher::EventHandler *handler = res->second;
+		m_running.erase(res);
+		handler->OnTerminate(ref, nullptr);
+	} else {
+		_log(LAUNCHER__ERROR, "Unexpected message from the zone host: '%s'", line.c_str());
+	}
+}
+
+ProcLauncher::ProcRef ZoneHostLaunch::Launch(const std::string &zone_name, const std::string &log_file, ProcLauncher::EventHandler *handler) {
+#ifdef WIN32
+	return(ProcLauncher::ProcError);
+#else
+	if(!m_ready || m_fd == -1)
+		return(ProcLauncher::ProcError);
+
+	std::string request = "start " + zone_name + " " + log_file + "\n";
+	if(write(m_fd, request.c_str(), request.length()) != (ssize_t)request.length()) {
+		_log(LAUNCHER__ERROR, "Unable to send launch of %s to the zone host: %s", zone_name.c_str(), strerror(errno));
+		return(ProcLauncher::ProcError);
+	}
+
+	//forking is quick, anything else the host says in the meantime is handled as usual
+	std::string line;
+	while(ReadLine(line, ZONE_HOST_REPLY_WAIT)) {
+		if(line.compare(0, 8, "started ") == 0) {
+			ProcLauncher::ProcRef ref = atoi(line.c_str() + 8);
+			m_running[ref] = handler;
+			return(ref);
+		}
+		if(line == "failed")
+			return(ProcLauncher::ProcError);
+		HandleLine(line);
+	}
+
+	_log(LAUNCHER__ERROR, "Zone host did not answer the launch of %s.", zone_name.c_str());
+	return(ProcLauncher::ProcError);
+#endif
+}
+
+bool ZoneHostLaunch::Terminate(const ProcLauncher::ProcRef &proc, bool graceful) {
+#ifdef WIN32
+	return(false);
+#else
+	//we are only willing to kill things the host started for us...
+	if(m_running.find(proc) == m_running.end())
+		return(false);
+
+	//the host tells us once it is gone
+	if(kill(proc, graceful ? SIGTERM : SIGKILL) == -1)
+		return(false);
+	return(true);
+#endif
+}
+
+//called when the host itself dies, its zones die with it
+void ZoneHostLaunch::OnTerminate(const ProcLauncher::ProcRef &ref, const ProcLauncher::Spec *spec) {
+	_log(LAUNCHER__STATUS, "Zone host has gone down. Restart timer started.");
+
+#ifndef WIN32
+	if(m_fd != -1)
+		close(m_fd);
+#endif
+	m_fd = -1;
+	m_ready = false;
+	m_ref = ProcLauncher::ProcError;
+	m_timer.Start(m_config->RestartWait);
+
+	std::map<ProcLauncher::ProcRef, ProcLauncher::EventHandler *> running;
+	running.swap(m_running);
+	std::map<ProcLauncher::ProcRef, ProcLauncher::EventHandler *>::iterator cur, end;
+	cur = running.begin();
+	end = running.end();
+	for(; cur != end; ++cur)
+		cur->second->OnTerminate(cur->first, nullptr);
+}
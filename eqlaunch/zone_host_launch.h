@@ -0,0 +1,63 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef ZONEHOSTLAUNCH_H_
+#define ZONEHOSTLAUNCH_H_
+
+#include "../common/proc_launcher.h"
+#include "../common/timer.h"
+#include <string>
+#include <map>
+
+class EQEmuConfig;
+
+//Keeps a zone host process (zone --host) running and starts zones by having it fork them,
+//so they skip loading what every zone shares. See zone/zone_host.h for the other end.
+class ZoneHostLaunch : protected ProcLauncher::EventHandler {
+public:
+	ZoneHostLaunch(const char *launcher_name, const EQEmuConfig *config);
+	virtual ~ZoneHostLaunch();
+
+	//restarts the host if it went down and handles what it has reported
+	void Process();
+
+	//true once the host has loaded and can fork zones
+	bool IsReady() const { return(m_ready); }
+
+	//same contract as ProcLauncher's, handler is told when the zone exits
+	ProcLauncher::ProcRef Launch(const std::string &zone_name, const std::string &log_file, ProcLauncher::EventHandler *handler);
+	bool Terminate(const ProcLauncher::ProcRef &proc, bool graceful = true);
+
+protected:
+	void Start();
+	bool ReadLine(std::string &line, int wait);
+	void HandleLine(const std::string &line);
+
+	void OnTerminate(const ProcLauncher::ProcRef &ref, const ProcLauncher::Spec *spec);
+
+	const char *const m_launcherName;
+	const EQEmuConfig *const m_config;
+
+	Timer m_timer;
+	ProcLauncher::ProcRef m_ref;
+	int m_fd;
+	bool m_ready;
+	std::string m_buffer;
+	std::map<ProcLauncher::ProcRef, ProcLauncher::EventHandler *> m_running;	//zones the host forked for us
+};
+
+#endif /*ZONEHOSTLAUNCH_H_*/
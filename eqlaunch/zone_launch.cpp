@@ -19,6 +19,7 @@
 #include "../common/debug.h"
 #include "../common/eqemu_config.h"
 #include "zone_launch.h"
+#include "zone_host_launch.h"
 #include "worldserver.h"
 
 //static const uint32 ZONE_RESTART_DELAY = 10000;
@@ -26,6 +27,7 @@
 
 int ZoneLaunch::s_running = 0;	//the number of zones running under this launcher
 Timer ZoneLaunch::s_startTimer(1);	//I do not trust this things state after static initialization
+ZoneHostLaunch *ZoneLaunch::s_host = nullptr;
 
 void ZoneLaunch::InitStartTimer() {
 	s_startTimer.Start(1);
@@ -58,18 +60,22 @@ void ZoneLaunch::SendStatus() const {
 }
 
 void ZoneLaunch::Start() {
-	ProcLauncher::Spec *spec = new ProcLauncher::Spec();
-	spec->program = m_config->ZoneExe;
-//	if(m_zone.substr(0,7) == "dynamic")
-//		spec->args.push_back(".");
-//	else
-	spec->args.push_back(m_zone);
-	spec->args.push_back(m_launcherName);
-	spec->handler = this;
-	spec->logFile = m_config->LogPrefix + m_zone + m_config->LogSuffix;
-
-	//spec is consumed, even on failure
-	m_ref = ProcLauncher::get()->Launch(spec);
+	if(s_host != nullptr) {
+		m_ref = s_host->Launch(m_zone, m_config->LogPrefix + m_zone + m_config->LogSuffix, this);
+	} else {
+		ProcLauncher::Spec *spec = new ProcLauncher::Spec();
+		spec->program = m_config->ZoneExe;
+//		if(m_zone.substr(0,7) == "dynamic")
+//			spec->args.push_back(".");
+//		else
+		spec->args.push_back(m_zone);
+		spec->args.push_back(m_launcherName);
+		spec->handler = this;
+		spec->logFile = m_config->LogPrefix + m_zone + m_config->LogSuffix;
+
+		//spec is consumed, even on failure
+		m_ref = ProcLauncher::get()->Launch(spec);
+	}
 	if(m_ref == ProcLauncher::ProcError) {
 		_log(LAUNCHER__ERROR, "Failure to launch '%s %s %s'. ", m_config->ZoneExe.c_str(), m_zone.c_str(), m_launcherName);
 		m_timer.Start(m_config->RestartWait);
@@ -86,6 +92,12 @@ void ZoneLaunch::Start() {
 	_log(LAUNCHER__STATUS, "Zone %s has been started.", m_zone.c_str());
 }
 
+bool ZoneLaunch::Terminate(bool graceful) {
+	if(s_host != nullptr)
+		return(s_host->Terminate(m_ref, graceful));
+	return(ProcLauncher::get()->Terminate(m_ref, graceful));
+}
+
 void ZoneLaunch::Restart() {
 	switch(m_state) {
 	case StateRestartPending:
@@ -99,7 +111,7 @@ void ZoneLaunch::Restart() {
 		//process is running along, kill it off..
 		if(m_ref == ProcLauncher::ProcError)
 			break;	//we have no proc ref... cannot stop..
-		if(!ProcLauncher::get()->Terminate(m_ref, true)) {
+		if(!Terminate(true)) {
 			//failed to terminate the process, its not likely that it will work if we try again, so give up.
 			_log(LAUNCHER__ERROR, "Failed to terminate zone %s. Giving up and moving to stopped.", m_zone.c_str());
 			m_state = StateStopped;
@@ -131,7 +143,7 @@ void ZoneLaunch::Stop(bool graceful) {
 	case StateStopPending:
 		if(m_ref == ProcLauncher::ProcError)
 			break;	//we have no proc ref... cannot stop..
-		if(!ProcLauncher::get()->Terminate(m_ref, graceful)) {
+		if(!Terminate(graceful)) {
 			//failed to terminate the process, its not likely that it will work if we try again, so give up.
 			_log(LAUNCHER__ERROR, "Failed to terminate zone %s. Giving up and moving to stopped.", m_zone.c_str());
 			m_state = StateStopped;
@@ -151,6 +163,9 @@ void ZoneLaunch::Stop(bool graceful) {
 bool ZoneLaunch::Process() {
 	switch(m_state) {
 	case StateStartPending:
+		//a host that is still loading would only make us start the zone the slow way
+		if(s_host != nullptr && !s_host->IsReady())
+			break;
 		if(m_timer.Check(false)) {
 			//our internal timer says its time to start. Check with the shared timer.
 			if(!s_startTimer.Check(false)) {
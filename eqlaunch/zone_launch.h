@@ -24,6 +24,7 @@
 
 class WorldServer;
 class EQEmuConfig;
+class ZoneHostLaunch;
 
 class ZoneLaunch : protected ProcLauncher::EventHandler {
 public:
@@ -43,11 +44,14 @@ public:
 
 	//should only be called during process init to setup the start timer.
 	static void InitStartTimer();
+	//zones are forked by host instead of started from scratch, only set during process init.
+	static void SetHost(ZoneHostLaunch *host) { s_host = host; }
 
 protected:
 	bool IsRunning() const { return(m_state == StateStarted || m_state == StateStopPending || m_state == StateRestartPending); }
 
 	void Start();
+	bool Terminate(bool graceful);
 
 	void OnTerminate(const ProcLauncher::ProcRef &ref, const ProcLauncher::Spec *spec);
 
@@ -73,6 +77,7 @@ protected:
 private:
 	static int s_running;
 	static Timer s_startTimer;
+	static ZoneHostLaunch *s_host;
 };
 
 #endif /*ZONELAUNCH_H_*/
@@ -91,6 +91,12 @@ ClientManager::~ClientManager()
 	}
 }
 
+void ClientManager::SetWakeEvent(EQEmu::WakeEvent *ev)
+{
+	titanium_stream->SetWakeEvent(ev);
+	sod_stream->SetWakeEvent(ev);
+}
+
 void ClientManager::Process()
 {
 	ProcessDisconnect();
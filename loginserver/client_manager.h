@@ -48,6 +48,11 @@ public:
 	*/
 	void Process();
 
+	/**
+	* Has both stream factories wake the main loop when client data arrives.
+	*/
+	void SetWakeEvent(EQEmu::WakeEvent *ev);
+
 	/**
 	* Sends a new server list to every client.
 	*/
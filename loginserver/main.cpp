@@ -20,6 +20,7 @@
 #include "../common/opcodemgr.h"
 #include "../common/eq_stream_factory.h"
 #include "../common/timer.h"
+#include "../common/event_loop.h"
 #include "../common/platform.h"
 #include "../common/crash.h"
 #include "login_server.h"
@@ -245,15 +246,23 @@ int main()
 #endif
 #endif
 
+	//nothing here runs on a timer, the loop only wakes for client and world traffic
+	EQEmu::EventLoop main_loop(1000);
+	server.CM->SetWakeEvent(main_loop.GetWakeEvent());
+	server.SM->SetWakeEvent(main_loop.GetWakeEvent());
+
 	server_log->Log(log_debug, "Server Started.");
 	while(run_server)
 	{
 		Timer::SetCurrentTime();
 		server.CM->Process();
 		server.SM->Process();
-		Sleep(100);
+		main_loop.Wait();
 	}
 
+	server.CM->SetWakeEvent(nullptr);
+	server.SM->SetWakeEvent(nullptr);
+
 	server_log->Log(log_debug, "Server Shutdown.");
 	server_log->Log(log_debug, "Client Manager Shutdown.");
 	delete server.CM;
@@ -26,6 +26,7 @@ extern LoginServer server;
 extern bool run_server;
 
 ServerManager::ServerManager()
+: list_version(1)
 {
 	char error_buffer[TCPConnection_ErrorBufferSize];
 
@@ -68,6 +69,7 @@ void ServerManager::Process()
 			cur->GetConnection()->Free();
 			cur->SetConnection(tcp_c);
 			cur->Reset();
+			InvalidateServerList();
 		}
 		else
 		{
@@ -84,6 +86,7 @@ void ServerManager::Process()
 			server_log->Log(log_world, "World server %s had a fatal error and had to be removed from the login.", (*iter)->GetLongName().c_str());
 			delete (*iter);
 			iter = world_servers.erase(iter);
+			InvalidateServerList();
 		}
 		else
 		{
@@ -106,6 +109,7 @@ void ServerManager::ProcessDisconnect()
 			c->Free();
 			delete (*iter);
 			iter = world_servers.erase(iter);
+			InvalidateServerList();
 		}
 		else
 		{
@@ -131,11 +135,49 @@ WorldServer* ServerManager::GetServerByAddress(unsigned int address)
 
 EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 {
-	unsigned int packet_size = sizeof(ServerListHeader_Struct);
-	unsigned int server_count = 0;
+	unsigned int client_address = c->GetConnection()->GetRemoteIP();
 	in_addr in;
-	in.s_addr = c->GetConnection()->GetRemoteIP();
+	in.s_addr = client_address;
 	string client_ip = inet_ntoa(in);
+	bool local_client = (client_ip.find(server.options.GetLocalNetwork()) != string::npos);
+
+	/**
+	* A remote client sharing an address with a world gets that world's local ip,
+	* that list is particular to them so it is built on the spot.
+	*/
+	if(!local_client)
+	{
+		list<WorldServer*>::iterator iter = world_servers.begin();
+		while(iter != world_servers.end())
+		{
+			if((*iter)->IsAuthorized() && (*iter)->GetConnection()->GetrIP() == client_address)
+			{
+				std::vector<unsigned char> data;
+				BuildServerList(data, client_address, false);
+				EQApplicationPacket *outapp = new EQApplicationPacket(OP_ServerListResponse, data.size());
+				memcpy(outapp->pBuffer, &data[0], data.size());
+				return outapp;
+			}
+			++iter;
+		}
+	}
+
+	CachedServerList &cache = local_client ? local_list : remote_list;
+	if(cache.version != list_version)
+	{
+		BuildServerList(cache.data, 0, local_client);
+		cache.version = list_version;
+	}
+
+	EQApplicationPacket *outapp = new EQApplicationPacket(OP_ServerListResponse, cache.data.size());
+	memcpy(outapp->pBuffer, &cache.data[0], cache.data.size());
+	return outapp;
+}
+
+void ServerManager::BuildServerList(std::vector<unsigned char> &out, unsigned int client_address, bool local_client)
+{
+	unsigned int packet_size = sizeof(ServerListHeader_Struct);
+	unsigned int server_count = 0;
 
 	list<WorldServer*>::iterator iter = world_servers.begin();
 	while(iter != world_servers.end())
@@ -146,14 +188,7 @@ EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 			continue;
 		}
 
-		in.s_addr = (*iter)->GetConnection()->GetrIP();
-		string world_ip = inet_ntoa(in);
-
-		if(world_ip.compare(client_ip) == 0)
-		{
-			packet_size += (*iter)->GetLongName().size() + (*iter)->GetLocalIP().size() + 24;
-		}
-		else if(client_ip.find(server.options.GetLocalNetwork()) != string::npos)
+		if(local_client || (*iter)->GetConnection()->GetrIP() == client_address)
 		{
 			packet_size += (*iter)->GetLongName().size() + (*iter)->GetLocalIP().size() + 24;
 		}
@@ -166,8 +201,8 @@ EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 		++iter;
 	}
 
-	EQApplicationPacket *outapp = new EQApplicationPacket(OP_ServerListResponse, packet_size);
-	ServerListHeader_Struct *sl = (ServerListHeader_Struct*)outapp->pBuffer;
+	out.assign(packet_size, 0);
+	ServerListHeader_Struct *sl = (ServerListHeader_Struct*)&out[0];
 	sl->Unknown1 = 0x00000004;
 	sl->Unknown2 = 0x00000000;
 	sl->Unknown3 = 0x01650000;
@@ -178,7 +213,7 @@ EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 	sl->Unknown4 = 0x00000000;
 	sl->NumberOfServers = server_count;
 
-	unsigned char *data_ptr = outapp->pBuffer;
+	unsigned char *data_ptr = &out[0];
 	data_ptr += sizeof(ServerListHeader_Struct);
 
 	iter = world_servers.begin();
@@ -190,14 +225,7 @@ EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 			continue;
 		}
 
-		in.s_addr = (*iter)->GetConnection()->GetrIP();
-		string world_ip = inet_ntoa(in);
-		if(world_ip.compare(client_ip) == 0)
-		{
-			memcpy(data_ptr, (*iter)->GetLocalIP().c_str(), (*iter)->GetLocalIP().size());
-			data_ptr += ((*iter)->GetLocalIP().size() + 1);
-		}
-		else if(client_ip.find(server.options.GetLocalNetwork()) != string::npos)
+		if(local_client || (*iter)->GetConnection()->GetrIP() == client_address)
 		{
 			memcpy(data_ptr, (*iter)->GetLocalIP().c_str(), (*iter)->GetLocalIP().size());
 			data_ptr += ((*iter)->GetLocalIP().size() + 1);
@@ -262,8 +290,6 @@ EQApplicationPacket *ServerManager::CreateServerListPacket(Client *c)
 
 		++iter;
 	}
-
-	return outapp;
 }
 
 void ServerManager::SendUserToWorldRequest(unsigned int server_id, unsigned int client_account_id)
@@ -337,6 +363,7 @@ void ServerManager::DestroyServerByName(string l_name, string s_name, WorldServe
 			c->Free();
 			delete (*iter);
 			iter = world_servers.erase(iter);
+			InvalidateServerList();
 		}
 
 		++iter;
@@ -27,6 +27,7 @@
 #include "world_server.h"
 #include "client.h"
 #include <list>
+#include <vector>
 
 /**
 * Server manager class, deals with management of the world servers.
@@ -49,6 +50,11 @@ public:
 	*/
 	void Process();
 
+	/**
+	* Has the TCP server and its world connections wake the main loop when they have data.
+	*/
+	void SetWakeEvent(EQEmu::WakeEvent *ev) { tcps->SetWakeEvent(ev); }
+
 	/**
 	* Sends a request to world to see if the client is banned or suspended.
 	*/
@@ -59,6 +65,11 @@ public:
 	*/
 	EQApplicationPacket *CreateServerListPacket(Client *c);
 
+	/**
+	* Marks the cached server lists out of date, called whenever something they show changes.
+	*/
+	void InvalidateServerList() { list_version++; }
+
 	/**
 	* Checks to see if there is a server exists with this name, ignoring option.
 	*/
@@ -81,8 +92,27 @@ private:
 	*/
 	WorldServer* GetServerByAddress(unsigned int address);
 
+	/**
+	* Writes the server list into out, header included.
+	* Worlds on the client's own address or every world if local_client is set get their local ip, the rest their remote ip.
+	*/
+	void BuildServerList(std::vector<unsigned char> &out, unsigned int client_address, bool local_client);
+
+	/**
+	* A server list as last built, reused until list_version moves past version.
+	*/
+	struct CachedServerList
+	{
+		CachedServerList() : version(0) { }
+		unsigned int version;
+		std::vector<unsigned char> data;
+	};
+
 	EmuTCPServer* tcps;
 	std::list<WorldServer*> world_servers;
+	unsigned int list_version;
+	CachedServerList local_list;
+	CachedServerList remote_list;
 };
 
 #endif
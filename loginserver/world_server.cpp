@@ -493,6 +493,8 @@ void WorldServer::Handle_NewLSInfo(ServerNewLSInfo_Struct* i)
 	in.s_addr = connection->GetrIP();
 	server.db->UpdateWorldRegistration(GetRuntimeID(), long_name, string(inet_ntoa(in)));
 
+	server.SM->InvalidateServerList();
+
 	if(authorized)
 	{
 		server.CM->UpdateServerList();
@@ -501,6 +503,11 @@ void WorldServer::Handle_NewLSInfo(ServerNewLSInfo_Struct* i)
 
 void WorldServer::Handle_LSStatus(ServerLSStatus_Struct *s)
 {
+	if(players_online != (unsigned int)s->num_players || zones_booted != (unsigned int)s->num_zones || status != s->status)
+	{
+		server.SM->InvalidateServerList();
+	}
+
 	players_online = s->num_players;
 	zones_booted = s->num_zones;
 	status = s->status;
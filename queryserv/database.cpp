@@ -30,6 +30,7 @@
 #include <assert.h>
 #include <map>
 #include <vector>
+#include <time.h>
 
 // Disgrace: for windows compile
 #ifdef _WINDOWS
@@ -48,6 +49,7 @@
 #include "../common/servertalk.h"
 
 Database::Database ()
+: insert_buffer(this)
 {
 	DBInitVars();
 }
@@ -57,6 +59,7 @@ Establish a connection to a mysql database with the supplied parameters
 */
 
 Database::Database(const char* host, const char* user, const char* passwd, const char* database, uint32 port)
+: insert_buffer(this)
 {
 	DBInitVars();
 	Connect(host, user, passwd, database, port);
@@ -106,243 +109,225 @@ void Database::AddSpeech(const char* from, const char* to, const char* message,
 	DoEscapeString(escapedTo, to, strlen(to));
 	DoEscapeString(escapedMessage, message, strlen(message));
 
-    std::string query = StringFormat("INSERT INTO `qs_player_speech` "
-                                    "SET `from` = '%s', `to` = '%s', `message`='%s', "
-                                    "`minstatus`='%i', `guilddbid`='%i', `type`='%i'",
-                                    escapedFrom, escapedTo, escapedMessage, minstatus, guilddbid, type);
-    safe_delete_array(escapedFrom);
+	std::string values = StringFormat("'%s', '%s', '%s', '%i', '%i', '%i', FROM_UNIXTIME(%u)",
+									escapedFrom, escapedTo, escapedMessage, minstatus, guilddbid, type,
+									(uint32)time(nullptr));
+	safe_delete_array(escapedFrom);
 	safe_delete_array(escapedTo);
 	safe_delete_array(escapedMessage);
-	auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Speech Entry Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
-	}
-
 
+	BufferInsert("qs_player_speech",
+				"`from`, `to`, `message`, `minstatus`, `guilddbid`, `type`, `timerecorded`", values);
 }
 
 void Database::LogPlayerTrade(QSPlayerLogTrade_Struct* QS, uint32 detailCount) {
 
-	std::string query = StringFormat("INSERT INTO `qs_player_trade_record` SET `time` = NOW(), "
-                                    "`char1_id` = '%i', `char1_pp` = '%i', `char1_gp` = '%i', "
-                                    "`char1_sp` = '%i', `char1_cp` = '%i', `char1_items` = '%i', "
-                                    "`char2_id` = '%i', `char2_pp` = '%i', `char2_gp` = '%i', "
-                                    "`char2_sp` = '%i', `char2_cp` = '%i', `char2_items` = '%i'",
-                                    QS->char1_id, QS->char1_money.platinum, QS->char1_money.gold,
-                                    QS->char1_money.silver, QS->char1_money.copper, QS->char1_count,
-                                    QS->char2_id, QS->char2_money.platinum, QS->char2_money.gold,
-                                    QS->char2_money.silver, QS->char2_money.copper, QS->char2_count);
-    auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Trade Log Record Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
+	std::string values = StringFormat("FROM_UNIXTIME(%u), '%i', '%i', '%i', '%i', '%i', '%i', "
+									"'%i', '%i', '%i', '%i', '%i', '%i'",
+									(uint32)time(nullptr),
+									QS->char1_id, QS->char1_money.platinum, QS->char1_money.gold,
+									QS->char1_money.silver, QS->char1_money.copper, QS->char1_count,
+									QS->char2_id, QS->char2_money.platinum, QS->char2_money.gold,
+									QS->char2_money.silver, QS->char2_money.copper, QS->char2_count);
+	const char *columns = "`time`, `char1_id`, `char1_pp`, `char1_gp`, `char1_sp`, `char1_cp`, `char1_items`, "
+						"`char2_id`, `char2_pp`, `char2_gp`, `char2_sp`, `char2_cp`, `char2_items`";
+
+	if(detailCount == 0) {
+		BufferInsert("qs_player_trade_record", columns, values);
+		return;
 	}
 
-	if(detailCount == 0)
-        return;
-
-	int lastIndex = results.LastInsertedID();
-
-    for(int i = 0; i < detailCount; i++) {
-        query = StringFormat("INSERT INTO `qs_player_trade_record_entries` SET `event_id` = '%i', "
-                            "`from_id` = '%i', `from_slot` = '%i', `to_id` = '%i', `to_slot` = '%i', "
-                            "`item_id` = '%i', `charges` = '%i', `aug_1` = '%i', `aug_2` = '%i', "
-                            "`aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-                            lastIndex, QS->items[i].from_id, QS->items[i].from_slot,
-                            QS->items[i].to_id, QS->items[i].to_slot, QS->items[i].item_id,
-                            QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
-                            QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5);
-        results = QueryDatabase(query);
-        if(!results.Success()) {
-            _log(QUERYSERV__ERROR, "Failed Trade Log Record Entry Insert: %s", results.ErrorMessage().c_str());
-            _log(QUERYSERV__ERROR, "%s", query.c_str());
-        }
-
-    }
+	uint32 lastIndex = InsertRecord("qs_player_trade_record", columns, values);
+	if(lastIndex == 0)
+		return;
+
+	for(int i = 0; i < detailCount; i++) {
+		values = StringFormat("'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+							lastIndex, QS->items[i].from_id, QS->items[i].from_slot,
+							QS->items[i].to_id, QS->items[i].to_slot, QS->items[i].item_id,
+							QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
+							QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5);
+		BufferInsert("qs_player_trade_record_entries",
+					"`event_id`, `from_id`, `from_slot`, `to_id`, `to_slot`, `item_id`, `charges`, "
+					"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`", values);
+	}
 
 }
 
 void Database::LogPlayerHandin(QSPlayerLogHandin_Struct* QS, uint32 detailCount) {
 
-    std::string query = StringFormat("INSERT INTO `qs_player_handin_record` SET `time` = NOW(), "
-                                    "`quest_id` = '%i', `char_id` = '%i', `char_pp` = '%i', "
-                                    "`char_gp` = '%i', `char_sp` = '%i', `char_cp` = '%i', "
-                                    "`char_items` = '%i', `npc_id` = '%i', `npc_pp` = '%i', "
-                                    "`npc_gp` = '%i', `npc_sp` = '%i', `npc_cp` = '%i', "
-                                    "`npc_items`='%i'",
-                                    QS->quest_id, QS->char_id, QS->char_money.platinum,
-                                    QS->char_money.gold, QS->char_money.silver, QS->char_money.copper,
-                                    QS->char_count, QS->npc_id, QS->npc_money.platinum,
-                                    QS->npc_money.gold, QS->npc_money.silver, QS->npc_money.copper,
-                                    QS->npc_count);
-    auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Handin Log Record Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
+	std::string values = StringFormat("FROM_UNIXTIME(%u), '%i', '%i', '%i', '%i', '%i', '%i', '%i', "
+									"'%i', '%i', '%i', '%i', '%i', '%i'",
+									(uint32)time(nullptr),
+									QS->quest_id, QS->char_id, QS->char_money.platinum,
+									QS->char_money.gold, QS->char_money.silver, QS->char_money.copper,
+									QS->char_count, QS->npc_id, QS->npc_money.platinum,
+									QS->npc_money.gold, QS->npc_money.silver, QS->npc_money.copper,
+									QS->npc_count);
+	const char *columns = "`time`, `quest_id`, `char_id`, `char_pp`, `char_gp`, `char_sp`, `char_cp`, "
+						"`char_items`, `npc_id`, `npc_pp`, `npc_gp`, `npc_sp`, `npc_cp`, `npc_items`";
+
+	if(detailCount == 0) {
+		BufferInsert("qs_player_handin_record", columns, values);
+		return;
 	}
 
-	if(detailCount == 0)
-        return;
-
-	int lastIndex = results.LastInsertedID();
-
-    for(int i = 0; i < detailCount; i++) {
-        query = StringFormat("INSERT INTO `qs_player_handin_record_entries` SET `event_id` = '%i', "
-                            "`action_type` = '%s', `char_slot` = '%i', `item_id` = '%i', "
-                            "`charges` = '%i', `aug_1` = '%i', `aug_2` = '%i', `aug_3` = '%i', "
-                            "`aug_4` = '%i', `aug_5` = '%i'",
-                            lastIndex, QS->items[i].action_type, QS->items[i].char_slot,
-                            QS->items[i].item_id, QS->items[i].charges, QS->items[i].aug_1,
-                            QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-                            QS->items[i].aug_5);
-        if(!results.Success()) {
-            _log(QUERYSERV__ERROR, "Failed Handin Log Record Entry Insert: %s", results.ErrorMessage().c_str());
-            _log(QUERYSERV__ERROR, "%s", query.c_str());
-        }
-    }
+	uint32 lastIndex = InsertRecord("qs_player_handin_record", columns, values);
+	if(lastIndex == 0)
+		return;
+
+	for(int i = 0; i < detailCount; i++) {
+		values = StringFormat("'%i', '%s', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+							lastIndex, QS->items[i].action_type, QS->items[i].char_slot,
+							QS->items[i].item_id, QS->items[i].charges, QS->items[i].aug_1,
+							QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+							QS->items[i].aug_5);
+		BufferInsert("qs_player_handin_record_entries",
+					"`event_id`, `action_type`, `char_slot`, `item_id`, `charges`, "
+					"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`", values);
+	}
 
 }
 
 void Database::LogPlayerNPCKill(QSPlayerLogNPCKill_Struct* QS, uint32 members){
 
-	std::string query = StringFormat("INSERT INTO `qs_player_npc_kill_record` "
-                                    "SET `npc_id` = '%i', `type` = '%i', "
-                                    "`zone_id` = '%i', `time` = NOW()",
-                                    QS->s1.NPCID, QS->s1.Type, QS->s1.ZoneID);
-	auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed NPC Kill Log Record Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
-	}
+	std::string values = StringFormat("'%i', '%i', '%i', FROM_UNIXTIME(%u)",
+									QS->s1.NPCID, QS->s1.Type, QS->s1.ZoneID, (uint32)time(nullptr));
+	const char *columns = "`npc_id`, `type`, `zone_id`, `time`";
 
-	if(members == 0)
-        return;
+	if(members == 0) {
+		BufferInsert("qs_player_npc_kill_record", columns, values);
+		return;
+	}
 
-	int lastIndex = results.LastInsertedID();
+	uint32 lastIndex = InsertRecord("qs_player_npc_kill_record", columns, values);
+	if(lastIndex == 0)
+		return;
 
 	for (int i = 0; i < members; i++) {
-        query = StringFormat("INSERT INTO `qs_player_npc_kill_record_entries` "
-                            "SET `event_id` = '%i', `char_id` = '%i'",
-                            lastIndex, QS->Chars[i].char_id);
-		auto results = QueryDatabase(query);
-		if(!results.Success()) {
-			_log(QUERYSERV__ERROR, "Failed NPC Kill Log Entry Insert: %s", results.ErrorMessage().c_str());
-			_log(QUERYSERV__ERROR, "%s", query.c_str());
-		}
-
+		values = StringFormat("'%i', '%i'", lastIndex, QS->Chars[i].char_id);
+		BufferInsert("qs_player_npc_kill_record_entries", "`event_id`, `char_id`", values);
 	}
 
 }
 
 void Database::LogPlayerDelete(QSPlayerLogDelete_Struct* QS, uint32 items) {
 
-	std::string query = StringFormat("INSERT INTO `qs_player_delete_record` SET `time` = NOW(), "
-                                    "`char_id` = '%i', `stack_size` = '%i', `char_items` = '%i'",
-                                    QS->char_id, QS->stack_size, QS->char_count, QS->char_count);
-    auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Delete Log Record Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
-	}
-
-	if(items == 0)
-        return;
-
-    int lastIndex = results.LastInsertedID();
+	std::string values = StringFormat("FROM_UNIXTIME(%u), '%i', '%i', '%i'",
+									(uint32)time(nullptr), QS->char_id, QS->stack_size, QS->char_count);
+	const char *columns = "`time`, `char_id`, `stack_size`, `char_items`";
 
-    for(int i = 0; i < items; i++) {
-        query = StringFormat("INSERT INTO `qs_player_delete_record_entries` SET `event_id` = '%i', "
-                            "`char_slot` = '%i', `item_id` = '%i', `charges` = '%i', `aug_1` = '%i', "
-                            "`aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-                            lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
-                            QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-                            QS->items[i].aug_5);
-        results = QueryDatabase(query);
-        if(!results.Success()) {
-            _log(QUERYSERV__ERROR, "Failed Delete Log Record Entry Insert: %s", results.ErrorMessage().c_str());
-            _log(QUERYSERV__ERROR, "%s", query.c_str());
-        }
+	if(items == 0) {
+		BufferInsert("qs_player_delete_record", columns, values);
+		return;
+	}
 
-    }
+	uint32 lastIndex = InsertRecord("qs_player_delete_record", columns, values);
+	if(lastIndex == 0)
+		return;
+
+	for(int i = 0; i < items; i++) {
+		values = StringFormat("'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+							lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
+							QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+							QS->items[i].aug_5);
+		BufferInsert("qs_player_delete_record_entries",
+					"`event_id`, `char_slot`, `item_id`, `charges`, "
+					"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`", values);
+	}
 
 }
 
 void Database::LogPlayerMove(QSPlayerLogMove_Struct* QS, uint32 items) {
 	/* These are item moves */
 
-	std::string query = StringFormat("INSERT INTO `qs_player_move_record` SET `time` = NOW(), "
-                                    "`char_id` = '%i', `from_slot` = '%i', `to_slot` = '%i', "
-                                    "`stack_size` = '%i', `char_items` = '%i', `postaction` = '%i'",
-                                    QS->char_id, QS->from_slot, QS->to_slot, QS->stack_size,
-                                    QS->char_count, QS->postaction);
-    auto results = QueryDatabase(query);
-	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Move Log Record Insert: %s", results.ErrorMessage().c_str());
-		_log(QUERYSERV__ERROR, "%s", query.c_str());
+	std::string values = StringFormat("FROM_UNIXTIME(%u), '%i', '%i', '%i', '%i', '%i', '%i'",
+									(uint32)time(nullptr), QS->char_id, QS->from_slot, QS->to_slot,
+									QS->stack_size, QS->char_count, QS->postaction);
+	const char *columns = "`time`, `char_id`, `from_slot`, `to_slot`, `stack_size`, `char_items`, `postaction`";
+
+	if(items == 0) {
+		BufferInsert("qs_player_move_record", columns, values);
+		return;
 	}
 
-	if(items == 0)
-        return;
+	uint32 lastIndex = InsertRecord("qs_player_move_record", columns, values);
+	if(lastIndex == 0)
+		return;
+
+	for(int i = 0; i < items; i++) {
+		values = StringFormat("'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+							lastIndex, QS->items[i].from_slot, QS->items[i].to_slot, QS->items[i].item_id,
+							QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
+							QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5);
+		BufferInsert("qs_player_move_record_entries",
+					"`event_id`, `from_slot`, `to_slot`, `item_id`, `charges`, "
+					"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`", values);
+	}
 
-    int lastIndex = results.LastInsertedID();
+}
 
-    for(int i = 0; i < items; i++) {
-        query = StringFormat("INSERT INTO `qs_player_move_record_entries` SET `event_id` = '%i', "
-                            "`from_slot` = '%i', `to_slot` = '%i', `item_id` = '%i', `charges` = '%i', "
-                            "`aug_1` = '%i', `aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-                            lastIndex, QS->items[i].from_slot, QS->items[i].to_slot, QS->items[i].item_id,
-                            QS->items[i].charges, QS->items[i].aug_1, QS->items[i].aug_2,
-                            QS->items[i].aug_3, QS->items[i].aug_4, QS->items[i].aug_5);
-        results = QueryDatabase(query);
-        if(!results.Success()) {
-            _log(QUERYSERV__ERROR, "Failed Move Log Record Entry Insert: %s", results.ErrorMessage().c_str());
-            _log(QUERYSERV__ERROR, "%s", query.c_str());
-        }
+void Database::LogMerchantTransaction(QSMerchantLogTransaction_Struct* QS, uint32 items) {
+	/* Merchant transactions are from the perspective of the merchant, not the player -U */
+	std::string values = StringFormat("FROM_UNIXTIME(%u), '%i', '%i', '%i', '%i', '%i', '%i', '%i', "
+									"'%i', '%i', '%i', '%i', '%i', '%i'",
+									(uint32)time(nullptr),
+									QS->zone_id, QS->merchant_id, QS->merchant_money.platinum,
+									QS->merchant_money.gold, QS->merchant_money.silver,
+									QS->merchant_money.copper, QS->merchant_count, QS->char_id,
+									QS->char_money.platinum, QS->char_money.gold, QS->char_money.silver,
+									QS->char_money.copper, QS->char_count);
+	const char *columns = "`time`, `zone_id`, `merchant_id`, `merchant_pp`, `merchant_gp`, `merchant_sp`, "
+						"`merchant_cp`, `merchant_items`, `char_id`, `char_pp`, `char_gp`, `char_sp`, "
+						"`char_cp`, `char_items`";
+
+	if(items == 0) {
+		BufferInsert("qs_merchant_transaction_record", columns, values);
+		return;
+	}
 
-    }
+	uint32 lastIndex = InsertRecord("qs_merchant_transaction_record", columns, values);
+	if(lastIndex == 0)
+		return;
+
+	for(int i = 0; i < items; i++) {
+		values = StringFormat("'%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i', '%i'",
+							lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
+							QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
+							QS->items[i].aug_5);
+		BufferInsert("qs_merchant_transaction_record_entries",
+					"`event_id`, `char_slot`, `item_id`, `charges`, "
+					"`aug_1`, `aug_2`, `aug_3`, `aug_4`, `aug_5`", values);
+	}
 
 }
 
-void Database::LogMerchantTransaction(QSMerchantLogTransaction_Struct* QS, uint32 items) {
-	/* Merchant transactions are from the perspective of the merchant, not the player -U */
-	std::string query = StringFormat("INSERT INTO `qs_merchant_transaction_record` SET `time` = NOW(), "
-                                    "`zone_id` = '%i', `merchant_id` = '%i', `merchant_pp` = '%i', "
-                                    "`merchant_gp` = '%i', `merchant_sp` = '%i', `merchant_cp` = '%i', "
-                                    "`merchant_items` = '%i', `char_id` = '%i', `char_pp` = '%i', "
-                                    "`char_gp` = '%i', `char_sp` = '%i', `char_cp` = '%i', "
-                                    "`char_items` = '%i'",
-                                    QS->zone_id, QS->merchant_id, QS->merchant_money.platinum,
-                                    QS->merchant_money.gold, QS->merchant_money.silver,
-                                    QS->merchant_money.copper, QS->merchant_count, QS->char_id,
-                                    QS->char_money.platinum, QS->char_money.gold, QS->char_money.silver,
-                                    QS->char_money.copper, QS->char_count);
-    auto results = QueryDatabase(query);
+/*
+	Header rows that own detail rows are written straight away since the
+	details need their event_id; everything else goes through insert_buffer.
+*/
+uint32 Database::InsertRecord(const char* table, const char* columns, const std::string& values) {
+
+	std::string query = StringFormat("INSERT INTO `%s` (%s) VALUES (%s)", table, columns, values.c_str());
+	auto results = QueryDatabase(query);
 	if(!results.Success()) {
-		_log(QUERYSERV__ERROR, "Failed Transaction Log Record Insert: %s", results.ErrorMessage().c_str());
+		_log(QUERYSERV__ERROR, "Failed %s Insert: %s", table, results.ErrorMessage().c_str());
 		_log(QUERYSERV__ERROR, "%s", query.c_str());
+		return 0;
 	}
 
-	if(items == 0)
-        return;
-
-    int lastIndex = results.LastInsertedID();
+	return results.LastInsertedID();
+}
 
-    for(int i = 0; i < items; i++) {
-        query = StringFormat("INSERT INTO `qs_merchant_transaction_record_entries` SET `event_id` = '%i', "
-                            "`char_slot` = '%i', `item_id` = '%i', `charges` = '%i', `aug_1` = '%i', "
-                            "`aug_2` = '%i', `aug_3` = '%i', `aug_4` = '%i', `aug_5` = '%i'",
-                            lastIndex, QS->items[i].char_slot, QS->items[i].item_id, QS->items[i].charges,
-                            QS->items[i].aug_1, QS->items[i].aug_2, QS->items[i].aug_3, QS->items[i].aug_4,
-                            QS->items[i].aug_5);
-        results = QueryDatabase(query);
-        if(!results.Success()) {
-            _log(QUERYSERV__ERROR, "Failed Transaction Log Record Entry Insert: %s", results.ErrorMessage().c_str());
-            _log(QUERYSERV__ERROR, "%s", query.c_str());
-        }
+void Database::BufferInsert(const char* table, const char* columns, const std::string& values) {
 
-    }
+	insert_buffer.Add(table, columns, values);
+	if(insert_buffer.ShouldFlush())
+		insert_buffer.Flush();
+}
 
+bool Database::FlushInserts() {
+	return insert_buffer.Flush();
 }
 
 void Database::GeneralQueryReceive(ServerPacket *pack) {
@@ -28,6 +28,7 @@
 #include "../common/dbcore.h"
 #include "../common/linked_list.h"
 #include "../common/servertalk.h"
+#include "insert_buffer.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -50,10 +51,18 @@ public:
 	void LogPlayerMove(QSPlayerLogMove_Struct* QS, uint32 Items);
 	void LogMerchantTransaction(QSMerchantLogTransaction_Struct* QS, uint32 Items);
 	void GeneralQueryReceive(ServerPacket *pack);
+
+	// Writes out buffered log rows; false while the connection is down
+	bool FlushInserts();
+	uint32 GetPendingInserts() const { return insert_buffer.GetPendingRows(); }
 protected:
 	void HandleMysqlError(uint32 errnum);
 private:
 	void DBInitVars();
+	uint32 InsertRecord(const char* table, const char* columns, const std::string& values);
+	void BufferInsert(const char* table, const char* columns, const std::string& values);
+
+	InsertBuffer insert_buffer;
 
 };
 
@@ -0,0 +1,128 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/debug.h"
+#include "../common/dbcore.h"
+#include "../common/timer.h"
+#include "insert_buffer.h"
+#include <errmsg.h>
+
+InsertBuffer::InsertBuffer(DBcore *db)
+: db(db),
+  pending_rows(0),
+  dropped_rows(0),
+  reported_dropped(0),
+  backlog_warned(false)
+{
+}
+
+InsertBuffer::~InsertBuffer()
+{
+	if (pending_rows > 0)
+		LogFile->write(EQEmuLog::Error, "QueryServ: discarding %u unflushed log rows", pending_rows);
+}
+
+void InsertBuffer::Add(const char *table, const char *columns, const std::string &values)
+{
+	TableQueue &queue = tables[table];
+	if (queue.columns.empty())
+		queue.columns = columns;
+
+	if (pending_rows >= QS_INSERT_MAX_PENDING && !queue.rows.empty()) {
+		// the database isn't keeping up; shed the oldest rows of this table
+		queue.rows.pop_front();
+		pending_rows--;
+		dropped_rows++;
+	}
+
+	queue.rows.push_back(values);
+	pending_rows++;
+
+	if (!backlog_warned && pending_rows >= QS_INSERT_MAX_PENDING / 2) {
+		LogFile->write(EQEmuLog::Error, "QueryServ: %u log rows waiting on the database, inserts are falling behind", pending_rows);
+		backlog_warned = true;
+	}
+}
+
+bool InsertBuffer::Flush()
+{
+	if (pending_rows == 0)
+		return true;
+
+	uint32 start = Timer::SetCurrentTime();
+	uint32 rows = pending_rows;
+	bool connected = true;
+
+	std::map<std::string, TableQueue>::iterator iter;
+	for (iter = tables.begin(); iter != tables.end() && connected; ++iter)
+		connected = FlushTable(iter->first, iter->second);
+
+	uint32 elapsed = Timer::SetCurrentTime() - start;
+	if (elapsed >= QS_INSERT_SLOW_FLUSH)
+		LogFile->write(EQEmuLog::Error, "QueryServ: writing %u log rows took %ums, %u still pending", rows - pending_rows, elapsed, pending_rows);
+
+	if (dropped_rows != reported_dropped) {
+		LogFile->write(EQEmuLog::Error, "QueryServ: %u log rows dropped so far because the database could not keep up", dropped_rows);
+		reported_dropped = dropped_rows;
+	}
+
+	if (pending_rows < QS_INSERT_MAX_PENDING / 4)
+		backlog_warned = false;
+
+	return connected;
+}
+
+bool InsertBuffer::FlushTable(const std::string &table, TableQueue &queue)
+{
+	std::string query;
+
+	while (!queue.rows.empty()) {
+		query = "INSERT INTO `" + table + "` (" + queue.columns + ") VALUES ";
+
+		size_t count = 0;
+		std::deque<std::string>::iterator row = queue.rows.begin();
+		while (row != queue.rows.end() && (count == 0 || query.length() + row->length() + 3 < QS_INSERT_MAX_STATEMENT)) {
+			if (count > 0)
+				query += ',';
+			query += '(';
+			query += *row;
+			query += ')';
+			++count;
+			++row;
+		}
+
+		auto results = db->QueryDatabase(query);
+		if (!results.Success()) {
+			uint32 errnum = results.ErrorNumber();
+			if (errnum == CR_SERVER_GONE_ERROR || errnum == CR_SERVER_LOST) {
+				// keep the rows, they go out once the connection is back
+				_log(QUERYSERV__ERROR, "Lost database connection writing %s, %u rows held", table.c_str(), pending_rows);
+				return false;
+			}
+
+			// a bad row would fail every retry, so the batch is given up
+			_log(QUERYSERV__ERROR, "Failed %s batch insert of %u rows: %s", table.c_str(), (uint32)count, results.ErrorMessage().c_str());
+			dropped_rows += count;
+		}
+
+		queue.rows.erase(queue.rows.begin(), queue.rows.begin() + count);
+		pending_rows -= count;
+	}
+
+	return true;
+}
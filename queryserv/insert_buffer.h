@@ -0,0 +1,85 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef QUERYSERV_INSERT_BUFFER_H
+#define QUERYSERV_INSERT_BUFFER_H
+
+#include "../common/types.h"
+#include <string>
+#include <deque>
+#include <map>
+
+class DBcore;
+
+// Flush as soon as this many rows are waiting, otherwise on the flush timer
+#ifndef QS_INSERT_BATCH_ROWS
+#define QS_INSERT_BATCH_ROWS		500
+#endif
+#ifndef QS_INSERT_FLUSH_INTERVAL
+#define QS_INSERT_FLUSH_INTERVAL	1000
+#endif
+// Past this many pending rows the oldest are discarded rather than growing without bound
+#ifndef QS_INSERT_MAX_PENDING
+#define QS_INSERT_MAX_PENDING		50000
+#endif
+// Upper bound on one multi-row statement, kept well below the default max_allowed_packet
+#ifndef QS_INSERT_MAX_STATEMENT
+#define QS_INSERT_MAX_STATEMENT		(512 * 1024)
+#endif
+// A flush taking longer than this (ms) is reported as the database falling behind
+#ifndef QS_INSERT_SLOW_FLUSH
+#define QS_INSERT_SLOW_FLUSH		250
+#endif
+
+/*
+	Collects rows bound for the qs_* log tables and writes them as multi-row
+	INSERT statements, so a raid kill or a large trade costs one round trip
+	per table instead of one per row. Rows for a table must always use the
+	same column list.
+*/
+class InsertBuffer {
+public:
+	InsertBuffer(DBcore *db);
+	~InsertBuffer();
+
+	// values is the already escaped contents of one VALUES (...) tuple, without the parentheses
+	void Add(const char *table, const char *columns, const std::string &values);
+	// Returns false if the connection is down; unsent rows are kept for the next attempt
+	bool Flush();
+
+	bool ShouldFlush() const { return pending_rows >= QS_INSERT_BATCH_ROWS; }
+	uint32 GetPendingRows() const { return pending_rows; }
+	uint32 GetDroppedRows() const { return dropped_rows; }
+
+private:
+	struct TableQueue {
+		std::string columns;
+		std::deque<std::string> rows;
+	};
+
+	bool FlushTable(const std::string &table, TableQueue &queue);
+
+	DBcore *db;
+	std::map<std::string, TableQueue> tables;
+	uint32 pending_rows;
+	uint32 dropped_rows;
+	uint32 reported_dropped;
+	bool backlog_warned;
+};
+
+#endif
@@ -24,6 +24,7 @@
 #include "../common/servertalk.h"
 #include "../common/platform.h"
 #include "../common/crash.h"
+#include "../common/event_loop.h"
 #include "database.h"
 #include "queryservconfig.h"
 #include "worldserver.h"
@@ -51,6 +52,7 @@ int main() {
 	set_exception_handler(); 
 	Timer LFGuildExpireTimer(60000);  
 	Timer InterserverTimer(INTERSERVER_TIMER); // does auto-reconnect
+	Timer InsertFlushTimer(QS_INSERT_FLUSH_INTERVAL);
 
 	/* Load XML from eqemu_config.xml 
 		<qsdatabase>
@@ -106,6 +108,13 @@ int main() {
 	/* Load Looking For Guild Manager */
 	lfguildmanager.LoadDatabase();
 
+	/* Sleep until world sends something or a timer is due */
+	EQEmu::EventLoop main_loop(1000);
+	main_loop.WatchTimer(&LFGuildExpireTimer);
+	main_loop.WatchTimer(&InterserverTimer);
+	main_loop.WatchTimer(&InsertFlushTimer);
+	worldserver->SetWakeEvent(main_loop.GetWakeEvent());
+
 	while(RunLoops) { 
 		Timer::SetCurrentTime(); 
 		if(LFGuildExpireTimer.Check())
@@ -116,9 +125,18 @@ int main() {
 				worldserver->AsyncConnect();
 		}
 		worldserver->Process(); 
+
+		/* Player log rows are batched; write out whatever is waiting */
+		if (InsertFlushTimer.Check())
+			database.FlushInserts();
+
 		timeout_manager.CheckTimeouts(); 
-		Sleep(100);
+		main_loop.Wait();
 	}
+	worldserver->SetWakeEvent(nullptr);
+
+	if (!database.FlushInserts())
+		_log(QUERYSERV__ERROR, "Shutting down with %u log rows unwritten", database.GetPendingInserts());
 }
 
 void UpdateWindowTitle(char* iNewTitle) {
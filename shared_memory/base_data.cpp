@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 
 void LoadBaseData(SharedDatabase *database) {
@@ -32,11 +33,16 @@ void LoadBaseData(SharedDatabase *database) {
 	}
 
 	uint32 size = records * 16 * sizeof(BaseDataStruct);
-	EQEmu::MemoryMappedFile mmf("shared/base_data", size);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("base_data");
+	EQEmu::MemoryMappedFile mmf(EQEmu::SharedMemoryGeneration::FileName("shared/base_data", generation), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
-	database->LoadBaseData(ptr, records);
+	if(!database->LoadBaseData(ptr, records)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load base data from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("base_data", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/base_data", generation);
 	mutex.Unlock();
 }
 
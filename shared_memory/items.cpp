@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/item_struct.h"
 
@@ -36,10 +37,15 @@ void LoadItems(SharedDatabase *database) {
 	}
 
 	uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<Item_Struct>::estimated_size(items, max_item));
-	EQEmu::MemoryMappedFile mmf("shared/items", size);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("items");
+	EQEmu::MemoryMappedFile mmf(EQEmu::SharedMemoryGeneration::FileName("shared/items", generation), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
-	database->LoadItems(ptr, size, items, max_item);
+	if(!database->LoadItems(ptr, size, items, max_item)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load items from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("items", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/items", generation);
 	mutex.Unlock();
 }
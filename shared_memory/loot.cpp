@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/fixed_memory_variable_hash_set.h"
 #include "../common/loottable.h"
@@ -44,8 +45,9 @@ void LoadLoot(SharedDatabase *database) {
 		(loot_drop_count * sizeof(LootDrop_Struct)) +				//loot table headers
 		(loot_drop_entries_count * sizeof(LootDropEntries_Struct));	//number of loot table entries
 
-	EQEmu::MemoryMappedFile mmf_loot_table("shared/loot_table", loot_table_size);
-	EQEmu::MemoryMappedFile mmf_loot_drop("shared/loot_drop", loot_drop_size);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("loot");
+	EQEmu::MemoryMappedFile mmf_loot_table(EQEmu::SharedMemoryGeneration::FileName("shared/loot_table", generation), loot_table_size);
+	EQEmu::MemoryMappedFile mmf_loot_drop(EQEmu::SharedMemoryGeneration::FileName("shared/loot_drop", generation), loot_drop_size);
 	mmf_loot_table.ZeroFile();
 	mmf_loot_drop.ZeroFile();
 
@@ -55,7 +57,12 @@ void LoadLoot(SharedDatabase *database) {
 	EQEmu::FixedMemoryVariableHashSet<LootDrop_Struct> loot_drop_hash(reinterpret_cast<byte*>(mmf_loot_drop.Get()),
 		loot_drop_size, loot_drop_max);
 
-	database->LoadLootTables(mmf_loot_table.Get(), loot_table_max);
-	database->LoadLootDrops(mmf_loot_drop.Get(), loot_drop_max);
+	if(!database->LoadLootTables(mmf_loot_table.Get(), loot_table_max) ||
+		!database->LoadLootDrops(mmf_loot_drop.Get(), loot_drop_max)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load loot from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("loot", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/loot_table", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/loot_drop", generation);
 	mutex.Unlock();
 }
@@ -30,6 +30,42 @@
 #include "skill_caps.h"
 #include "spells.h"
 #include "base_data.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//One shared memory segment, built on a connection of its own so every segment loads at the same time
+struct SegmentLoader {
+	SegmentLoader(const char *name, void (*load)(SharedDatabase*)) : name(name), load(load), success(false), elapsed(0) { }
+
+	const char *name;
+	void (*load)(SharedDatabase *database);
+	SharedDatabase database;
+	bool success;
+	uint32 elapsed;
+	std::string error;
+};
+
+static void RunSegmentLoader(SegmentLoader *loader, const EQEmuConfig *config) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	mysql_thread_init();
+
+	if(!loader->database.Connect(config->DatabaseHost.c_str(), config->DatabaseUsername.c_str(),
+		config->DatabasePassword.c_str(), config->DatabaseDB.c_str(), config->DatabasePort)) {
+		loader->error = "Unable to connect to the database, cannot continue without a database connection";
+	} else {
+		try {
+			loader->load(&loader->database);
+			loader->success = true;
+		} catch(std::exception &ex) {
+			loader->error = ex.what();
+		}
+	}
+
+	mysql_thread_end();
+	loader->elapsed = static_cast<uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - start).count());
+}
 
 int main(int argc, char **argv) {
 	RegisterExecutablePlatform(ExePlatformSharedMemory);
@@ -46,15 +82,6 @@ int main(int argc, char **argv) {
 		LogFile->write(EQEmuLog::Error, "Warning: unable to read %s.", config->LogSettingsFile.c_str());
 	}
 
-	SharedDatabase database;
-	LogFile->write(EQEmuLog::Status, "Connecting to database...");
-	if(!database.Connect(config->DatabaseHost.c_str(), config->DatabaseUsername.c_str(),
-		config->DatabasePassword.c_str(), config->DatabaseDB.c_str(), config->DatabasePort)) {
-		LogFile->write(EQEmuLog::Error, "Unable to connect to the database, cannot continue without a "
-			"database connection");
-		return 1;
-	}
-
 	bool load_all = true;
 	bool load_items = false;
 	bool load_factions = false;
@@ -108,65 +135,44 @@ int main(int argc, char **argv) {
 		}
 	}
 
-	if(load_all || load_items) {
-		LogFile->write(EQEmuLog::Status, "Loading items...");
-		try {
-			LoadItems(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-
-	if(load_all || load_factions) {
-		LogFile->write(EQEmuLog::Status, "Loading factions...");
-		try {
-			LoadFactions(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-
-	if(load_all || load_loot) {
-		LogFile->write(EQEmuLog::Status, "Loading loot...");
-		try {
-			LoadLoot(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-
-	if(load_all || load_skill_caps) {
-		LogFile->write(EQEmuLog::Status, "Loading skill caps...");
-		try {
-			LoadSkillCaps(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-
-	if(load_all || load_spells) {
-		LogFile->write(EQEmuLog::Status, "Loading spells...");
-		try {
-			LoadSpells(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
-		}
-	}
-
-	if(load_all || load_bd) {
-		LogFile->write(EQEmuLog::Status, "Loading base data...");
-		try {
-			LoadBaseData(&database);
-		} catch(std::exception &ex) {
-			LogFile->write(EQEmuLog::Error, "%s", ex.what());
-			return 1;
+	std::vector<SegmentLoader*> loaders;
+	if(load_all || load_items)
+		loaders.push_back(new SegmentLoader("items", LoadItems));
+	if(load_all || load_factions)
+		loaders.push_back(new SegmentLoader("factions", LoadFactions));
+	if(load_all || load_loot)
+		loaders.push_back(new SegmentLoader("loot", LoadLoot));
+	if(load_all || load_skill_caps)
+		loaders.push_back(new SegmentLoader("skill caps", LoadSkillCaps));
+	if(load_all || load_spells)
+		loaders.push_back(new SegmentLoader("spells", LoadSpells));
+	if(load_all || load_bd)
+		loaders.push_back(new SegmentLoader("base data", LoadBaseData));
+
+	LogFile->write(EQEmuLog::Status, "Loading %u segments...", (uint32)loaders.size());
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for(size_t i = 0; i < loaders.size(); ++i)
+		threads.push_back(std::thread(RunSegmentLoader, loaders[i], config));
+	for(size_t i = 0; i < threads.size(); ++i)
+		threads[i].join();
+
+	uint32 elapsed = static_cast<uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - start).count());
+
+	int ret = 0;
+	for(size_t i = 0; i < loaders.size(); ++i) {
+		if(loaders[i]->success) {
+			LogFile->write(EQEmuLog::Status, "Loaded %s in %u ms", loaders[i]->name, loaders[i]->elapsed);
+		} else {
+			LogFile->write(EQEmuLog::Error, "Loading %s failed after %u ms: %s", loaders[i]->name, loaders[i]->elapsed,
+				loaders[i]->error.c_str());
+			ret = 1;
 		}
+		safe_delete(loaders[i]);
 	}
 
-	return 0;
+	LogFile->write(EQEmuLog::Status, "Finished in %u ms", elapsed);
+	return ret;
 }
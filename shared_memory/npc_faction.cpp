@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/faction.h"
 
@@ -36,10 +37,15 @@ void LoadFactions(SharedDatabase *database) {
 	}
 
 	uint32 size = static_cast<uint32>(EQEmu::FixedMemoryHashSet<NPCFactionList>::estimated_size(lists, max_list));
-	EQEmu::MemoryMappedFile mmf("shared/faction", size);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("faction");
+	EQEmu::MemoryMappedFile mmf(EQEmu::SharedMemoryGeneration::FileName("shared/faction", generation), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
-	database->LoadNPCFactionLists(ptr, size, lists, max_list);
+	if(!database->LoadNPCFactionLists(ptr, size, lists, max_list)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load npc factions from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("faction", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/faction", generation);
 	mutex.Unlock();
 }
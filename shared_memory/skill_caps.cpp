@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/classes.h"
 #include "../common/features.h"
@@ -33,10 +34,15 @@ void LoadSkillCaps(SharedDatabase *database) {
 	uint32 skill_count = HIGHEST_SKILL + 1;
 	uint32 level_count = HARD_LEVEL_CAP + 1;
 	uint32 size = (class_count * skill_count * level_count * sizeof(uint16));
-	EQEmu::MemoryMappedFile mmf("shared/skill_caps", size);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("skill_caps");
+	EQEmu::MemoryMappedFile mmf(EQEmu::SharedMemoryGeneration::FileName("shared/skill_caps", generation), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
-	database->LoadSkillCaps(ptr);
+	if(!database->LoadSkillCaps(ptr)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load skill caps from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("skill_caps", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/skill_caps", generation);
 	mutex.Unlock();
 }
@@ -21,6 +21,7 @@
 #include "../common/shareddb.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/spdat.h"
 
@@ -32,12 +33,17 @@ void LoadSpells(SharedDatabase *database) {
 		EQ_EXCEPT("Shared Memory", "Unable to get any spells from the database.");
 	}
 
-	uint32 size = records * sizeof(SPDat_Spell_Struct);
-	EQEmu::MemoryMappedFile mmf("shared/spells", size);
+	uint32 size = GetSpellsSegmentSize(records);
+	uint32 generation = EQEmu::SharedMemoryGeneration::Next("spells");
+	EQEmu::MemoryMappedFile mmf(EQEmu::SharedMemoryGeneration::FileName("shared/spells", generation), size);
 	mmf.ZeroFile();
 
 	void *ptr = mmf.Get();
-	database->LoadSpells(ptr, records);
+	if(!database->LoadSpells(ptr, records)) {
+		EQ_EXCEPT("Shared Memory", "Unable to load spells from the database.");
+	}
+	EQEmu::SharedMemoryGeneration::Publish("spells", generation);
+	EQEmu::SharedMemoryGeneration::Retire("shared/spells", generation);
 	mutex.Unlock();
 }
 
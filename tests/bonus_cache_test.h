@@ -0,0 +1,202 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_BONUS_CACHE_H
+#define __EQEMU_TESTS_BONUS_CACHE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/bonus_cache.h"
+#include <string.h>
+
+//the parts of StatBonuses the sources depend on each other through
+struct TestBonuses {
+	int32 ItemATKCap;
+	bool NegateEffects;
+	int32 STR;
+	int32 ATK;
+	int32 HP;
+};
+
+//stands in for a client: what each source is worth, how they are summed, and the working bonuses
+struct TestBonusClient {
+	int32 item_str;
+	int32 item_atk;
+	int32 spell_str;
+	int32 spell_atk_cap;
+	bool negate;
+	int32 aa_hp;
+	int32 aa_atk_cap;
+
+	TestBonuses itembonuses;
+	TestBonuses spellbonuses;
+	TestBonuses aabonuses;
+	EQEmu::BonusCache<TestBonuses> cache;
+
+	TestBonusClient() : item_str(10), item_atk(50), spell_str(0), spell_atk_cap(0), negate(false), aa_hp(0), aa_atk_cap(0) {
+		memset(&itembonuses, 0, sizeof(TestBonuses));
+		memset(&spellbonuses, 0, sizeof(TestBonuses));
+		memset(&aabonuses, 0, sizeof(TestBonuses));
+	}
+
+	//like Client::AddItemBonuses, item ATK is capped with whatever caps are in the working bonuses
+	void CalcAllItemBonuses(TestBonuses *b) {
+		b->STR += item_str;
+		int32 cap = 60 + itembonuses.ItemATKCap + spellbonuses.ItemATKCap + aabonuses.ItemATKCap;
+		b->ATK = item_atk > cap ? cap : item_atk;
+	}
+
+	//like Mob::NegateSpellsBonuses, a negate strips the item and AA bonuses in place
+	void CalcSpellBonuses(TestBonuses *b) {
+		memset(b, 0, sizeof(TestBonuses));
+		b->STR = spell_str;
+		b->ItemATKCap = spell_atk_cap;
+		b->NegateEffects = negate;
+		if(negate) {
+			itembonuses.STR = 0;
+			itembonuses.ATK = 0;
+			aabonuses.HP = 0;
+			aabonuses.ItemATKCap = 0;
+		}
+	}
+
+	void CalcAABonuses(TestBonuses *b) {
+		memset(b, 0, sizeof(TestBonuses));
+		b->HP = aa_hp;
+		b->ItemATKCap = aa_atk_cap;
+	}
+
+	//what Client::CalcBonuses() did before the cache
+	void FullCalc() {
+		memset(&itembonuses, 0, sizeof(TestBonuses));
+		CalcAllItemBonuses(&itembonuses);
+		CalcSpellBonuses(&spellbonuses);
+		CalcAABonuses(&aabonuses);
+	}
+
+	void Update(uint32 changed) {
+		cache.Update(*this, changed, itembonuses, spellbonuses, aabonuses);
+	}
+};
+
+class BonusCacheTest : public Test::Suite {
+	typedef void(BonusCacheTest::*TestFunction)(void);
+public:
+	BonusCacheTest() {
+		TEST_ADD(BonusCacheTest::NegateFadeTest);
+		TEST_ADD(BonusCacheTest::ItemsWhileNegatedTest);
+		TEST_ADD(BonusCacheTest::ATKCapTest);
+		TEST_ADD(BonusCacheTest::PartialParityTest);
+	}
+
+	~BonusCacheTest() {
+	}
+
+	private:
+	static bool Same(const TestBonuses &a, const TestBonuses &b) {
+		return a.ItemATKCap == b.ItemATKCap && a.NegateEffects == b.NegateEffects && a.STR == b.STR && a.ATK == b.ATK && a.HP == b.HP;
+	}
+
+	static bool Same(const TestBonusClient &a, const TestBonusClient &b) {
+		return Same(a.itembonuses, b.itembonuses) && Same(a.spellbonuses, b.spellbonuses) && Same(a.aabonuses, b.aabonuses);
+	}
+
+	void NegateFadeTest() {
+		TestBonusClient c;
+		c.aa_hp = 100;
+		c.Update(BonusSourceAll);
+		TEST_ASSERT(c.itembonuses.STR == 10);
+
+		c.negate = true;
+		c.Update(BonusSourceSpells);
+		TEST_ASSERT(c.itembonuses.STR == 0);
+
+		//the fade is a spell only update too
+		c.negate = false;
+		c.Update(BonusSourceSpells);
+		TEST_ASSERT(c.itembonuses.STR == 10);
+		TEST_ASSERT(c.itembonuses.ATK == 50);
+	}
+
+	void ItemsWhileNegatedTest() {
+		TestBonusClient c;
+		c.negate = true;
+		c.Update(BonusSourceAll);
+		TEST_ASSERT(c.itembonuses.STR == 0);
+
+		c.item_str = 25;
+		c.Update(BonusSourceItems);
+		TEST_ASSERT(c.itembonuses.STR == 0);
+
+		c.negate = false;
+		c.Update(BonusSourceSpells);
+		TEST_ASSERT(c.itembonuses.STR == 25);
+	}
+
+	void ATKCapTest() {
+		TestBonusClient partial, full;
+		partial.item_atk = full.item_atk = 80;
+		partial.Update(BonusSourceAll);
+		full.FullCalc();
+		TEST_ASSERT(partial.itembonuses.ATK == 60);
+
+		partial.spell_atk_cap = full.spell_atk_cap = 30;
+		partial.Update(BonusSourceSpells);
+		full.FullCalc();
+		TEST_ASSERT(Same(partial, full));
+
+		//the raised cap reaches the items one update later on both paths
+		partial.Update(BonusSourceNone);
+		full.FullCalc();
+		TEST_ASSERT(Same(partial, full));
+		TEST_ASSERT(partial.itembonuses.ATK == 80);
+	}
+
+	//random changes, each reported with only the source it touched, against recalculating everything every time
+	void PartialParityTest() {
+		TestBonusClient partial, full;
+		partial.Update(BonusSourceAll);
+		full.FullCalc();
+		TEST_ASSERT(Same(partial, full));
+
+		uint32 seed = 12345;
+		bool same = true;
+		for(int i = 0; i < 5000 && same; ++i) {
+			seed = seed * 1103515245 + 12345;
+			uint32 roll = (seed >> 16) % 8;
+			int32 value = (int32)((seed >> 8) % 40);
+			uint32 changed = BonusSourceNone;
+			switch(roll) {
+			case 0: partial.item_str = full.item_str = value; changed = BonusSourceItems; break;
+			case 1: partial.item_atk = full.item_atk = value * 3; changed = BonusSourceItems; break;
+			case 2: partial.spell_str = full.spell_str = value; changed = BonusSourceSpells; break;
+			case 3: partial.spell_atk_cap = full.spell_atk_cap = value; changed = BonusSourceSpells; break;
+			case 4: partial.negate = full.negate = !partial.negate; changed = BonusSourceSpells; break;
+			case 5: partial.aa_hp = full.aa_hp = value; changed = BonusSourceAAs; break;
+			case 6: partial.aa_atk_cap = full.aa_atk_cap = value; changed = BonusSourceAAs; break;
+			default: break;
+			}
+
+			partial.Update(changed);
+			full.FullCalc();
+			same = Same(partial, full);
+		}
+		TEST_ASSERT(same);
+	}
+};
+
+#endif
@@ -0,0 +1,144 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_LOG_QUEUE_H
+#define __EQEMU_TESTS_LOG_QUEUE_H
+
+#include "cppunit/cpptest.h"
+#include "../common/log_queue.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <string.h>
+#include <stdio.h>
+
+class LogQueueTest : public Test::Suite {
+	typedef void(LogQueueTest::*TestFunction)(void);
+public:
+	LogQueueTest() {
+		TEST_ADD(LogQueueTest::DrainOrderTest);
+		TEST_ADD(LogQueueTest::OverflowTest);
+		TEST_ADD(LogQueueTest::MultiProducerTest);
+	}
+
+	~LogQueueTest() {
+	}
+
+	private:
+	static bool Push(EQEmu::LogQueue &queue, uint8 id, uint32 value) {
+		EQEmu::LogQueue::Record *r = queue.Reserve();
+		if(r == nullptr)
+			return false;
+		r->id = id;
+		r->when = 0;
+		r->length = snprintf(r->text, sizeof(r->text), "%u", value);
+		queue.Commit(r);
+		return true;
+	}
+
+	void DrainOrderTest() {
+		std::unique_ptr<EQEmu::LogQueue> queue(new EQEmu::LogQueue);
+		TEST_ASSERT(queue->Peek() == nullptr);
+
+		//wraps around the ring a few times
+		uint32 next = 0;
+		for(uint32 round = 0; round < 5; ++round) {
+			for(uint32 i = 0; i < 1000; ++i)
+				TEST_ASSERT(Push(*queue, 1, round * 1000 + i));
+
+			EQEmu::LogQueue::Record *r;
+			while((r = queue->Peek()) != nullptr) {
+				TEST_ASSERT(r->id == 1);
+				TEST_ASSERT(strtoul(r->text, nullptr, 10) == next);
+				queue->Release(r);
+				++next;
+			}
+		}
+		TEST_ASSERT(next == 5000);
+	}
+
+	void OverflowTest() {
+		std::unique_ptr<EQEmu::LogQueue> queue(new EQEmu::LogQueue);
+		for(uint32 i = 0; i < EQEMU_LOG_QUEUE_SIZE; ++i)
+			TEST_ASSERT(Push(*queue, 2, i));
+
+		uint32 dropped = 0;
+		for(uint32 i = 0; i < 10; ++i) {
+			if(!Push(*queue, 2, 0))
+				dropped++;
+		}
+		TEST_ASSERT(dropped == 10);
+
+		//one slot back gives room for exactly one more
+		EQEmu::LogQueue::Record *r = queue->Peek();
+		TEST_ASSERT(r != nullptr);
+		TEST_ASSERT(strtoul(r->text, nullptr, 10) == 0);
+		queue->Release(r);
+		TEST_ASSERT(Push(*queue, 2, EQEMU_LOG_QUEUE_SIZE));
+		TEST_ASSERT(!Push(*queue, 2, 0));
+	}
+
+	//every message is either received once, in its producer's order, or counted as dropped
+	void MultiProducerTest() {
+		std::unique_ptr<EQEmu::LogQueue> queue(new EQEmu::LogQueue);
+		const uint32 producers = 4;
+		const uint32 count = 20000;
+		std::atomic<uint32> dropped(0);
+		std::atomic<uint32> finished(0);
+
+		std::vector<std::thread> threads;
+		for(uint32 p = 0; p < producers; ++p) {
+			threads.push_back(std::thread([&, p]() {
+				for(uint32 i = 0; i < count; ++i) {
+					if(!Push(*queue, (uint8)p, i))
+						dropped++;
+				}
+				finished++;
+			}));
+		}
+
+		std::vector<int64> last(producers, -1);
+		uint32 received = 0;
+		bool ordered = true;
+		for(;;) {
+			bool done = finished.load() == producers;
+			EQEmu::LogQueue::Record *r;
+			while((r = queue->Peek()) != nullptr) {
+				int64 value = strtoul(r->text, nullptr, 10);
+				if(r->id >= producers || value <= last[r->id])
+					ordered = false;
+				else
+					last[r->id] = value;
+				queue->Release(r);
+				received++;
+			}
+			if(done)
+				break;
+			std::this_thread::yield();
+		}
+
+		for(auto &t : threads)
+			t.join();
+
+		TEST_ASSERT(ordered);
+		TEST_ASSERT(received + dropped.load() == producers * count);
+	}
+};
+
+#endif
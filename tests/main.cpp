@@ -29,6 +29,11 @@
 #include "string_util_test.h"
 #include "data_verification_test.h"
 #include "skills_util_test.h"
+#include "packet_pool_test.h"
+#include "packet_compress_test.h"
+#include "wake_event_test.h"
+#include "log_queue_test.h"
+#include "bonus_cache_test.h"
 
 int main() {
 	try {
@@ -44,6 +49,11 @@ int main() {
 		tests.add(new StringUtilTest());
 		tests.add(new DataVerificationTest());
 		tests.add(new SkillsUtilsTest());
+		tests.add(new PacketPoolTest());
+		tests.add(new PacketCompressTest());
+		tests.add(new WakeEventTest());
+		tests.add(new LogQueueTest());
+		tests.add(new BonusCacheTest());
 		tests.run(*output, true);
 	} catch(...) {
 		return -1;
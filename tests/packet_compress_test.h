@@ -0,0 +1,121 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_PACKET_COMPRESS_H
+#define __EQEMU_TESTS_PACKET_COMPRESS_H
+
+#include "cppunit/cpptest.h"
+#include "../common/eq_packet.h"
+#include "../common/packet_functions.h"
+#include <string.h>
+
+//exposes the protected wire helpers
+class CompressProbe : public EQProtocolPacket {
+public:
+	using EQProtocolPacket::Compress;
+	using EQProtocolPacket::Decompress;
+};
+
+class PacketCompressTest : public Test::Suite {
+	typedef void(PacketCompressTest::*TestFunction)(void);
+public:
+	PacketCompressTest() {
+		TEST_ADD(PacketCompressTest::RoundTripTest);
+		TEST_ADD(PacketCompressTest::IncompressibleTest);
+		TEST_ADD(PacketCompressTest::AdaptiveSkipTest);
+	}
+
+	~PacketCompressTest() {
+	}
+
+	private:
+
+	//OP_Packet header with the given app opcode, followed by payload
+	uint32 BuildPacket(unsigned char *buffer, uint16 app_opcode, bool compressible, uint32 length) {
+		buffer[0] = 0;
+		buffer[1] = 0x09;
+		buffer[2] = 0;
+		buffer[3] = 1;
+		buffer[4] = app_opcode & 0xff;
+		buffer[5] = app_opcode >> 8;
+		uint32 seed = 12345;
+		for(uint32 i = 6; i < length; ++i) {
+			seed = seed * 1103515245 + 12345;
+			buffer[i] = compressible ? (unsigned char)(i % 7) : (unsigned char)(seed >> 16);
+		}
+		return length;
+	}
+
+	void RoundTripTest() {
+		unsigned char raw[512];
+		unsigned char packed[1024];
+		unsigned char unpacked[1024];
+		uint32 length = BuildPacket(raw, 0x1111, true, sizeof(raw));
+
+		uint32 packed_length = CompressProbe::Compress(raw, length, packed, sizeof(packed));
+		TEST_ASSERT(packed[2] == 0x5a);
+		TEST_ASSERT(packed_length < length);
+
+		//Decompress expects the two crc bytes on the end
+		packed[packed_length++] = 0xAB;
+		packed[packed_length++] = 0xCD;
+		uint32 unpacked_length = CompressProbe::Decompress(packed, packed_length, unpacked, sizeof(unpacked));
+		TEST_ASSERT(unpacked_length == length + 2);
+		TEST_ASSERT(memcmp(raw, unpacked, length) == 0);
+	}
+
+	void IncompressibleTest() {
+		unsigned char raw[256];
+		unsigned char packed[512];
+		uint32 length = BuildPacket(raw, 0x2222, false, sizeof(raw));
+
+		uint32 packed_length = CompressProbe::Compress(raw, length, packed, sizeof(packed));
+		TEST_ASSERT(packed[2] == 0xa5);
+		TEST_ASSERT(packed_length == length + 1);
+		TEST_ASSERT(memcmp(raw + 2, packed + 3, length - 2) == 0);
+	}
+
+	void AdaptiveSkipTest() {
+		unsigned char raw[256];
+		unsigned char packed[512];
+
+		//teach it that this opcode never shrinks
+		BuildPacket(raw, 0x3333, false, sizeof(raw));
+		for(int i = 0; i < 16; ++i)
+			CompressProbe::Compress(raw, sizeof(raw), packed, sizeof(packed));
+
+		//compressible payloads under the same opcode now go out raw until a reprobe
+		BuildPacket(raw, 0x3333, true, sizeof(raw));
+		CompressProbe::Compress(raw, sizeof(raw), packed, sizeof(packed));
+		TEST_ASSERT(packed[2] == 0xa5);
+
+		bool reprobed = false;
+		for(int i = 0; i < 64 && !reprobed; ++i) {
+			CompressProbe::Compress(raw, sizeof(raw), packed, sizeof(packed));
+			reprobed = packed[2] == 0x5a;
+		}
+		TEST_ASSERT(reprobed);
+
+		//a different opcode is unaffected
+		BuildPacket(raw, 0x4444, true, sizeof(raw));
+		CompressProbe::Compress(raw, sizeof(raw), packed, sizeof(packed));
+		TEST_ASSERT(packed[2] == 0x5a);
+	}
+};
+
+#endif
@@ -0,0 +1,99 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_PACKET_POOL_H
+#define __EQEMU_TESTS_PACKET_POOL_H
+
+#include "cppunit/cpptest.h"
+#include "../common/eq_packet.h"
+
+class PacketPoolTest : public Test::Suite {
+	typedef void(PacketPoolTest::*TestFunction)(void);
+public:
+	PacketPoolTest() {
+		TEST_ADD(PacketPoolTest::BufferReuseTest);
+		TEST_ADD(PacketPoolTest::OversizeBufferTest);
+		TEST_ADD(PacketPoolTest::ObjectCountTest);
+		TEST_ADD(PacketPoolTest::CombineTest);
+	}
+
+	~PacketPoolTest() {
+	}
+
+	private:
+
+	void BufferReuseTest() {
+		uint32 capacity = 0;
+		unsigned char *first = PacketPool::AllocBuffer(100, capacity);
+		TEST_ASSERT(capacity >= 100);
+		PacketPool::FreeBuffer(first, capacity);
+
+		uint32 second_capacity = 0;
+		unsigned char *second = PacketPool::AllocBuffer(90, second_capacity);
+		TEST_ASSERT(second == first);
+		TEST_ASSERT(second_capacity == capacity);
+		PacketPool::FreeBuffer(second, second_capacity);
+	}
+
+	void OversizeBufferTest() {
+		uint32 capacity = 0;
+		unsigned char *buffer = PacketPool::AllocBuffer(100000, capacity);
+		TEST_ASSERT(buffer != nullptr);
+		TEST_ASSERT(capacity == 100000);
+		PacketPool::FreeBuffer(buffer, capacity);
+	}
+
+	void ObjectCountTest() {
+		PacketPool::Stats objects_before, buffers_before;
+		PacketPool::GetStats(objects_before, buffers_before);
+
+		EQProtocolPacket *p = new EQProtocolPacket(0x09, nullptr, 32);
+		delete p;
+
+		PacketPool::Stats objects_after, buffers_after;
+		PacketPool::GetStats(objects_after, buffers_after);
+		TEST_ASSERT(objects_after.allocations == objects_before.allocations + 1);
+		TEST_ASSERT(objects_after.frees == objects_before.frees + 1);
+		TEST_ASSERT(buffers_after.allocations == buffers_before.allocations + 1);
+		TEST_ASSERT(buffers_after.frees == buffers_before.frees + 1);
+	}
+
+	void CombineTest() {
+		unsigned char a[10] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+		unsigned char b[6] = { 11, 12, 13, 14, 15, 16 };
+		EQProtocolPacket *first = new EQProtocolPacket(0x09, a, sizeof(a));
+		EQProtocolPacket *second = new EQProtocolPacket(0x09, b, sizeof(b));
+		EQProtocolPacket *third = new EQProtocolPacket(0x09, b, sizeof(b));
+
+		TEST_ASSERT(first->combine(second));
+		TEST_ASSERT(first->combine(third));
+		// three length-prefixed sub packets, each with a 2 byte opcode
+		TEST_ASSERT_EQUALS(first->size, (uint32)(1 + 2 + 10 + 1 + 2 + 6 + 1 + 2 + 6));
+		TEST_ASSERT(first->pBuffer[0] == 12);
+		TEST_ASSERT(memcmp(first->pBuffer + 3, a, sizeof(a)) == 0);
+		TEST_ASSERT(first->pBuffer[13] == 8);
+		TEST_ASSERT(memcmp(first->pBuffer + 16, b, sizeof(b)) == 0);
+		TEST_ASSERT(memcmp(first->pBuffer + 25, b, sizeof(b)) == 0);
+
+		delete first;
+		delete second;
+		delete third;
+	}
+};
+
+#endif
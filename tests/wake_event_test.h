@@ -0,0 +1,92 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2013 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef __EQEMU_TESTS_WAKE_EVENT_H
+#define __EQEMU_TESTS_WAKE_EVENT_H
+
+#include "cppunit/cpptest.h"
+#include "../common/wake_event.h"
+#include <atomic>
+#include <thread>
+
+class WakeEventTest : public Test::Suite {
+	typedef void(WakeEventTest::*TestFunction)(void);
+public:
+	WakeEventTest() {
+		TEST_ADD(WakeEventTest::TimeoutTest);
+		TEST_ADD(WakeEventTest::SignalBeforeWaitTest);
+		TEST_ADD(WakeEventTest::CoalesceTest);
+		TEST_ADD(WakeEventTest::CrossThreadTest);
+	}
+
+	~WakeEventTest() {
+	}
+
+	private:
+	void TimeoutTest() {
+		EQEmu::WakeEvent ev;
+		TEST_ASSERT(!ev.Wait(0));
+		TEST_ASSERT(!ev.Wait(5));
+	}
+
+	void SignalBeforeWaitTest() {
+		EQEmu::WakeEvent ev;
+		ev.Signal();
+		TEST_ASSERT(ev.Wait(1000));
+		TEST_ASSERT(!ev.Wait(0));
+	}
+
+	void CoalesceTest() {
+		EQEmu::WakeEvent ev;
+		ev.Signal();
+		ev.Signal();
+		ev.Signal();
+		TEST_ASSERT(ev.Wait(1000));
+		TEST_ASSERT(!ev.Wait(0));
+	}
+
+	//every signal raced against the waiter has to wake it, a lost one shows up as a timeout
+	void CrossThreadTest() {
+		EQEmu::WakeEvent ev;
+		std::atomic<uint32> sent(0);
+		const uint32 count = 2000;
+
+		std::thread producer([&]() {
+			for(uint32 i = 0; i < count; ++i) {
+				sent++;
+				ev.Signal();
+				if(i % 16 == 0)
+					std::this_thread::yield();
+			}
+		});
+
+		uint32 timeouts = 0;
+		uint32 seen = 0;
+		while(seen < count && timeouts < 3) {
+			if(!ev.Wait(1000) && sent.load() != seen)
+				timeouts++;
+			seen = sent.load();
+		}
+		producer.join();
+
+		TEST_ASSERT(timeouts == 0);
+		TEST_ASSERT(seen == count);
+	}
+};
+
+#endif
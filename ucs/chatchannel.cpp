@@ -25,6 +25,7 @@
 
 extern Database database;
 extern uint32 ChatMessagesSent;
+extern std::string WorldShortName;
 
 ChatChannel::ChatChannel(std::string inName, std::string inOwner, std::string inPassword, bool inPermanent, int inMinimumStatus) :
 	DeleteTimer(0) {
@@ -62,28 +63,19 @@ ChatChannel* ChatChannelList::CreateChannel(std::string Name, std::string Owner,
 
 	ChatChannels.Insert(NewChannel);
 
+	ChannelIndex[NewChannel->Name] = NewChannel;
+
 	return NewChannel;
 }
 
 ChatChannel* ChatChannelList::FindChannel(std::string Name) {
 
-	std::string NormalisedName = CapitaliseName(Name);
-
-	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		ChatChannel *CurrentChannel = iterator.GetData();
-
-		if(CurrentChannel && (CurrentChannel->Name == NormalisedName))
-			return iterator.GetData();
+	auto Iterator = ChannelIndex.find(CapitaliseName(Name));
 
-		iterator.Advance();
-	}
+	if(Iterator == ChannelIndex.end())
+		return nullptr;
 
-	return nullptr;
+	return Iterator->second;
 }
 
 void ChatChannelList::SendAllChannels(Client *c) {
@@ -150,6 +142,11 @@ void ChatChannelList::RemoveChannel(ChatChannel *Channel) {
 
 	_log(UCS__TRACE, "RemoveChannel(%s)", Channel->GetName().c_str());
 
+	auto Indexed = ChannelIndex.find(Channel->Name);
+
+	if((Indexed != ChannelIndex.end()) && (Indexed->second == Channel))
+		ChannelIndex.erase(Indexed);
+
 	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
 
 	iterator.Reset();
@@ -171,6 +168,8 @@ void ChatChannelList::RemoveAllChannels() {
 
 	_log(UCS__TRACE, "RemoveAllChannels");
 
+	ChannelIndex.clear();
+
 	LinkedListIterator<ChatChannel*> iterator(ChatChannels);
 
 	iterator.Reset();
@@ -255,6 +254,8 @@ void ChatChannel::AddClient(Client *c) {
 
 	ClientsInChannel.Insert(c);
 
+	ClientIndex.insert(c);
+
 }
 
 bool ChatChannel::RemoveClient(Client *c) {
@@ -269,6 +270,8 @@ bool ChatChannel::RemoveClient(Client *c) {
 
 	int PlayersInChannel = 0;
 
+	ClientIndex.erase(c);
+
 	LinkedListIterator<Client*> iterator(ClientsInChannel);
 
 	iterator.Reset();
@@ -386,6 +389,13 @@ void ChatChannel::SendMessageToChannel(std::string Message, Client* Sender) {
 
 	ChatMessagesSent++;
 
+	std::string FQSenderName = WorldShortName + "." + Sender->GetName();
+
+	// One packet per client version, built the first time a member of that version is reached.
+	EQApplicationPacket *OldClientPacket = nullptr;
+
+	EQApplicationPacket *NewClientPacket = nullptr;
+
 	LinkedListIterator<Client*> iterator(ClientsInChannel);
 
 	iterator.Reset();
@@ -398,11 +408,23 @@ void ChatChannel::SendMessageToChannel(std::string Message, Client* Sender) {
 		{
 			_log(UCS__TRACE, "Sending message to %s from %s",
 					ChannelClient->GetName().c_str(), Sender->GetName().c_str());
-			ChannelClient->SendChannelMessage(Name, Message, Sender);
+
+			EQApplicationPacket *&outapp = ChannelClient->IsUnderfootOrLater() ? NewClientPacket : OldClientPacket;
+
+			if(!outapp) {
+				outapp = Client::MakeChannelMessage(Name, FQSenderName, Message, ChannelClient->IsUnderfootOrLater());
+				_pkt(UCS__PACKETS, outapp);
+			}
+
+			ChannelClient->QueuePacket(outapp);
 		}
 
 		iterator.Advance();
 	}
+
+	safe_delete(OldClientPacket);
+
+	safe_delete(NewClientPacket);
 }
 
 void ChatChannel::SetModerated(bool inModerated) {
@@ -433,19 +455,7 @@ bool ChatChannel::IsClientInChannel(Client *c) {
 
 	if(!c) return false;
 
-	LinkedListIterator<Client*> iterator(ClientsInChannel);
-
-	iterator.Reset();
-
-	while(iterator.MoreElements()) {
-
-		if(iterator.GetData() == c)
-			return true;
-
-		iterator.Advance();
-	}
-
-	return false;
+	return (ClientIndex.find(c) != ClientIndex.end());
 }
 
 ChatChannel *ChatChannelList::AddClientToChannel(std::string ChannelName, Client *c) {
@@ -6,6 +6,8 @@
 #include "../common/timer.h"
 #include <string>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
 
 class Client;
 
@@ -59,6 +61,7 @@ private:
 	Timer DeleteTimer;
 
 	LinkedList<Client*> ClientsInChannel;
+	std::unordered_set<Client*> ClientIndex;	// same members as ClientsInChannel, for membership tests
 
 	std::list<std::string> Moderators;
 	std::list<std::string> Invitees;
@@ -82,6 +85,7 @@ public:
 private:
 
 	LinkedList<ChatChannel*> ChatChannels;
+	std::unordered_map<std::string, ChatChannel*> ChannelIndex;	// keyed by the capitalised channel name
 
 };
 
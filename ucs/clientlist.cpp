@@ -1499,6 +1499,17 @@ void Client::SendChannelMessage(std::string ChannelName, std::string Message, Cl
 
 	std::string FQSenderName = WorldShortName + "." + Sender->GetName();
 
+	auto outapp = MakeChannelMessage(ChannelName, FQSenderName, Message, UnderfootOrLater);
+
+	_pkt(UCS__PACKETS, outapp);
+	QueuePacket(outapp);
+
+	safe_delete(outapp);
+}
+
+// The packet only depends on the client version, so a channel builds it once per version and queues it to every member.
+EQApplicationPacket *Client::MakeChannelMessage(const std::string &ChannelName, const std::string &FQSenderName, const std::string &Message, bool UnderfootOrLater) {
+
 	int PacketLength = ChannelName.length() + Message.length() + FQSenderName.length() + 3;
 
 	if(UnderfootOrLater)
@@ -1515,10 +1526,7 @@ void Client::SendChannelMessage(std::string ChannelName, std::string Message, Cl
 	if(UnderfootOrLater)
 		VARSTRUCT_ENCODE_STRING(PacketBuffer, "SPAM:0:");
 
-	_pkt(UCS__PACKETS, outapp);
-	QueuePacket(outapp);
-
-	safe_delete(outapp);
+	return outapp;
 }
 
 void Client::ToggleAnnounce(std::string State)
@@ -100,6 +100,8 @@ public:
 	void RemoveFromChannelList(ChatChannel *JoinedChannel);
 	void SendChannelMessage(std::string Message);
 	void SendChannelMessage(std::string ChannelName, std::string Message, Client *Sender);
+	static EQApplicationPacket *MakeChannelMessage(const std::string &ChannelName, const std::string &FQSenderName, const std::string &Message, bool UnderfootOrLater);
+	inline bool IsUnderfootOrLater() { return UnderfootOrLater; }
 	void SendChannelMessageByNumber(std::string Message);
 	void SendChannelList();
 	void CloseConnection();
@@ -178,6 +180,7 @@ public:
 	Clientlist(int MailPort);
 	void	Process();
 	void	CloseAllConnections();
+	void	SetWakeEvent(EQEmu::WakeEvent *ev) { chatsf->SetWakeEvent(ev); }
 	Client *FindCharacter(std::string CharacterName);
 	void	CheckForStaleConnections(Client *c);
 	Client *IsCharacterOnline(std::string CharacterName);
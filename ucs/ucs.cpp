@@ -25,6 +25,7 @@
 #include "../common/servertalk.h"
 #include "../common/platform.h"
 #include "../common/crash.h"
+#include "../common/event_loop.h"
 #include "database.h"
 #include "ucsconfig.h"
 #include "chatchannel.h"
@@ -147,6 +148,12 @@ int main() {
 
 	worldserver->Connect();
 
+	EQEmu::EventLoop main_loop(1000);
+	main_loop.WatchTimer(&ChannelListProcessTimer);
+	main_loop.WatchTimer(&InterserverTimer);
+	CL->SetWakeEvent(main_loop.GetWakeEvent());
+	worldserver->SetWakeEvent(main_loop.GetWakeEvent());
+
 	while(RunLoops) {
 
 		Timer::SetCurrentTime();
@@ -164,9 +171,12 @@ int main() {
 
 		timeout_manager.CheckTimeouts();
 
-		Sleep(100);
+		main_loop.Wait();
 	}
 
+	CL->SetWakeEvent(nullptr);
+	worldserver->SetWakeEvent(nullptr);
+
 	ChannelList->RemoveAllChannels();
 
 	CL->CloseAllConnections();
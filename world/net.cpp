@@ -38,8 +38,12 @@
 #include "../common/guilds.h"
 #include "../common/eq_stream_ident.h"
 #include "../common/rulesys.h"
+#include "../common/packet_functions.h"
 #include "../common/platform.h"
 #include "../common/crash.h"
+#include "../common/event_loop.h"
+#include "../common/shared_memory_generation.h"
+#include "../common/string_util.h"
 #include "client.h"
 #include "worlddb.h"
 #ifdef _WINDOWS
@@ -82,6 +86,7 @@
 #include "launcher_list.h"
 #include "wguild_mgr.h"
 #include "lfplist.h"
+#include "raidlist.h"
 #include "adventure_manager.h"
 #include "ucs.h"
 #include "queryserv.h"
@@ -91,6 +96,7 @@ EQStreamFactory eqsf(WorldStream,9000);
 EmuTCPServer tcps;
 ClientList client_list;
 GroupLFPList LFPGroupList;
+RaidList raid_list;
 ZSList zoneserver_list;
 LoginServerList loginserverlist;
 EQWHTTPServer http_server;
@@ -108,6 +114,11 @@ bool holdzones = false;
 extern ConsoleList console_list;
 
 void CatchSignal(int sig_num);
+void CheckSharedMemoryGenerations(bool notify);
+
+// segments built by shared_memory, and the generation of each we last told the zones about
+static const char *shared_memory_segments[] = { "items", "faction", "loot", "skill_caps", "spells", "base_data" };
+static uint32 shared_memory_generations[sizeof(shared_memory_segments) / sizeof(shared_memory_segments[0])];
 
 int main(int argc, char** argv) {
 	RegisterExecutablePlatform(ExePlatformWorld);
@@ -318,6 +329,7 @@ int main(int argc, char** argv) {
 				_log(WORLD__INIT, "Loaded default rule set 'default'", tmp);
 			}
 		}
+		SetDeflateLevel(RuleI(Network, CompressionLevel));
 	}
 	if(RuleB(World, ClearTempMerchantlist)){
 		_log(WORLD__INIT, "Clearing temporary merchant lists..");
@@ -358,6 +370,10 @@ int main(int argc, char** argv) {
 	Timer PurgeInstanceTimer(450000);
 	PurgeInstanceTimer.Start(450000);
 
+	// shared_memory can be rerun while we are up; zones remap what it rebuilt
+	CheckSharedMemoryGenerations(false);
+	Timer SharedMemoryTimer(10000);
+
 	_log(WORLD__INIT, "Loading char create info...");
 	database.LoadCharacterCreateAllocations();
 	database.LoadCharacterCreateCombos();
@@ -391,6 +407,16 @@ int main(int argc, char** argv) {
 	EmuTCPConnection* tcpc;
 	EQStreamInterface *eqsi;
 
+	//client streams and zone/launcher/ucs/qs links wake us directly; the rest of world's
+	//timers live inside the various lists, so they are serviced at the 50ms cap
+	EQEmu::EventLoop main_loop(50);
+	main_loop.WatchTimer(&PurgeInstanceTimer);
+	main_loop.WatchTimer(&InterserverTimer);
+	main_loop.WatchTimer(&SharedMemoryTimer);
+	eqsf.SetWakeEvent(main_loop.GetWakeEvent());
+	tcps.SetWakeEvent(main_loop.GetWakeEvent());
+	database.SetAsyncWakeEvent(main_loop.GetWakeEvent());
+
 	while(RunLoops) {
 		Timer::SetCurrentTime();
 
@@ -447,6 +473,9 @@ int main(int argc, char** argv) {
 			database.PurgeExpiredInstances();
 		}
 
+		if (SharedMemoryTimer.Check())
+			CheckSharedMemoryGenerations(true);
+
 		//check for timeouts in other threads
 		timeout_manager.CheckTimeouts();
 
@@ -464,6 +493,8 @@ int main(int argc, char** argv) {
 
 		LFPGroupList.Process();
 
+		raid_list.Process();
+
 		adventure_manager.Process();
 
 		if (InterserverTimer.Check()) {
@@ -483,12 +514,13 @@ int main(int argc, char** argv) {
 				}
 			}
 		}
-		if (numclients == 0) {
-			Sleep(50);
-			continue;
-		}
-		Sleep(20);
+		database.ProcessAsyncResults();
+
+		main_loop.Wait();
 	}
+	eqsf.SetWakeEvent(nullptr);
+	tcps.SetWakeEvent(nullptr);
+	database.SetAsyncWakeEvent(nullptr);
 	_log(WORLD__SHUTDOWN,"World main loop completed.");
 	_log(WORLD__SHUTDOWN,"Shutting down console connections (if any).");
 	console_list.KillAll();
@@ -505,6 +537,34 @@ int main(int argc, char** argv) {
 	return 0;
 }
 
+void CheckSharedMemoryGenerations(bool notify) {
+	bool changed = false;
+	for (size_t i = 0; i < sizeof(shared_memory_segments) / sizeof(shared_memory_segments[0]); ++i) {
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current(shared_memory_segments[i]);
+		if (generation == shared_memory_generations[i])
+			continue;
+
+		shared_memory_generations[i] = generation;
+		changed = true;
+		if (!notify)
+			continue;
+
+		_log(WORLD__INIT, "Shared memory %s is now generation %u, notifying zones", shared_memory_segments[i], generation);
+		auto pack = new ServerPacket(ServerOP_SharedMemoryGeneration, sizeof(ServerSharedMemoryGeneration_Struct));
+		ServerSharedMemoryGeneration_Struct *smg = (ServerSharedMemoryGeneration_Struct*)pack->pBuffer;
+		strn0cpy(smg->segment, shared_memory_segments[i], sizeof(smg->segment));
+		smg->generation = generation;
+		zoneserver_list.SendPacket(pack);
+		safe_delete(pack);
+	}
+
+	if (changed && notify) {
+		if (!database.ReloadSharedMemory())
+			_log(WORLD__INIT_ERR, "Reloading shared memory failed, keeping the previous generation of the failed segments");
+		ClearPatchItemCaches();
+	}
+}
+
 void CatchSignal(int sig_num) {
 	_log(WORLD__SHUTDOWN,"Caught signal %d",sig_num);
 	if(zoneserver_list.worldclock.saveFile(WorldConfig::get()->EQTimeFile.c_str())==false)
@@ -0,0 +1,153 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/debug.h"
+#include "../common/string_util.h"
+#include "raidlist.h"
+#include "zonelist.h"
+#include "worlddb.h"
+
+extern ZSList zoneserver_list;
+
+RaidList::RaidList()
+{
+}
+
+void RaidList::ApplyDelta(ServerRaidMemberDelta_Struct *delta)
+{
+	delta->member.name[63] = 0;
+
+	if (delta->action == RaidDeltaDisband) {
+		raids.erase(delta->rid);
+		changed_raids.erase(delta->rid);
+		disbanded_raids.insert(delta->rid);
+		delta->version = 0;
+		return;
+	}
+
+	RaidEntry &raid = raids[delta->rid];
+	std::string name = delta->member.name;
+
+	if (delta->action == RaidDeltaRemove) {
+		raid.members.erase(name);
+	}
+	else {
+		std::map<std::string, ServerRaidMember_Struct>::iterator iter = raid.members.find(name);
+		// zones that never had the character loaded don't know its id
+		if (delta->member.charid == 0 && iter != raid.members.end())
+			delta->member.charid = iter->second.charid;
+		raid.members[name] = delta->member;
+	}
+
+	raid.changed.insert(name);
+	changed_raids.insert(delta->rid);
+	delta->version = ++raid.version;
+}
+
+void RaidList::SendSnapshot(ServerRaidSnapshotRequest_Struct *request)
+{
+	uint32 count = 0;
+	uint32 version = 0;
+	std::map<uint32, RaidEntry>::iterator raid = raids.find(request->rid);
+	if (raid != raids.end()) {
+		count = raid->second.members.size();
+		version = raid->second.version;
+	}
+
+	ServerPacket *pack = new ServerPacket(ServerOP_RaidSnapshot, sizeof(ServerRaidSnapshot_Struct) + count * sizeof(ServerRaidMember_Struct));
+	ServerRaidSnapshot_Struct *snapshot = (ServerRaidSnapshot_Struct*)pack->pBuffer;
+	snapshot->rid = request->rid;
+	snapshot->version = version;
+	snapshot->count = count;
+
+	if (count > 0) {
+		uint32 index = 0;
+		std::map<std::string, ServerRaidMember_Struct>::iterator iter;
+		for (iter = raid->second.members.begin(); iter != raid->second.members.end(); ++iter)
+			snapshot->members[index++] = iter->second;
+	}
+
+	zoneserver_list.SendPacket(request->zoneid, request->instance_id, pack);
+	safe_delete(pack);
+}
+
+void RaidList::Process()
+{
+	if (changed_raids.empty() && disbanded_raids.empty())
+		return;
+
+	std::set<uint32>::iterator rid;
+	for (rid = disbanded_raids.begin(); rid != disbanded_raids.end(); ++rid)
+		database.ClearRaid(*rid);
+	disbanded_raids.clear();
+
+	std::string replace;
+	std::set<uint32> failed;	//left changed so the next Process() writes them again
+	for (rid = changed_raids.begin(); rid != changed_raids.end(); ++rid) {
+		RaidEntry &raid = raids[*rid];
+		std::string removed;
+
+		std::set<std::string>::iterator name;
+		for (name = raid.changed.begin(); name != raid.changed.end(); ++name) {
+			std::map<std::string, ServerRaidMember_Struct>::iterator iter = raid.members.find(*name);
+			if (iter == raid.members.end()) {
+				removed += removed.empty() ? "'" : ", '";
+				removed += EscapeString(*name);
+				removed += "'";
+				continue;
+			}
+
+			ServerRaidMember_Struct &m = iter->second;
+			replace += replace.empty() ? "(" : ", (";
+			replace += StringFormat("%u, %u, %u, %u, %u, '%s', %u, %u, %u", m.charid, *rid, m.groupid,
+				m._class, m.level, EscapeString(m.name).c_str(), m.isgroupleader, m.israidleader, m.islooter);
+			replace += ")";
+		}
+
+		if (!removed.empty()) {
+			std::string query = StringFormat("DELETE FROM raid_members WHERE raidid = %u AND name IN (%s)",
+				*rid, removed.c_str());
+			auto results = database.QueryDatabase(query);
+			if (!results.Success()) {
+				LogFile->write(EQEmuLog::Error, "Error removing raid members: %s", results.ErrorMessage().c_str());
+				failed.insert(*rid);
+			}
+		}
+	}
+
+	if (!replace.empty()) {
+		std::string query = "REPLACE INTO raid_members (charid, raidid, groupid, _class, level, name, "
+			"isgroupleader, israidleader, islooter) VALUES " + replace;
+		auto results = database.QueryDatabase(query);
+		if (!results.Success()) {
+			LogFile->write(EQEmuLog::Error, "Error saving raid members: %s", results.ErrorMessage().c_str());
+			failed = changed_raids;
+		}
+	}
+
+	for (rid = changed_raids.begin(); rid != changed_raids.end(); ++rid) {
+		if (failed.count(*rid))
+			continue;
+
+		RaidEntry &raid = raids[*rid];
+		raid.changed.clear();
+		if (raid.members.empty())
+			raids.erase(*rid);
+	}
+	changed_raids.swap(failed);
+}
@@ -0,0 +1,56 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#ifndef RAIDLIST_H
+#define RAIDLIST_H
+
+#include "../common/servertalk.h"
+#include <map>
+#include <set>
+#include <string>
+
+/*
+	World keeps the membership of every raid. Zones send their changes here as
+	deltas, the raid's version is bumped and the delta goes back out to every
+	zone, which apply it to their copy without touching the database.
+	raid_members is written from here, batched once per world loop pass.
+*/
+class RaidList {
+public:
+	RaidList();
+
+	// Stamps delta with the raid's new version; the caller forwards it to the zones
+	void ApplyDelta(ServerRaidMemberDelta_Struct *delta);
+	void SendSnapshot(ServerRaidSnapshotRequest_Struct *request);
+	// Saves the members changed since the last call
+	void Process();
+
+private:
+	struct RaidEntry {
+		RaidEntry() : version(0) { }
+		uint32 version;
+		std::map<std::string, ServerRaidMember_Struct> members;
+		std::set<std::string> changed;
+	};
+
+	std::map<uint32, RaidEntry> raids;
+	std::set<uint32> changed_raids;
+	std::set<uint32> disbanded_raids;
+};
+
+#endif
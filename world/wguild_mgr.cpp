@@ -98,6 +98,9 @@ void WorldGuildManager::ProcessZonePacket(ServerPacket *pack) {
 		//preform the local update
 		client_list.UpdateClientGuild(s->char_id, s->guild_id);
 
+		//zones apply the changed member to their rosters before they act on the refresh
+		RefreshMember(s->char_id);
+
 		//broadcast this update to any zone with a member in this guild.
 		//client_list.SendGuildPacket(s->guild_id, pack);
 		//because im sick of this not working, sending it to all zones, just spends a bit more bandwidth.
@@ -132,15 +135,132 @@ void WorldGuildManager::ProcessZonePacket(ServerPacket *pack) {
 			_log(GUILDS__ERROR, "Received ServerOP_GuildMemberUpdate of incorrect size %d, expected %d", pack->size, sizeof(ServerGuildMemberUpdate_Struct));
 			return;
 		}
+		ServerGuildMemberUpdate_Struct *s = (ServerGuildMemberUpdate_Struct *) pack->pBuffer;
+
+		//they changed zones or logged off, which is when level and last login get saved
+		CharGuildInfo *member = FindCachedMember(s->GuildID, s->MemberName);
+		if(member != nullptr)
+			RefreshMember(member->char_id);
+
+		zoneserver_list.SendPacket(pack);
+
+		break;
+	}
+
+	case ServerOP_GuildRankUpdate: {
+		if(pack->size != sizeof(ServerGuildRankUpdate_Struct))
+		{
+			_log(GUILDS__ERROR, "Received ServerOP_GuildRankUpdate of incorrect size %d, expected %d", pack->size, sizeof(ServerGuildRankUpdate_Struct));
+			return;
+		}
+		ServerGuildRankUpdate_Struct *s = (ServerGuildRankUpdate_Struct *) pack->pBuffer;
+
+		CharGuildInfo *member = FindCachedMember(s->GuildID, s->MemberName);
+		if(member != nullptr) {
+			member->rank = s->Rank;
+			member->banker = (s->Banker & 1) != 0;
+			member->alt = (s->Banker & 2) != 0;
+		}
 
 		zoneserver_list.SendPacket(pack);
 
 		break;
 	}
 
+	case ServerOP_GuildRosterRequest: {
+		if(pack->size != sizeof(ServerGuildRosterRequest_Struct))
+		{
+			_log(GUILDS__ERROR, "Received ServerOP_GuildRosterRequest of incorrect size %d, expected %d", pack->size, sizeof(ServerGuildRosterRequest_Struct));
+			return;
+		}
+		ServerGuildRosterRequest_Struct *s = (ServerGuildRosterRequest_Struct *) pack->pBuffer;
+
+		if(GetRoster(s->guild_id) == nullptr && !LoadRoster(s->guild_id)) {
+			_log(GUILDS__ERROR, "Unable to load the roster of guild %d for zone %d", s->guild_id, s->zone_id);
+
+			//the zone holds its waiters until we answer
+			auto reply = new ServerPacket(ServerOP_GuildRoster, sizeof(ServerGuildRoster_Struct));
+			ServerGuildRoster_Struct *r = (ServerGuildRoster_Struct *) reply->pBuffer;
+			r->guild_id = s->guild_id;
+			r->first = 1;
+			r->last = 1;
+			r->failed = 1;
+			r->count = 0;
+			zoneserver_list.SendPacket(s->zone_id, s->instance_id, reply);
+			safe_delete(reply);
+			return;
+		}
+
+		SendRoster(s->guild_id, s->zone_id, s->instance_id);
+
+		break;
+	}
+
 	default:
 		_log(GUILDS__ERROR, "Unknown packet 0x%x received from zone??", pack->opcode);
 		break;
 	}
 }
 
+void WorldGuildManager::SendRoster(uint32 guild_id, uint32 zone_id, uint16 instance_id) {
+	const GuildRoster *roster = GetRoster(guild_id);
+	if(roster == nullptr)
+		return;
+
+	//kept to a modest size per packet, large guilds span several
+	const uint32 per_packet = 100;
+	uint32 remaining = roster->size();
+	bool first = true;
+	GuildRoster::const_iterator cur = roster->begin();
+
+	do {
+		uint32 count = remaining < per_packet ? remaining : per_packet;
+		auto pack = new ServerPacket(ServerOP_GuildRoster, sizeof(ServerGuildRoster_Struct) + count * sizeof(ServerGuildMember_Struct));
+		ServerGuildRoster_Struct *s = (ServerGuildRoster_Struct *) pack->pBuffer;
+		s->guild_id = guild_id;
+		s->first = first;
+		s->last = (remaining == count);
+		s->failed = 0;
+		s->count = count;
+		for(uint32 r = 0; r < count; r++, ++cur)
+			PackMember(cur->second, &s->members[r]);
+
+		zoneserver_list.SendPacket(zone_id, instance_id, pack);
+		safe_delete(pack);
+
+		remaining -= count;
+		first = false;
+	} while(remaining > 0);
+
+	_log(GUILDS__REFRESH, "Sent the %d member roster of guild %d to zone %d", roster->size(), guild_id, zone_id);
+}
+
+void WorldGuildManager::RefreshMember(uint32 char_id) {
+	if(m_rosters.empty())
+		return;
+
+	CharGuildInfo *cached = FindCachedMember(char_id);
+	uint32 old_guild_id = cached ? cached->guild_id : GUILD_NONE;
+
+	CharGuildInfo info;
+	if(!DBGetCharInfo(char_id, info)) {
+		if(cached == nullptr)
+			return;
+		//character is gone, take them off the roster
+		info = *cached;
+		info.guild_id = GUILD_NONE;
+	}
+
+	//nobody holds a roster this member belongs to
+	if(cached == nullptr && GetRoster(info.guild_id) == nullptr)
+		return;
+
+	StoreMember(info);
+
+	auto pack = new ServerPacket(ServerOP_GuildMemberDelta, sizeof(ServerGuildMemberDelta_Struct));
+	ServerGuildMemberDelta_Struct *s = (ServerGuildMemberDelta_Struct *) pack->pBuffer;
+	s->old_guild_id = old_guild_id;
+	PackMember(info, &s->member);
+	zoneserver_list.SendPacket(pack);
+	safe_delete(pack);
+}
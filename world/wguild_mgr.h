@@ -21,6 +21,9 @@ protected:
 	virtual void SendRankUpdate(uint32 CharID) { return; }
 	virtual void SendGuildDelete(uint32 guild_id);
 
+	void SendRoster(uint32 guild_id, uint32 zone_id, uint16 instance_id);
+	void RefreshMember(uint32 char_id);	//reloads one cached member and tells the zones
+
 	//map<uint32, uint32> m_tribute;	//map from guild ID to current tribute ammount
 };
 
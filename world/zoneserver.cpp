@@ -33,12 +33,14 @@
 #include "cliententry.h"
 #include "wguild_mgr.h"
 #include "lfplist.h"
+#include "raidlist.h"
 #include "adventure_manager.h"
 #include "ucs.h"
 #include "queryserv.h"
 
 extern ClientList client_list;
 extern GroupLFPList LFPGroupList;
+extern RaidList raid_list;
 extern ZSList zoneserver_list;
 extern ConsoleList console_list;
 extern LoginServerList loginserverlist;
@@ -417,6 +419,23 @@ bool ZoneServer::Process() {
 				break;
 			}
 
+			case ServerOP_RaidMemberDelta: {
+				if (pack->size != sizeof(ServerRaidMemberDelta_Struct))
+					break;
+
+				raid_list.ApplyDelta((ServerRaidMemberDelta_Struct*)pack->pBuffer);
+				zoneserver_list.SendPacket(pack);
+				break;
+			}
+
+			case ServerOP_RaidSnapshotRequest: {
+				if (pack->size != sizeof(ServerRaidSnapshotRequest_Struct))
+					break;
+
+				raid_list.SendSnapshot((ServerRaidSnapshotRequest_Struct*)pack->pBuffer);
+				break;
+			}
+
 			case ServerOP_SpawnCondition: {
 				if(pack->size != sizeof(ServerSpawnCondition_Struct))
 					break;
@@ -846,15 +865,12 @@ bool ZoneServer::Process() {
 				break;
 			}
 
-			case ServerOP_GuildRankUpdate:
-			{
-				zoneserver_list.SendPacket(pack);
-				break;
-			}
 			//these opcodes get processed by the guild manager.
 			case ServerOP_RefreshGuild:
 			case ServerOP_DeleteGuild:
 			case ServerOP_GuildCharRefresh:
+			case ServerOP_GuildRankUpdate:
+			case ServerOP_GuildRosterRequest:
 			case ServerOP_GuildMemberUpdate: {
 				guild_mgr.ProcessZonePacket(pack);
 				break;
@@ -1057,7 +1057,7 @@ void Client::BuyAA(AA_Action* action)
 
 		SendAAStats();
 
-		CalcBonuses();
+		UpdateBonuses(BonusSourceAAs);
 		if(title_manager.IsNewAATitleAvailable(m_pp.aapoints_spent, GetBaseClass()))
 			NotifyNewTitlesAvailable();
 	}
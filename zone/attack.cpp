@@ -1955,6 +1955,8 @@ bool NPC::Attack(Mob* other, int Hand, bool bRiposte, bool IsStrikethrough, bool
 }
 
 void NPC::Damage(Mob* other, int32 damage, uint16 spell_id, SkillUseTypes attack_skill, bool avoidable, int8 buffslot, bool iBuffTic) {
+	Wake();
+
 	if(spell_id==0)
 		spell_id = SPELL_UNKNOWN;
 
@@ -2408,6 +2410,9 @@ void Mob::AddToHateList(Mob* other, uint32 hate /*= 0*/, int32 damage /*= 0*/, b
 	if (other == this)
 		return;
 
+	if (IsNPC())
+		CastToNPC()->Wake();
+
 	if(damage < 0){
 		hate = 1;
 	}
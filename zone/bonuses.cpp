@@ -71,16 +71,26 @@ void NPC::CalcBonuses()
 
 void Client::CalcBonuses()
 {
-	memset(&itembonuses, 0, sizeof(StatBonuses));
-	CalcItemBonuses(&itembonuses);
-	CalcEdibleBonuses(&itembonuses);
+	UpdateBonuses(BonusSourceAll);
+}
 
-	CalcSpellBonuses(&spellbonuses);
+// Recomputes only the contributors that changed (plus any left dirty by an earlier
+// update), then rebuilds the derived stats from the resulting bonuses.
+void Client::UpdateBonuses(uint32 changed_sources)
+{
+	bonus_cache.Update(*this, changed_sources, itembonuses, spellbonuses, aabonuses);
 
-	_log(AA__BONUSES, "Calculating AA Bonuses for %s.", this->GetCleanName());
-	CalcAABonuses(&aabonuses);	//we're not quite ready for this
-	_log(AA__BONUSES, "Finished calculating AA Bonuses for %s.", this->GetCleanName());
+	CalcDerivedStats();
+}
 
+void Client::CalcAllItemBonuses(StatBonuses* newbon)
+{
+	CalcItemBonuses(newbon);
+	CalcEdibleBonuses(newbon);
+}
+
+void Client::CalcDerivedStats()
+{
 	RecalcWeight();
 
 	CalcAC();
@@ -581,6 +591,7 @@ void Client::CalcEdibleBonuses(StatBonuses* newbon) {
 }
 
 void Client::CalcAABonuses(StatBonuses* newbon) {
+	_log(AA__BONUSES, "Calculating AA Bonuses for %s.", this->GetCleanName());
 	memset(newbon, 0, sizeof(StatBonuses));	//start fresh
 
 	int i;
@@ -601,6 +612,7 @@ void Client::CalcAABonuses(StatBonuses* newbon) {
 			}
 		}
 	}
+	_log(AA__BONUSES, "Finished calculating AA Bonuses for %s.", this->GetCleanName());
 }
 
 
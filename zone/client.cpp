@@ -678,6 +678,72 @@ void Client::QueuePacket(const EQApplicationPacket* app, bool ack_req, CLIENT_CO
 			eqs->QueuePacket(app, ack_req);
 }
 
+// interval 0 sends app now, otherwise it replaces whatever update of the spawn is still waiting
+void Client::QueuePositionUpdate(const EQApplicationPacket* app, uint32 interval) {
+	const PlayerPositionUpdateServer_Struct *spu = (const PlayerPositionUpdateServer_Struct*)app->pBuffer;
+
+	if(interval == 0) {
+		//an older update still waiting would move the spawn back once it went out
+		position_updates.erase(spu->spawn_id);
+		QueuePacket(app, false, CLIENT_CONNECTED);
+		return;
+	}
+
+	//a new entry starts zeroed, so the first update of a spawn is sent on the next pass
+	PendingPositionUpdate &entry = position_updates[spu->spawn_id];
+	memcpy(&entry.update, spu, sizeof(PlayerPositionUpdateServer_Struct));
+	entry.interval = interval;
+	entry.pending = true;
+}
+
+void Client::DiscardPositionUpdate(uint16 spawn_id) {
+	position_updates.erase(spawn_id);
+}
+
+void Client::SendPendingPositionUpdates() {
+	if(position_updates.empty())
+		return;
+
+	uint32 now = Timer::GetCurrentTime();
+	EQApplicationPacket *outapp = nullptr;
+
+	auto iter = position_updates.begin();
+	while(iter != position_updates.end()) {
+		PendingPositionUpdate &entry = iter->second;
+
+		if(!entry.pending) {
+			//once the interval is up a new update goes straight out anyway
+			if(now >= entry.next_send)
+				iter = position_updates.erase(iter);
+			else
+				++iter;
+			continue;
+		}
+
+		if(now < entry.next_send) {
+			++iter;
+			continue;
+		}
+
+		//the spawn went away since the update was queued
+		if(entity_list.GetMob(iter->first) == nullptr) {
+			iter = position_updates.erase(iter);
+			continue;
+		}
+
+		if(outapp == nullptr)
+			outapp = new EQApplicationPacket(OP_ClientUpdate, sizeof(PlayerPositionUpdateServer_Struct));
+		memcpy(outapp->pBuffer, &entry.update, sizeof(PlayerPositionUpdateServer_Struct));
+		QueuePacket(outapp, false, CLIENT_CONNECTED);
+
+		entry.pending = false;
+		entry.next_send = now + entry.interval;
+		++iter;
+	}
+
+	safe_delete(outapp);
+}
+
 void Client::FastQueuePacket(EQApplicationPacket** app, bool ack_req, CLIENT_CONN_STATUS required_state) {
 	// if the program doesnt care about the status or if the status isnt what we requested
 	if (required_state != CLIENT_CONNECTINGALL && client_state != required_state) {
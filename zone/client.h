@@ -290,6 +290,9 @@ public:
 	void SendPacketQueue(bool Block = true);
 	void QueuePacket(const EQApplicationPacket* app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL, eqFilterType filter=FilterNone);
 	void FastQueuePacket(EQApplicationPacket** app, bool ack_req = true, CLIENT_CONN_STATUS = CLIENT_CONNECTINGALL);
+	void QueuePositionUpdate(const EQApplicationPacket* app, uint32 interval);
+	void DiscardPositionUpdate(uint16 spawn_id);
+	void SendPendingPositionUpdates();
 	void ChannelMessageReceived(uint8 chan_num, uint8 language, uint8 lang_skill, const char* orig_message, const char* targetname=nullptr);
 	void ChannelMessageSend(const char* from, const char* to, uint8 chan_num, uint8 language, const char* message, ...);
 	void ChannelMessageSend(const char* from, const char* to, uint8 chan_num, uint8 language, uint8 lang_skill, const char* message, ...);
@@ -408,6 +411,7 @@ public:
 	*/
 
 	virtual void CalcBonuses();
+	virtual void UpdateBonuses(uint32 changed_sources);
 	//these are all precalculated now
 	inline virtual int32 GetAC() const { return AC; }
 	inline virtual int32 GetATK() const { return ATK + itembonuses.ATK + spellbonuses.ATK + ((GetSTR() + GetSkill(SkillOffense)) * 9 / 10); }
@@ -634,7 +638,7 @@ public:
 	void SendGuildChannel();
 	void SendGuildSpawnAppearance();
 	void SendGuildRanks();
-	void SendGuildMembers();
+	void SendGuildMembers(bool ask_world = true);
 	void SendGuildList();
 	void SendGuildJoin(GuildJoin_Struct* gj);
 	void RefreshGuildInfo();
@@ -1253,12 +1257,15 @@ public:
 
 protected:
 	friend class Mob;
+	template<class Bonuses> friend class EQEmu::BonusCache;
 	void CalcItemBonuses(StatBonuses* newbon);
 	void AddItemBonuses(const ItemInst *inst, StatBonuses* newbon, bool isAug = false, bool isTribute = false);
 	int CalcRecommendedLevelBonus(uint8 level, uint8 reclevel, int basestat);
 	void CalcEdibleBonuses(StatBonuses* newbon);
+	void CalcAllItemBonuses(StatBonuses* newbon);
 	void CalcAABonuses(StatBonuses* newbon);
 	void ApplyAABonuses(uint32 aaid, uint32 slots, StatBonuses* newbon);
+	void CalcDerivedStats();
 	void MakeBuffFadePacket(uint16 spell_id, int slot_id, bool send_message = true);
 	bool client_data_loaded;
 
@@ -1290,6 +1297,15 @@ protected:
 
 private:
 	eqFilterMode ClientFilters[_FilterCount];
+
+	// Latest OP_ClientUpdate of each spawn this client sees at a reduced rate, keyed by spawn id
+	struct PendingPositionUpdate {
+		PlayerPositionUpdateServer_Struct update;
+		uint32 interval;
+		uint32 next_send; // Timer::GetCurrentTime() the spawn may next be sent at
+		bool pending;
+	};
+	std::map<uint16, PendingPositionUpdate> position_updates;
 	int32 HandlePacket(const EQApplicationPacket *app);
 	void OPTGB(const EQApplicationPacket *app);
 	void OPRezzAnswer(uint32 Action, uint32 SpellID, uint16 ZoneID, uint16 InstanceID, float x, float y, float z);
@@ -1515,6 +1531,7 @@ private:
 	uint32 ClientVersionBit;
 
 	int XPRate;
+	EQEmu::BonusCache<StatBonuses> bonus_cache;
 
 	bool m_ShadowStepExemption;
 	bool m_KnockBackExemption;
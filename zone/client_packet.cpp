@@ -538,13 +538,14 @@ void Client::CompleteConnect()
 			if (raid->GetID() != 0){
 				entity_list.AddRaid(raid, raidid);
 				raid->LoadLeadership(); // Recreating raid in new zone, get leadership from DB
+				raid->LearnMembers();
+				raid->RequestSnapshot(); // world may not have saved its latest changes yet
 			}
 			else
 				raid = nullptr;
 		}
 		if (raid){
 			SetRaidGrouped(true);
-			raid->LearnMembers();
 			raid->VerifyRaid();
 			raid->GetRaidDetails();
 			/*
@@ -3135,7 +3136,7 @@ void Client::Handle_OP_AugmentItem(const EQApplicationPacket *app)
 						
 						if (PutItemInInventory(slot_id, *itemOneToPush, true))
 						{
-							CalcBonuses();
+							UpdateBonuses(BonusSourceItems);
 							// Successfully added an augment to the item
 							return;
 						}
@@ -3212,7 +3213,7 @@ void Client::Handle_OP_AugmentItem(const EQApplicationPacket *app)
 
 				if (PutItemInInventory(MainCursor, *itemTwoToPush, true))
 				{
-					CalcBonuses();
+					UpdateBonuses(BonusSourceItems);
 					//Message(15, "Successfully removed an augmentation!");
 				}
 			}
@@ -4620,7 +4621,7 @@ void Client::Handle_OP_ClientUpdate(const EQApplicationPacket *app)
 		if (gmhideme)
 			entity_list.QueueClientsStatus(this,outapp,true,Admin(),250);
 		else
-			entity_list.QueueCloseClients(this,outapp,true,300,nullptr,false);
+			entity_list.QueuePositionUpdate(this, outapp, true, 300);
 		safe_delete(outapp);
 	}
 
@@ -36,6 +36,7 @@
 	#include <unistd.h>
 #endif
 
+#include "../common/rdtsc.h"
 #include "../common/rulesys.h"
 #include "../common/skills.h"
 #include "../common/spdat.h"
@@ -69,6 +70,9 @@ bool Client::Process() {
 			SendAllPackets();
 		}
 
+		if(Connected())
+			SendPendingPositionUpdates();
+
 		if(adventure_request_timer)
 		{
 			if(adventure_request_timer->Check())
@@ -631,7 +635,7 @@ bool Client::Process() {
 			if(m_pp.intoxication > 0)
 			{
 				--m_pp.intoxication;
-				CalcBonuses();
+				UpdateBonuses(BonusSourceNone);
 			}
 
 			if(ItemTickTimer.Check())
@@ -867,6 +871,7 @@ void Client::BulkSendInventoryItems() {
 	//for r from 0 to pos
 	//	safe_delete(pos[r]);
 
+	RDTSC_Timer send_timer(true);
 	uint32 size = 0;
 	uint16 i = 0;
 	std::map<uint16, std::string> ser_items;
@@ -923,6 +928,10 @@ void Client::BulkSendInventoryItems() {
 	}
 	QueuePacket(outapp);
 	safe_delete(outapp);
+
+	// includes the per-client SerializeItem pass done when the packet is encoded
+	send_timer.stop();
+	mlog(INVENTORY__SLOTS, "Sent %u inventory items (%u bytes) in %.3f ms", i, size, send_timer.getDuration());
 }
 /*#else
 void Client::BulkSendInventoryItems()
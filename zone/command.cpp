@@ -8838,6 +8838,34 @@ void command_netstats(Client *c, const Seperator *sep)
 			c->Message(0, "Recieved:");
 			c->Message(0, "Total: %u, per second: %u", c->Connection()->GetBytesRecieved(), c->Connection()->GetBytesRecvPerSecond());
 		}
+
+		EQStreamInterface *stream = (c->GetTarget() && c->GetTarget()->IsClient()) ? c->GetTarget()->CastToClient()->Connection() : c->Connection();
+		uint32 seq_sent = stream->GetSequencedSent();
+		uint32 seq_resent = stream->GetSequencedResent();
+		c->Message(0, "Sequenced: %u sent, %u resent (%.2f%%), rtt %ums", seq_sent, seq_resent,
+			seq_sent ? (float)seq_resent * 100.0f / (float)seq_sent : 0.0f, stream->GetRoundTripTime());
+
+		// allocation rate is measured against the previous #netstats in this zone
+		static uint32 last_check = 0;
+		static uint64 last_allocations = 0;
+
+		PacketPool::Stats objects, buffers;
+		PacketPool::GetStats(objects, buffers);
+
+		uint32 now = Timer::GetCurrentTime();
+		uint64 allocations = objects.allocations + buffers.allocations;
+		uint32 elapsed = now - last_check;
+
+		c->Message(0, "Packet pool:");
+		c->Message(0, "Objects: %llu allocated, %llu from pool, %llu freed, %llu parked", (unsigned long long)objects.allocations,
+			(unsigned long long)objects.pool_hits, (unsigned long long)objects.frees, (unsigned long long)objects.pooled);
+		c->Message(0, "Buffers: %llu allocated, %llu from pool, %llu freed, %llu parked", (unsigned long long)buffers.allocations,
+			(unsigned long long)buffers.pool_hits, (unsigned long long)buffers.frees, (unsigned long long)buffers.pooled);
+		if (last_check && elapsed > 0)
+			c->Message(0, "Allocations per second since last check: %llu", (unsigned long long)((allocations - last_allocations) * 1000 / elapsed));
+
+		last_check = now;
+		last_allocations = allocations;
 	}
 }
 
@@ -474,6 +474,30 @@ void EntityList::CorpseProcess()
 	}
 }
 
+// NPCs with no client within Zone:NPCDormantRange go dormant, and wake once one comes back in range
+void EntityList::UpdateDormantNPCs()
+{
+	float range = RuleR(Zone, NPCDormantRange);
+	float range2 = range * range;
+
+	auto it = npc_list.begin();
+	while (it != npc_list.end()) {
+		NPC *npc = it->second;
+		++it;
+
+		bool client_near = range <= 0;
+		for (auto client_it = client_list.begin(); !client_near && client_it != client_list.end(); ++client_it) {
+			if (client_it->second->DistNoRoot(*npc) <= range2)
+				client_near = true;
+		}
+
+		if (client_near)
+			npc->Wake();
+		else if (!npc->IsDormant() && npc->CanGoDormant())
+			npc->GoDormant();
+	}
+}
+
 void EntityList::MobProcess()
 {
 #ifdef IDLE_WHEN_EMPTY
@@ -486,7 +510,11 @@ void EntityList::MobProcess()
 		Mob *mob = it->second;
 		
 		size_t sz = mob_list.size();
-		bool p_val = mob->Process();
+		bool p_val;
+		if (mob->IsNPC() && mob->CastToNPC()->IsDormant())
+			p_val = mob->CastToNPC()->DormantProcess();
+		else
+			p_val = mob->Process();
 		size_t a_sz = mob_list.size();
 		
 		if(a_sz > sz) {
@@ -1464,6 +1492,46 @@ void EntityList::QueueClients(Mob *sender, const EQApplicationPacket *app,
 	}
 }
 
+// Observers near the sender get the update now, farther ones get the latest update of the sender
+// at the rate of their range tier, sent from Client::Process()
+void EntityList::QueuePositionUpdate(Mob *sender, const EQApplicationPacket *app,
+		bool ignore_sender, float dist)
+{
+	float near_range = RuleR(Zone, PositionUpdateNearRange);
+	float mid_range = RuleR(Zone, PositionUpdateMidRange);
+	float near2 = near_range * near_range;
+	float mid2 = mid_range * mid_range;
+	float dist2 = dist * dist;
+	uint32 mid_interval = RuleI(Zone, PositionUpdateMidInterval);
+	uint32 far_interval = RuleI(Zone, PositionUpdateFarInterval);
+
+	auto it = client_list.begin();
+	while (it != client_list.end()) {
+		Client *ent = it->second;
+		++it;
+
+		if ((ignore_sender && ent == sender) || !ent->Connected())
+			continue;
+
+		float ent_dist2 = ent->DistNoRoot(*sender);
+		if (dist > 0 && ent_dist2 > dist2)
+			continue;
+
+		if (ent_dist2 <= near2)
+			ent->QueuePositionUpdate(app, 0);
+		else if (ent_dist2 <= mid2)
+			ent->QueuePositionUpdate(app, mid_interval);
+		else
+			ent->QueuePositionUpdate(app, far_interval);
+	}
+}
+
+void EntityList::DiscardPositionUpdates(Mob *sender)
+{
+	for (auto it = client_list.begin(); it != client_list.end(); ++it)
+		it->second->DiscardPositionUpdate(sender->GetID());
+}
+
 void EntityList::QueueManaged(Mob *sender, const EQApplicationPacket *app,
 		bool ignore_sender, bool ackreq)
 {
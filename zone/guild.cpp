@@ -183,7 +183,13 @@ void Client::SendGuildList() {
 }
 
 
-void Client::SendGuildMembers() {
+void Client::SendGuildMembers(bool ask_world) {
+	//world keeps the roster, ask for it once and answer from memory after that
+	if(ask_world && GuildID() != GUILD_NONE && guild_mgr.GetRoster(GuildID()) == nullptr && worldserver.Connected()) {
+		guild_mgr.RequestRoster(GuildID(), CharacterID());
+		return;
+	}
+
 	uint32 len;
 	uint8 *data = guild_mgr.MakeGuildMembers(GuildID(), GetName(), len);
 	if(data == nullptr)
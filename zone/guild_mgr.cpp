@@ -113,14 +113,24 @@ uint8 *ZoneGuildManager::MakeGuildMembers(uint32 guild_id, const char *prefix_na
 		return(retbuffer);
 	}
 
-	std::vector<CharGuildInfo *> members;
-	if(!GetEntireGuild(guild_id, members))
-		return(nullptr);
+	//use the roster world sent us when we have it, otherwise go to the database.
+	std::vector<const CharGuildInfo *> members;
+	std::vector<CharGuildInfo *> loaded;
+	const GuildRoster *roster = GetRoster(guild_id);
+	if(roster != nullptr) {
+		GuildRoster::const_iterator rcur;
+		for(rcur = roster->begin(); rcur != roster->end(); ++rcur)
+			members.push_back(&rcur->second);
+	} else {
+		if(!GetEntireGuild(guild_id, loaded))
+			return(nullptr);
+		members.assign(loaded.begin(), loaded.end());
+	}
 
 	//figure out the actual packet length.
 	uint32 fixed_length = sizeof(Internal_GuildMembers_Struct) + members.size()*sizeof(Internal_GuildMemberEntry_Struct);
-	std::vector<CharGuildInfo *>::iterator cur, end;
-	CharGuildInfo *ci;
+	std::vector<const CharGuildInfo *>::iterator cur, end;
+	const CharGuildInfo *ci;
 	cur = members.begin();
 	end = members.end();
 	uint32 name_len = 0;
@@ -180,11 +190,12 @@ uint8 *ZoneGuildManager::MakeGuildMembers(uint32 guild_id, const char *prefix_na
 #undef SlideStructString
 #undef PutFieldN
 
-		delete *cur;
-
 		e++;
 	}
 
+	for(cur = members.begin(); cur != members.end() && roster == nullptr; ++cur)
+		delete *cur;
+
 	return(retbuffer);
 }
 
@@ -346,6 +357,13 @@ void ZoneGuildManager::ProcessWorldPacket(ServerPacket *pack) {
 
 			ServerGuildRankUpdate_Struct *sgrus = (ServerGuildRankUpdate_Struct*)pack->pBuffer;
 
+			CharGuildInfo *member = FindCachedMember(sgrus->GuildID, sgrus->MemberName);
+			if(member != nullptr) {
+				member->rank = sgrus->Rank;
+				member->banker = (sgrus->Banker & 1) != 0;
+				member->alt = (sgrus->Banker & 2) != 0;
+			}
+
 			EQApplicationPacket *outapp = new EQApplicationPacket(OP_SetGuildRank, sizeof(GuildSetRank_Struct));
 
 			GuildSetRank_Struct *gsrs = (GuildSetRank_Struct*)outapp->pBuffer;
@@ -406,6 +424,63 @@ void ZoneGuildManager::ProcessWorldPacket(ServerPacket *pack) {
 		}
 		break;
 	}
+	case ServerOP_GuildRoster:
+	{
+		if(pack->size < sizeof(ServerGuildRoster_Struct))
+		{
+			_log(GUILDS__ERROR, "Received ServerOP_GuildRoster of incorrect size %d", pack->size);
+			return;
+		}
+		ServerGuildRoster_Struct *s = (ServerGuildRoster_Struct *) pack->pBuffer;
+		if(pack->size != sizeof(ServerGuildRoster_Struct) + s->count * sizeof(ServerGuildMember_Struct))
+		{
+			_log(GUILDS__ERROR, "Received ServerOP_GuildRoster of incorrect size %d for %d members", pack->size, s->count);
+			return;
+		}
+
+		if(s->failed) {
+			_log(GUILDS__ERROR, "World could not load the roster of guild %d, reading it from the database", s->guild_id);
+			AnswerRosterWaiters(s->guild_id, false);
+			break;
+		}
+
+		if(s->first)
+			DropRoster(s->guild_id);
+
+		//make sure an empty guild still ends up with a roster
+		m_rosters[s->guild_id];
+
+		CharGuildInfo info;
+		for(uint32 r = 0; r < s->count; r++) {
+			UnpackMember(&s->members[r], info);
+			StoreMember(info);
+		}
+
+		if(!s->last)
+			break;
+
+		_log(GUILDS__REFRESH, "Received the %d member roster of guild %d from world", m_rosters[s->guild_id].size(), s->guild_id);
+
+		AnswerRosterWaiters(s->guild_id, true);
+		break;
+	}
+
+	case ServerOP_GuildMemberDelta:
+	{
+		if(pack->size != sizeof(ServerGuildMemberDelta_Struct))
+		{
+			_log(GUILDS__ERROR, "Received ServerOP_GuildMemberDelta of incorrect size %d, expected %d", pack->size, sizeof(ServerGuildMemberDelta_Struct));
+			return;
+		}
+		ServerGuildMemberDelta_Struct *s = (ServerGuildMemberDelta_Struct *) pack->pBuffer;
+
+		//ignored unless we hold a roster the member is leaving or joining
+		CharGuildInfo info;
+		UnpackMember(&s->member, info);
+		StoreMember(info);
+		break;
+	}
+
 	case ServerOP_OnlineGuildMembersResponse:
 		if (ZoneLoaded)
 		{
@@ -511,6 +586,62 @@ void ZoneGuildManager::RequestOnlineGuildMembers(uint32 FromID, uint32 GuildID)
 	safe_delete(pack);
 }
 
+void ZoneGuildManager::RequestRoster(uint32 guild_id, uint32 char_id)
+{
+	std::set<uint32> &waiters = m_rosterWaiters[guild_id];
+	bool pending = !waiters.empty();
+	waiters.insert(char_id);
+	if(pending)
+		return;	//already asked, they get it with everyone else
+
+	ServerPacket* pack = new ServerPacket(ServerOP_GuildRosterRequest, sizeof(ServerGuildRosterRequest_Struct));
+	ServerGuildRosterRequest_Struct *s = (ServerGuildRosterRequest_Struct*)pack->pBuffer;
+
+	s->guild_id = guild_id;
+	s->zone_id = zone ? zone->GetZoneID() : 0;
+	s->instance_id = zone ? zone->GetInstanceID() : 0;
+	worldserver.SendPacket(pack);
+
+	safe_delete(pack);
+}
+
+void ZoneGuildManager::AnswerRosterWaiters(uint32 guild_id, bool ask_world)
+{
+	std::map<uint32, std::set<uint32> >::iterator waiting = m_rosterWaiters.find(guild_id);
+	if(waiting == m_rosterWaiters.end())
+		return;
+
+	std::set<uint32> waiters;
+	waiters.swap(waiting->second);
+	m_rosterWaiters.erase(waiting);
+
+	std::set<uint32>::iterator cur;
+	for(cur = waiters.begin(); cur != waiters.end(); ++cur) {
+		Client *c = entity_list.GetClientByCharID(*cur);
+		if(c != nullptr && c->GuildID() == guild_id)
+			c->SendGuildMembers(ask_world);
+	}
+}
+
+void ZoneGuildManager::ClearRosters()
+{
+	BaseGuildManager::ClearRosters();
+
+	//anyone still waiting asks again, or reads the database if world is gone
+	std::map<uint32, std::set<uint32> > waiting;
+	waiting.swap(m_rosterWaiters);
+
+	std::map<uint32, std::set<uint32> >::iterator cur;
+	std::set<uint32>::iterator member;
+	for(cur = waiting.begin(); cur != waiting.end(); ++cur) {
+		for(member = cur->second.begin(); member != cur->second.end(); ++member) {
+			Client *c = entity_list.GetClientByCharID(*member);
+			if(c != nullptr)
+				c->SendGuildMembers();
+		}
+	}
+}
+
 void ZoneGuildManager::ProcessApproval()
 {
 	LinkedListIterator<GuildApproval*> iterator(list);
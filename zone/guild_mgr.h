@@ -5,6 +5,7 @@
 #include "../common/guild_base.h"
 #include <map>
 #include <list>
+#include <set>
 #include "../zone/petitions.h"
 
 extern PetitionList petition_list;
@@ -93,6 +94,9 @@ public:
 	bool VerifyAndClearInvite(uint32 char_id, uint32 guild_id, uint8 rank);
 	void SendGuildMemberUpdateToWorld(const char *MemberName, uint32 GuildID, uint16 ZoneID, uint32 LastSeen);
 	void RequestOnlineGuildMembers(uint32 FromID, uint32 GuildID);
+	void RequestRoster(uint32 guild_id, uint32 char_id);	//char_id gets their member list once world answers
+	void AnswerRosterWaiters(uint32 guild_id, bool ask_world);	//ask_world false reads the database when there is no roster
+	void ClearRosters();
 
 protected:
 	virtual void SendGuildRefresh(uint32 guild_id, bool name, bool motd, bool rank, bool relation);
@@ -101,6 +105,7 @@ protected:
 	virtual void SendGuildDelete(uint32 guild_id);
 
 	std::map<uint32, std::pair<uint32, uint8> > m_inviteQueue;	//map from char ID to guild,rank
+	std::map<uint32, std::set<uint32> > m_rosterWaiters;	//guild_id -> char IDs waiting on the roster from world
 
 private:
 	LinkedList<GuildApproval*> list;
@@ -884,7 +884,7 @@ void Client::PutLootInInventory(int16 slot_id, const ItemInst &inst, ServerLootI
 		}
 	}
 
-	CalcBonuses();
+	UpdateBonuses(BonusSourceItems);
 }
 bool Client::TryStacking(ItemInst* item, uint8 type, bool try_worn, bool try_cursor){
 	if(!item || !item->IsStackable() || item->GetCharges()>=item->GetItem()->StackSize)
@@ -896,7 +896,7 @@ bool Client::TryStacking(ItemInst* item, uint8 type, bool try_worn, bool try_cur
 		ItemInst* tmp_inst = m_inv.GetItem(i);
 		if(tmp_inst && tmp_inst->GetItem()->ID == item_id && tmp_inst->GetCharges() < tmp_inst->GetItem()->StackSize){
 			MoveItemCharges(*item, i, type);
-			CalcBonuses();
+			UpdateBonuses(BonusSourceItems);
 			if(item->GetCharges())	// we didn't get them all
 				return AutoPutLootInInventory(*item, try_worn, try_cursor, 0);
 			return true;
@@ -911,7 +911,7 @@ bool Client::TryStacking(ItemInst* item, uint8 type, bool try_worn, bool try_cur
 
 			if(tmp_inst && tmp_inst->GetItem()->ID == item_id && tmp_inst->GetCharges() < tmp_inst->GetItem()->StackSize){
 				MoveItemCharges(*item, slotid, type);
-				CalcBonuses();
+				UpdateBonuses(BonusSourceItems);
 				if(item->GetCharges())	// we didn't get them all
 					return AutoPutLootInInventory(*item, try_worn, try_cursor, 0);
 				return true;
@@ -1728,7 +1728,7 @@ bool Client::SwapItem(MoveItem_Struct* move_in) {
 	if(RuleB(QueryServ, PlayerLogMoves)) { QSSwapItemAuditor(move_in, true); } // QS Audit
 
 	// Step 8: Re-calc stats
-	CalcBonuses();
+	UpdateBonuses(BonusSourceItems);
 	return true;
 }
 
@@ -2652,7 +2652,7 @@ void Client::SetBandolier(const EQApplicationPacket *app) {
 		}
 	}
 	// finally, recalculate any stat bonuses from the item change
-	CalcBonuses();
+	UpdateBonuses(BonusSourceItems);
 }
 
 bool Client::MoveItemToInventory(ItemInst *ItemToReturn, bool UpdateClient) {
@@ -1206,6 +1206,7 @@ void Mob::SendPosition()
 	PlayerPositionUpdateServer_Struct* spu = (PlayerPositionUpdateServer_Struct*)app->pBuffer;
 	MakeSpawnUpdateNoDelta(spu);
 	move_tic_count = 0;
+	entity_list.DiscardPositionUpdates(this);
 	entity_list.QueueClients(this, app, true);
 	safe_delete(app);
 }
@@ -1224,12 +1225,12 @@ void Mob::SendPosUpdate(uint8 iSendToSelf) {
 	{
 		if(move_tic_count == RuleI(Zone, NPCPositonUpdateTicCount))
 		{
-			entity_list.QueueClients(this, app, (iSendToSelf==0), false);
+			entity_list.QueuePositionUpdate(this, app, (iSendToSelf==0));
 			move_tic_count = 0;
 		}
 		else
 		{
-			entity_list.QueueCloseClients(this, app, (iSendToSelf==0), 800, nullptr, false);
+			entity_list.QueuePositionUpdate(this, app, (iSendToSelf==0), 800);
 			move_tic_count++;
 		}
 	}
@@ -18,6 +18,7 @@
 #ifndef MOB_H
 #define MOB_H
 
+#include "../common/bonus_cache.h"
 #include "common.h"
 #include "entity.h"
 #include "hate_list.h"
@@ -375,6 +376,8 @@ public:
 	inline StatBonuses GetItemBonuses() const { return itembonuses; }
 	inline StatBonuses GetSpellBonuses() const { return spellbonuses; }
 	inline StatBonuses GetAABonuses() const { return aabonuses; }
+	// Recalculate bonuses after the given BonusSource contributors changed; mobs without per source caching do a full CalcBonuses()
+	virtual void UpdateBonuses(uint32 changed_sources) { CalcBonuses(); }
 	inline virtual int32 GetMaxSTR() const { return GetSTR(); }
 	inline virtual int32 GetMaxSTA() const { return GetSTA(); }
 	inline virtual int32 GetMaxDEX() const { return GetDEX(); }
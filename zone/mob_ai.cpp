@@ -82,16 +82,17 @@ bool NPC::AICastSpell(Mob* tar, uint8 iChance, uint16 iSpellTypes) {
 		if (iSpellTypes & AIspells[i].type) {
 			// manacost has special values, -1 is no mana cost, -2 is instant cast (no mana)
 			int32 mana_cost = AIspells[i].manacost;
+			// screen with the compact spells_hot columns, most entries fail here
 			if (mana_cost == -1)
-				mana_cost = spells[AIspells[i].spellid].mana;
+				mana_cost = spells_hot.mana[AIspells[i].spellid];
 			else if (mana_cost == -2)
 				mana_cost = 0;
 			if (
 				((
-					(spells[AIspells[i].spellid].targettype==ST_AECaster || spells[AIspells[i].spellid].targettype==ST_AEBard)
-					&& dist2 <= spells[AIspells[i].spellid].aoerange*spells[AIspells[i].spellid].aoerange
+					(spells_hot.targettype[AIspells[i].spellid]==ST_AECaster || spells_hot.targettype[AIspells[i].spellid]==ST_AEBard)
+					&& dist2 <= spells_hot.aoerange[AIspells[i].spellid]*spells_hot.aoerange[AIspells[i].spellid]
 				) ||
-				dist2 <= spells[AIspells[i].spellid].range*spells[AIspells[i].spellid].range
+				dist2 <= spells_hot.range[AIspells[i].spellid]*spells_hot.range[AIspells[i].spellid]
 				)
 				&& (mana_cost <= GetMana() || GetMana() == GetMaxMana())
 				&& (AIspells[i].time_cancast + (zone->random.Int(0, 4) * 1000)) <= Timer::GetCurrentTime() //break up the spelling casting over a period of time.
@@ -641,12 +642,12 @@ void Client::AI_SpellCast()
 			continue;
 		}
 
-		if(dist > spells[current_spell].range*spells[current_spell].range)
+		if(dist > spells_hot.range[current_spell]*spells_hot.range[current_spell])
 		{
 			continue;
 		}
 
-		if(GetMana() < spells[current_spell].mana)
+		if(GetMana() < spells_hot.mana[current_spell])
 		{
 			continue;
 		}
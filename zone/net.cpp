@@ -34,14 +34,17 @@
 #include "../common/eq_stream_ident.h"
 #include "../common/patches/patches.h"
 #include "../common/rulesys.h"
+#include "../common/packet_functions.h"
 #include "../common/misc_functions.h"
 #include "../common/string_util.h"
 #include "../common/platform.h"
 #include "../common/crash.h"
 #include "../common/ipc_mutex.h"
 #include "../common/memory_mapped_file.h"
+#include "../common/shared_memory_generation.h"
 #include "../common/eqemu_exception.h"
 #include "../common/spdat.h"
+#include "../common/wake_event.h"
 
 #include "zone_config.h"
 #include "masterentity.h"
@@ -54,6 +57,7 @@
 #include "titles.h"
 #include "guild_mgr.h"
 #include "tasks.h"
+#include "zone_host.h"
 
 #include "quest_parser_collection.h"
 #include "embparser.h"
@@ -61,14 +65,17 @@
 #include "client_logs.h"
 #include "questmgr.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <fstream>
 
 #include <stdlib.h>
 #include <stdio.h>
 #include <signal.h>
 #include <time.h>
+#include <sys/stat.h>
 
 #ifdef _CRTDBG_MAP_ALLOC
 	#undef new
@@ -80,6 +87,7 @@
 	#include <process.h>
 #else
 	#include <pthread.h>
+	#include <dirent.h>
 	#include "../common/unix.h"
 #endif
 
@@ -102,10 +110,17 @@ TaskManager *taskmanager = 0;
 QuestParserCollection *parse = 0;
 
 const SPDat_Spell_Struct* spells;
+SpellHotTable spells_hot;
 void LoadSpells(EQEmu::MemoryMappedFile **mmf);
 int32 SPDAT_RECORDS = -1;
+static EQEmu::MemoryMappedFile *spells_mmf = nullptr;
+static uint32 spells_generation = 0;
+static std::vector<EQEmu::MemoryMappedFile*> retired_spells_mmfs;
 
 void Shutdown();
+static void LoadRuleSet();
+static void StampHostedData();
+static void RefreshHostedZone();
 extern void MapOpcodes();
 
 int main(int argc, char** argv) {
@@ -113,10 +128,18 @@ int main(int argc, char** argv) {
 	set_exception_handler();
 
 	const char *zone_name;
+	int host_fd = -1;
+	std::string hosted_zone;
 
 	QServ = new QueryServ;
 
-	if(argc == 3) {
+	if(argc == 4 && strcmp(argv[1], "--host") == 0) {
+		//zone host, forks the zones eqlaunch asks for once everything below is loaded
+		host_fd = atoi(argv[2]);
+		worldserver.SetLauncherName(argv[3]);
+		worldserver.SetLaunchedName(".");
+		zone_name = ".";
+	} else if(argc == 3) {
 		worldserver.SetLauncherName(argv[2]);
 		worldserver.SetLaunchedName(argv[1]);
 		if(strncmp(argv[1], "dynamic_", 8) == 0) {
@@ -200,6 +223,10 @@ int main(int argc, char** argv) {
 	else
 		_log(ZONE__INIT, "Log settings loaded from %s", log_ini_file);
 
+	//before anything is loaded, see RefreshHostedZone()
+	if(host_fd != -1)
+		StampHostedData();
+
 	_log(ZONE__INIT, "Mapping Incoming Opcodes");
 	MapOpcodes();
 	_log(ZONE__INIT, "Loading Variables");
@@ -232,8 +259,7 @@ int main(int argc, char** argv) {
 	}
 
 	_log(ZONE__INIT, "Loading spells");
-	EQEmu::MemoryMappedFile *mmf = nullptr;
-	LoadSpells(&mmf);
+	LoadSpells(&spells_mmf);
 
 	_log(ZONE__INIT, "Loading base data");
 	if (!database.LoadBaseData()) {
@@ -252,6 +278,8 @@ int main(int argc, char** argv) {
 	database.LoadAAEffects();
 	_log(ZONE__INIT, "Loading tributes");
 	database.LoadTributes();
+	_log(ZONE__INIT, "Loading tradeskill recipes");
+	database.LoadTradeskillRecipes();
 	_log(ZONE__INIT, "Loading corpse timers");
 	database.GetDecayTimes(npcCorpseDecayTimes);
 	_log(ZONE__INIT, "Loading commands");
@@ -262,21 +290,7 @@ int main(int argc, char** argv) {
 		_log(ZONE__INIT, "%d commands loaded", retval);
 
 	//rules:
-	{
-		char tmp[64];
-		if (database.GetVariable("RuleSet", tmp, sizeof(tmp)-1)) {
-			_log(ZONE__INIT, "Loading rule set '%s'", tmp);
-			if(!RuleManager::Instance()->LoadRules(&database, tmp)) {
-				_log(ZONE__INIT_ERR, "Failed to load ruleset '%s', falling back to defaults.", tmp);
-			}
-		} else {
-			if(!RuleManager::Instance()->LoadRules(&database, "default")) {
-				_log(ZONE__INIT, "No rule set configured, using default rules");
-			} else {
-				_log(ZONE__INIT, "Loaded default rule set 'default'", tmp);
-			}
-		}
-	}
+	LoadRuleSet();
 
 	if(RuleB(TaskSystem, EnableTaskSystem)) {
 		_log(ZONE__INIT, "Loading Tasks");
@@ -299,6 +313,33 @@ int main(int argc, char** argv) {
 	_log(ZONE__INIT, "Loading quests");
 	parse->ReloadQuests();
 
+	if(host_fd != -1) {
+		//the zones can't share our connection, each makes its own after the fork
+		database.Close();
+		if(!ZoneHost::Serve(host_fd, hosted_zone))
+			return 0;
+
+		worldserver.SetLaunchedName(hosted_zone.c_str());
+		if(strncmp(hosted_zone.c_str(), "dynamic_", 8) == 0)
+			zone_name = ".";
+		else
+			zone_name = hosted_zone.c_str();
+
+		_log(ZONE__INIT, "Connecting to MySQL...");
+		if (!database.Connect(
+			Config->DatabaseHost.c_str(),
+			Config->DatabaseUsername.c_str(),
+			Config->DatabasePassword.c_str(),
+			Config->DatabaseDB.c_str(),
+			Config->DatabasePort)) {
+			_log(ZONE__INIT_ERR, "Cannot continue without a database connection.");
+			return 1;
+		}
+
+		//the host never hears from world, so whatever changed while it waited is picked up here
+		RefreshHostedZone();
+	}
+
 
 #ifdef CLIENT_LOGS
 	LogFile->SetAllCallbacks(ClientLogs::EQEmuIO_buf);
@@ -331,6 +372,12 @@ int main(int argc, char** argv) {
 	_log(COMMON__THREADS, "Main thread running with thread id %d", pthread_self());
 #endif
 
+	//lets the main loop sleep until its next deadline but wake as soon as world or a client sends us something
+	EQEmu::WakeEvent loop_wake;
+	eqsf.SetWakeEvent(&loop_wake);
+	worldserver.SetWakeEvent(&loop_wake);
+	database.SetAsyncWakeEvent(&loop_wake);
+
 	Timer quest_timers(100);
 	UpdateWindowTitle();
 	bool worldwasconnected = worldserver.Connected();
@@ -349,6 +396,9 @@ int main(int argc, char** argv) {
 		//process stuff from world
 		worldserver.Process();
 
+		//finish any database work that was handed off to the pool
+		database.ProcessAsyncResults();
+
 		if (!eqsf.IsOpen() && Config->ZonePort!=0) {
 			_log(ZONE__INIT, "Starting EQ Network server on port %d",Config->ZonePort);
 			if (!eqsf.Open(Config->ZonePort)) {
@@ -425,6 +475,9 @@ int main(int argc, char** argv) {
 
 				entity_list.Process();
 
+				if(net.dormant_timer.Check())
+					entity_list.UpdateDormantNPCs();
+
 				entity_list.MobProcess();
 
 				entity_list.BeaconProcess();
@@ -476,9 +529,21 @@ int main(int argc, char** argv) {
 #endif
 #endif
 		}	//end extra profiler block
-		Sleep(ZoneTimerResolution);
+
+		//block until the next timer we service is due, everything else is driven by loop_wake
+		Timer::SetCurrentTime();
+		uint32 wait = InterserverTimer.GetRemainingTime();
+		if (ZoneLoaded)
+			wait = std::min(wait, zoneupdate_timer.GetRemainingTime());
+		wait = std::min(wait, (uint32)ZoneMaxLoopWait);
+		if (wait > 0)
+			loop_wake.Wait(wait);
 	}
 
+	eqsf.SetWakeEvent(nullptr);
+	worldserver.SetWakeEvent(nullptr);
+	database.SetAsyncWakeEvent(nullptr);
+
 	entity_list.Clear();
 
 	parse->ClearInterfaces();
@@ -491,7 +556,9 @@ int main(int argc, char** argv) {
 	safe_delete(lua_parser);
 #endif
 
-	safe_delete(mmf);
+	safe_delete(spells_mmf);
+	for (size_t i = 0; i < retired_spells_mmfs.size(); ++i)
+		safe_delete(retired_spells_mmfs[i]);
 	safe_delete(Config);
 
 	if (zone != 0)
@@ -574,7 +641,8 @@ NetConnection::NetConnection()
 	corpse_timer(2000),
 	group_timer(1000),
 	raid_timer(1000),
-	trap_timer(1000)
+	trap_timer(1000),
+	dormant_timer(1000)
 {
 	ZonePort = 0;
 	ZoneAddress = 0;
@@ -596,19 +664,32 @@ NetConnection::~NetConnection() {
 
 void LoadSpells(EQEmu::MemoryMappedFile **mmf) {
 	int records = database.GetMaxSpellID() + 1;
+	EQEmu::MemoryMappedFile *new_mmf = nullptr;
 
 	try {
 		EQEmu::IPCMutex mutex("spells");
 		mutex.Lock();
-		*mmf = new EQEmu::MemoryMappedFile("shared/spells");
-		uint32 size = (*mmf)->Size();
-		if(size != (records * sizeof(SPDat_Spell_Struct))) {
-			EQ_EXCEPT("Zone", "Unable to load spells: (*mmf)->Size() != records * sizeof(SPDat_Spell_Struct)");
+		uint32 generation = EQEmu::SharedMemoryGeneration::Current("spells");
+		if(*mmf && generation == spells_generation)
+			return;
+
+		new_mmf = new EQEmu::MemoryMappedFile(EQEmu::SharedMemoryGeneration::FileName("shared/spells", generation));
+		uint32 size = new_mmf->Size();
+		if(size != GetSpellsSegmentSize(records)) {
+			EQ_EXCEPT("Zone", "Unable to load spells: (*mmf)->Size() != GetSpellsSegmentSize(records)");
 		}
 
-		spells = reinterpret_cast<SPDat_Spell_Struct*>((*mmf)->Get());
+		spells = reinterpret_cast<SPDat_Spell_Struct*>(new_mmf->Get());
+		MapSpellHotTable(new_mmf->Get(), records, spells_hot);
 		mutex.Unlock();
+
+		//buffs and casts in progress may still point at the previous generation
+		if(*mmf)
+			retired_spells_mmfs.push_back(*mmf);
+		*mmf = new_mmf;
+		spells_generation = generation;
 	} catch(std::exception &ex) {
+		safe_delete(new_mmf);
 		LogFile->write(EQEmuLog::Error, "Error loading spells: %s", ex.what());
 		return;
 	}
@@ -616,6 +697,148 @@ void LoadSpells(EQEmu::MemoryMappedFile **mmf) {
 	SPDAT_RECORDS = records;
 }
 
+static void LoadRuleSet() {
+	char tmp[64];
+	if (database.GetVariable("RuleSet", tmp, sizeof(tmp)-1)) {
+		_log(ZONE__INIT, "Loading rule set '%s'", tmp);
+		if(!RuleManager::Instance()->LoadRules(&database, tmp)) {
+			_log(ZONE__INIT_ERR, "Failed to load ruleset '%s', falling back to defaults.", tmp);
+		}
+	} else {
+		if(!RuleManager::Instance()->LoadRules(&database, "default")) {
+			_log(ZONE__INIT, "No rule set configured, using default rules");
+		} else {
+			_log(ZONE__INIT, "Loaded default rule set 'default'", tmp);
+		}
+	}
+	SetDeflateLevel(RuleI(Network, CompressionLevel));
+}
+
+/*
+	A zone forked by the zone host starts with what the host loaded, possibly long ago, and the host is not
+	connected to world to be told about reloads. Shared memory remaps only the segments shared_memory has
+	published a newer generation of and variables only read rows changed since, the rest of the boot data
+	is stamped with the checksums of the tables it comes from when the host loads it, and a zone reloads
+	only the parts whose stamp no longer matches. Stamps are taken before loading, so an edit racing the
+	host's boot costs a reload rather than leaving a zone with stale data.
+*/
+struct HostedData {
+	const char *name;
+	const char *tables;		//nullptr for the quest files
+	void (*reload)();
+	std::string stamp;
+};
+
+static void ReloadRules() {
+	LoadRuleSet();
+	database.GetDecayTimes(npcCorpseDecayTimes);
+}
+
+static void ReloadZoneNames() { database.LoadZoneNames(); }
+static void ReloadCommands() { command_deinit(); command_init(); }
+static void ReloadGuilds() { guild_mgr.LoadGuilds(); }
+static void ReloadFactions() { database.LoadFactionData(); }
+static void ReloadTitles() { title_manager.LoadTitles(); }
+static void ReloadAAEffects() { database.LoadAAEffects(); }
+static void ReloadTributes() { database.LoadTributes(); }
+static void ReloadTradeskillRecipes() { database.LoadTradeskillRecipes(); }
+
+static void ReloadTasks() {
+	if(!RuleB(TaskSystem, EnableTaskSystem))
+		return;
+
+	if(taskmanager == nullptr)
+		taskmanager = new TaskManager;
+	taskmanager->LoadTasks();
+}
+
+static void ReloadHostedQuests() { parse->ReloadQuests(); }
+
+static HostedData hosted_data[] = {
+	{ "rules", "rule_sets, rule_values, variables", ReloadRules },
+	{ "zone names", "zone", ReloadZoneNames },
+	{ "commands", "commands", ReloadCommands },
+	{ "guilds", "guilds, guild_ranks", ReloadGuilds },
+	{ "factions", "faction_list, faction_list_mod", ReloadFactions },
+	{ "titles", "titles", ReloadTitles },
+	{ "AA effects", "aa_actions", ReloadAAEffects },
+	{ "tributes", "tributes, tribute_levels", ReloadTributes },
+	{ "tradeskill recipes", "tradeskill_recipe, tradeskill_recipe_entries", ReloadTradeskillRecipes },
+	{ "tasks", "tasks, activities, goallists, tasksets", ReloadTasks },
+	{ "quests", nullptr, ReloadHostedQuests }
+};
+
+static void StampFile(const std::string &path, std::string &stamp) {
+	struct stat st;
+	if(stat(path.c_str(), &st) == 0)
+		stamp += StringFormat("%s=%lu;", path.c_str(), (unsigned long)st.st_mtime);
+}
+
+//the quest files read when quests are loaded rather than when a zone first runs them
+static std::string GetQuestFileStamp() {
+	std::string stamp;
+	StampFile("plugin.pl", stamp);
+	StampFile(std::string("quests/") + QUEST_GLOBAL_DIRECTORY + "/script_init.lua", stamp);
+
+#ifndef _WINDOWS
+	const char *dirs[] = { "plugins", "lua_modules" };
+	for(size_t i = 0; i < sizeof(dirs) / sizeof(dirs[0]); ++i) {
+		DIR *dir = opendir(dirs[i]);
+		if(dir == nullptr)
+			continue;
+
+		//readdir order is stable for an unchanged directory, and any added or removed file changes it anyway
+		StampFile(dirs[i], stamp);
+		struct dirent *entry;
+		while((entry = readdir(dir)) != nullptr) {
+			if(entry->d_name[0] != '.')
+				StampFile(std::string(dirs[i]) + "/" + entry->d_name, stamp);
+		}
+		closedir(dir);
+	}
+#endif
+
+	return stamp;
+}
+
+static std::string GetHostedDataStamp(const HostedData &data) {
+	if(data.tables == nullptr)
+		return GetQuestFileStamp();
+	return database.GetTableChecksums(data.tables);
+}
+
+static void StampHostedData() {
+	for(size_t i = 0; i < sizeof(hosted_data) / sizeof(hosted_data[0]); ++i)
+		hosted_data[i].stamp = GetHostedDataStamp(hosted_data[i]);
+}
+
+static void RefreshHostedZone() {
+	database.LoadVariables();
+	ReloadSharedMemory();
+
+	for(size_t i = 0; i < sizeof(hosted_data) / sizeof(hosted_data[0]); ++i) {
+		HostedData &data = hosted_data[i];
+		std::string stamp = GetHostedDataStamp(data);
+		//an empty stamp means it couldn't be taken, so nothing says the host's copy is still good
+		if(!stamp.empty() && stamp == data.stamp)
+			continue;
+
+		_log(ZONE__INIT, "Reloading %s, changed since the zone host loaded them", data.name);
+		data.reload();
+		data.stamp = stamp;
+	}
+}
+
+void ReloadSharedMemory() {
+	if (!database.ReloadSharedMemory())
+		LogFile->write(EQEmuLog::Error, "Reloading shared memory failed, keeping the previous generation of the failed segments");
+
+	LoadSpells(&spells_mmf);
+
+	//cached client item serializations may have been built from the old item data
+	ClearPatchItemCaches();
+}
+
 /* Update Window Title with relevant information */
 void UpdateWindowTitle(char* iNewTitle) {
 #ifdef _WINDOWS
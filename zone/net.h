@@ -30,6 +30,7 @@
 #include "../common/timer.h"
 void CatchSignal(int);
 void UpdateWindowTitle(char* iNewTitle = 0);
+void ReloadSharedMemory();
 
 class NetConnection
 {
@@ -50,6 +51,7 @@ public:
 	Timer group_timer;
 	Timer raid_timer;
 	Timer trap_timer;
+	Timer dormant_timer;
 private:
 	uint16 ZonePort;
 	char* ZoneAddress;
@@ -225,6 +225,8 @@ NPC::NPC(const NPCType* d, Spawn2* in_respawn, float x, float y, float z, float
 	roambox_delay = 1000;
 	org_heading = heading;
 	p_depop = false;
+	dormant = false;
+	dormant_since = 0;
 	loottable_id = d->loottable_id;
 
 	no_target_hotkey = d->no_target_hotkey;
@@ -2213,9 +2215,90 @@ int32 NPC::CalcMaxMana() {
 
 void NPC::SignalNPC(int _signal_id)
 {
+	Wake();
 	signal_q.push_back(_signal_id);
 }
 
+// Anything fighting, casting, owned, following, waiting on a signal or wearing a detrimental buff stays awake
+bool NPC::CanGoDormant()
+{
+	if (p_depop || IsEngaged() || IsCasting() || GetOwnerID() != 0 || GetSwarmOwner() != 0 || GetFollowID() != 0 || !signal_q.empty())
+		return false;
+
+	int buff_count = GetMaxTotalSlots();
+	for (int i = 0; i < buff_count; i++) {
+		if (IsValidSpell(buffs[i].spellid) && IsDetrimentalSpell(buffs[i].spellid))
+			return false;
+	}
+
+	return true;
+}
+
+void NPC::GoDormant()
+{
+	if (dormant)
+		return;
+
+	dormant = true;
+	dormant_since = Timer::GetCurrentTime();
+
+	//stop anyone still in sight from walking it on past where it halted
+	if (IsMoving())
+		SendPosition();
+}
+
+// Catches up on the tics slept through: out of combat regen and beneficial buff durations
+void NPC::Wake()
+{
+	if (!dormant)
+		return;
+
+	dormant = false;
+
+	uint32 tic_length = tic_timer.GetDuration();
+	uint32 tics = tic_length ? (Timer::GetCurrentTime() - dormant_since) / tic_length : 0;
+	if (tics == 0)
+		return;
+
+	int32 hp_regen = GetNPCHPRegen();
+	if (oocregen > 0 && GetMaxHP() * oocregen / 100 > hp_regen)
+		hp_regen = GetMaxHP() * oocregen / 100;
+	if (hp_regen > 0 && GetHP() < GetMaxHP()) {
+		int64 hp = (int64)GetHP() + (int64)hp_regen * tics;
+		SetHP(hp > GetMaxHP() ? GetMaxHP() : (int32)hp);
+	}
+
+	int32 mana_bonus = mana_regen + (GetAppearance() == eaSitting ? 3 : 0);
+	if (mana_bonus > 0 && GetMana() < GetMaxMana()) {
+		int64 mana = (int64)GetMana() + (int64)mana_bonus * tics;
+		SetMana(mana > GetMaxMana() ? GetMaxMana() : (int32)mana);
+	}
+
+	int buff_count = GetMaxTotalSlots();
+	for (int i = 0; i < buff_count; i++) {
+		if (!IsValidSpell(buffs[i].spellid) || spells[buffs[i].spellid].buffdurationformula == DF_Permanent)
+			continue;
+		if (zone->BuffTimersSuspended() && IsSuspendableSpell(buffs[i].spellid))
+			continue;
+
+		if (buffs[i].ticsremaining <= (int32)tics)
+			BuffFadeBySlot(i);
+		else
+			buffs[i].ticsremaining -= tics;
+	}
+
+	SendHPUpdate();
+}
+
+// All a dormant npc does each pass, a depop still has to go through Process()
+bool NPC::DormantProcess()
+{
+	if (p_depop)
+		return Process();
+
+	return true;
+}
+
 NPC_Emote_Struct* NPC::GetNPCEmote(uint16 emoteid, uint8 event_) {
 	LinkedListIterator<NPC_Emote_Struct*> iterator(zone->NPCEmoteList);
 	iterator.Reset();
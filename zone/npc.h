@@ -368,6 +368,13 @@ public:
 
 	bool GetDepop() { return p_depop; }
 
+	// NPCs far from every client skip Process() until woken
+	bool	IsDormant() const { return dormant; }
+	bool	CanGoDormant();
+	void	GoDormant();
+	void	Wake();
+	bool	DormantProcess();
+
 	void NPCSlotTexture(uint8 slot, uint16 texture);	// Sets new material values for slots
 
 	uint32 GetAdventureTemplate() const { return adventure_template_id; }
@@ -526,6 +533,8 @@ protected:
 private:
 	uint32	loottable_id;
 	bool	p_depop;
+	bool	dormant;
+	uint32	dormant_since;
 };
 
 #endif
@@ -83,6 +83,7 @@ void QuestManager::Process() {
 		if (cur->Timer_.Enabled() && cur->Timer_.Check()) {
 			if(entity_list.IsMobInZone(cur->mob)) {
 				if(cur->mob->IsNPC()) {
+					cur->mob->CastToNPC()->Wake();
 					parse->EventNPC(EVENT_TIMER, cur->mob->CastToNPC(), nullptr, cur->name, 0);
 				} else {
 					//this is inheriently unsafe if we ever make it so more than npc/client start timers
@@ -259,11 +260,11 @@ Mob* QuestManager::spawn_from_spawn2(uint32 spawn2_id)
 
 	if(found_spawn)
 	{
-		SpawnGroup* sg = zone->spawn_group_list.GetSpawnGroup(found_spawn->SpawnGroupID());
+		SpawnGroup* sg = found_spawn->GetSpawnGroup();
 		if(!sg)
 		{
 			database.LoadSpawnGroupsByID(found_spawn->SpawnGroupID(),&zone->spawn_group_list);
-			sg = zone->spawn_group_list.GetSpawnGroup(found_spawn->SpawnGroupID());
+			sg = found_spawn->GetSpawnGroup();
 			if(!sg)
 			{
 				return nullptr;
@@ -43,6 +43,7 @@ Raid::Raid(uint32 raidID)
 	memset(leadername, 0, 64);
 	locked = false;
 	LootType = 4;
+	version = 0;
 }
 
 Raid::Raid(Client* nLeader)
@@ -60,6 +61,7 @@ Raid::Raid(Client* nLeader)
 	strn0cpy(leadername, nLeader->GetName(), 64);
 	locked = false;
 	LootType = 4;
+	version = 0;
 }
 
 Raid::~Raid()
@@ -90,20 +92,19 @@ void Raid::AddMember(Client *c, uint32 group, bool rleader, bool groupleader, bo
 	if(!c)
 		return;
 
-	std::string query = StringFormat("INSERT INTO raid_members SET raidid = %lu, charid = %lu, "
-                                    "groupid = %lu, _class = %d, level = %d, name = '%s', "
-                                    "isgroupleader = %d, israidleader = %d, islooter = %d",
-                                    (unsigned long)GetID(), (unsigned long)c->CharacterID(),
-                                    (unsigned long)group, c->GetClass(), c->GetLevel(),
-                                    c->GetName(), groupleader, rleader, looter);
-    auto results = database.QueryDatabase(query);
-
-	if(!results.Success()) {
-		LogFile->write(EQEmuLog::Error, "Error inserting into raid members: %s", results.ErrorMessage().c_str());
-	}
-
-	LearnMembers();
+	ServerRaidMember_Struct m;
+	memset(&m, 0, sizeof(ServerRaidMember_Struct));
+	strn0cpy(m.name, c->GetName(), 64);
+	m.charid = c->CharacterID();
+	m.groupid = group;
+	m._class = c->GetClass();
+	m.level = c->GetLevel();
+	m.isgroupleader = groupleader;
+	m.israidleader = rleader;
+	m.islooter = looter;
+	SetMember(m);
 	VerifyRaid();
+	SendMemberDelta(RaidDeltaUpsert, c->GetName());
 	if (rleader) {
 		database.SetRaidGroupLeaderInfo(RAID_GROUPLESS, GetID());
 		UpdateRaidAAs();
@@ -133,14 +134,11 @@ void Raid::AddMember(Client *c, uint32 group, bool rleader, bool groupleader, bo
 
 void Raid::RemoveMember(const char *characterName)
 {
-	std::string query = StringFormat("DELETE FROM raid_members where name='%s'", characterName);
-	auto results = database.QueryDatabase(query);
-
 	Client *client = entity_list.GetClientByName(characterName);
 	disbandCheck = true;
 	SendRaidRemoveAll(characterName);
 	SendRaidDisband(client);
-	LearnMembers();
+	EraseMember(characterName);
 	VerifyRaid();
 
 	if(client)
@@ -154,14 +152,15 @@ void Raid::RemoveMember(const char *characterName)
 	rga->zoneid = zone->GetZoneID();
 	worldserver.SendPacket(pack);
 	safe_delete(pack);
+
+	// after the notice, other zones still need the member to send it
+	SendMemberDelta(RaidDeltaRemove, characterName);
 }
 
 void Raid::DisbandRaid()
 {
-	std::string query = StringFormat("DELETE FROM raid_members WHERE raidid = %lu", (unsigned long)GetID());
-	auto results = database.QueryDatabase(query);
-
-	LearnMembers();
+	memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
+	disbandCheck = true;
 	VerifyRaid();
 	SendRaidDisbandAll();
 
@@ -174,18 +173,20 @@ void Raid::DisbandRaid()
 	worldserver.SendPacket(pack);
 	safe_delete(pack);
 
+	SendMemberDelta(RaidDeltaDisband, "");
+
 	forceDisband = true;
 }
 
 void Raid::MoveMember(const char *name, uint32 newGroup)
 {
-	std::string query = StringFormat("UPDATE raid_members SET groupid = %lu WHERE name = '%s'",
-                                    (unsigned long)newGroup, name);
-    auto results = database.QueryDatabase(query);
+	RaidMember *m = FindMember(name);
+	if(m)
+		m->GroupNumber = newGroup > 11 ? RAID_GROUPLESS : newGroup;
 
-	LearnMembers();
 	VerifyRaid();
 	SendRaidMoveAll(name);
+	SendMemberDelta(RaidDeltaUpsert, name);
 
 	ServerPacket *pack = new ServerPacket(ServerOP_RaidChangeGroup, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
@@ -199,12 +200,12 @@ void Raid::MoveMember(const char *name, uint32 newGroup)
 
 void Raid::SetGroupLeader(const char *who, bool glFlag)
 {
-	std::string query = StringFormat("UPDATE raid_members SET isgroupleader = %lu WHERE name = '%s'",
-                                    (unsigned long)glFlag, who);
-    auto results = database.QueryDatabase(query);
+	RaidMember *m = FindMember(who);
+	if(m)
+		m->IsGroupLeader = glFlag;
 
-	LearnMembers();
 	VerifyRaid();
+	SendMemberDelta(RaidDeltaUpsert, who);
 
 	ServerPacket *pack = new ServerPacket(ServerOP_RaidGroupLeader, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
@@ -230,15 +231,15 @@ Client *Raid::GetGroupLeader(uint32 group_id)
 
 void Raid::SetRaidLeader(const char *wasLead, const char *name)
 {
-	std::string query = StringFormat("UPDATE raid_members SET israidleader = 0 WHERE name = '%s'", wasLead);
-	auto results = database.QueryDatabase(query);
-	if (!results.Success())
-		LogFile->write(EQEmuLog::Error, "Set Raid Leader error: %s\n", results.ErrorMessage().c_str());
+	RaidMember *m = FindMember(wasLead);
+	if(m)
+		m->IsRaidLeader = false;
+	SendMemberDelta(RaidDeltaUpsert, wasLead);
 
-	query = StringFormat("UPDATE raid_members SET israidleader = 1 WHERE name = '%s'", name);
-	results = database.QueryDatabase(query);
-	if (!results.Success())
-		LogFile->write(EQEmuLog::Error, "Set Raid Leader error: %s\n", results.ErrorMessage().c_str());
+	m = FindMember(name);
+	if(m)
+		m->IsRaidLeader = true;
+	SendMemberDelta(RaidDeltaUpsert, name);
 
 	strn0cpy(leadername, name, 64);
 
@@ -246,7 +247,6 @@ void Raid::SetRaidLeader(const char *wasLead, const char *name)
 	if(c)
 		SetLeader(c);
 
-	LearnMembers();
 	VerifyRaid();
 	SendMakeLeaderPacket(name);
 
@@ -326,12 +326,12 @@ bool Raid::IsGroupLeader(const char *who)
 
 void Raid::UpdateLevel(const char *name, int newLevel)
 {
-	std::string query = StringFormat("UPDATE raid_members SET level = %lu WHERE name = '%s'",
-                                    (unsigned long)newLevel, name);
-    auto results = database.QueryDatabase(query);
+	RaidMember *m = FindMember(name);
+	if(!m)
+		return;
 
-	LearnMembers();
-	VerifyRaid();
+	m->level = newLevel;
+	SendMemberDelta(RaidDeltaUpsert, name);
 }
 
 uint32 Raid::GetFreeGroup()
@@ -841,9 +841,6 @@ void Raid::ChangeLootType(uint32 type)
 
 void Raid::AddRaidLooter(const char* looter)
 {
-	std::string query = StringFormat("UPDATE raid_members SET islooter = 1 WHERE name = '%s'", looter);
-	auto results = database.QueryDatabase(query);
-
 	for(int x = 0; x < MAX_RAID_MEMBERS; x++)
 	{
 		if(strcmp(looter, members[x].membername) == 0)
@@ -852,6 +849,8 @@ void Raid::AddRaidLooter(const char* looter)
 			break;
 		}
 	}
+	SendMemberDelta(RaidDeltaUpsert, looter);
+
 	ServerPacket *pack = new ServerPacket(ServerOP_DetailsChange, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 	rga->rid = GetID();
@@ -863,14 +862,12 @@ void Raid::AddRaidLooter(const char* looter)
 
 void Raid::RemoveRaidLooter(const char* looter)
 {
-	std::string query = StringFormat("UPDATE raid_members SET islooter = 0 WHERE name = '%s'", looter);
-	auto results = database.QueryDatabase(query);
-
 	for(int x = 0; x < MAX_RAID_MEMBERS; x++)
 		if(strcmp(looter, members[x].membername) == 0) {
 			members[x].IsLooter = 0;
 			break;
 		}
+	SendMemberDelta(RaidDeltaUpsert, looter);
 
 	ServerPacket *pack = new ServerPacket(ServerOP_DetailsChange, sizeof(ServerRaidGeneralAction_Struct));
 	ServerRaidGeneralAction_Struct *rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
@@ -1431,7 +1428,7 @@ bool Raid::LearnMembers()
 	memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
 
 	std::string query = StringFormat("SELECT name, groupid, _class, level, "
-                                    "isgroupleader, israidleader, islooter "
+                                    "isgroupleader, israidleader, islooter, charid "
                                     "FROM raid_members WHERE raidid = %lu",
                                     (unsigned long)GetID());
     auto results = database.QueryDatabase(query);
@@ -1462,6 +1459,7 @@ bool Raid::LearnMembers()
         members[index].IsGroupLeader = atoi(row[4]);
         members[index].IsRaidLeader = atoi(row[5]);
         members[index].IsLooter = atoi(row[6]);
+        members[index].CharacterID = atoul(row[7]);
         ++index;
     }
 
@@ -1493,6 +1491,128 @@ void Raid::VerifyRaid()
 	}
 }
 
+RaidMember *Raid::FindMember(const char *name)
+{
+	for(int x = 0; x < MAX_RAID_MEMBERS; x++)
+		if(members[x].membername[0] && strcmp(members[x].membername, name) == 0)
+			return &members[x];
+
+	return nullptr;
+}
+
+void Raid::SetMember(const ServerRaidMember_Struct &m)
+{
+	RaidMember *slot = FindMember(m.name);
+	for(int x = 0; !slot && x < MAX_RAID_MEMBERS; x++)
+		if(members[x].membername[0] == 0)
+			slot = &members[x];
+
+	if(!slot)
+		return;
+
+	strn0cpy(slot->membername, m.name, 64);
+	if(m.charid)
+		slot->CharacterID = m.charid;
+	slot->GroupNumber = m.groupid > 11 ? RAID_GROUPLESS : m.groupid;
+	slot->_class = m._class;
+	slot->level = m.level;
+	slot->IsGroupLeader = m.isgroupleader;
+	slot->IsRaidLeader = m.israidleader;
+	slot->IsLooter = m.islooter;
+}
+
+void Raid::EraseMember(const char *name)
+{
+	RaidMember *m = FindMember(name);
+	if(m)
+		memset(m, 0, sizeof(RaidMember));
+
+	disbandCheck = true;
+}
+
+void Raid::SendMemberDelta(uint8 action, const char *name)
+{
+	ServerPacket *pack = new ServerPacket(ServerOP_RaidMemberDelta, sizeof(ServerRaidMemberDelta_Struct));
+	ServerRaidMemberDelta_Struct *delta = (ServerRaidMemberDelta_Struct*)pack->pBuffer;
+	delta->zoneid = zone->GetZoneID();
+	delta->instance_id = zone->GetInstanceID();
+	delta->rid = GetID();
+	delta->action = action;
+	strn0cpy(delta->member.name, name, 64);
+
+	if(action == RaidDeltaUpsert) {
+		RaidMember *m = FindMember(name);
+		if(!m) {
+			safe_delete(pack);
+			return;
+		}
+		delta->member.charid = m->CharacterID;
+		delta->member.groupid = m->GroupNumber;
+		delta->member._class = m->_class;
+		delta->member.level = m->level;
+		delta->member.isgroupleader = m->IsGroupLeader;
+		delta->member.israidleader = m->IsRaidLeader;
+		delta->member.islooter = m->IsLooter;
+	}
+
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
+}
+
+void Raid::ApplyMemberDelta(const ServerRaidMemberDelta_Struct *delta)
+{
+	if(delta->action == RaidDeltaDisband) {
+		memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
+		disbandCheck = true;
+		VerifyRaid();
+		return;
+	}
+
+	// a snapshot newer than this delta has already been applied; version 1 is
+	// a fresh history, as after a world restart
+	if(version != 0 && delta->version <= version && delta->version != 1)
+		return;
+
+	bool missed = version != 0 && delta->version > version + 1;
+	version = delta->version;
+
+	if(delta->action == RaidDeltaRemove)
+		EraseMember(delta->member.name);
+	else
+		SetMember(delta->member);
+	VerifyRaid();
+
+	if(missed)
+		RequestSnapshot();
+}
+
+void Raid::ApplySnapshot(const ServerRaidSnapshot_Struct *snapshot)
+{
+	// world has no record of this raid, keep what we loaded
+	if(snapshot->version == 0 || snapshot->version < version)
+		return;
+
+	memset(members, 0, (sizeof(RaidMember)*MAX_RAID_MEMBERS));
+	for(uint32 x = 0; x < snapshot->count && x < MAX_RAID_MEMBERS; x++)
+		SetMember(snapshot->members[x]);
+
+	version = snapshot->version;
+	if(snapshot->count == 0)
+		disbandCheck = true;
+	VerifyRaid();
+}
+
+void Raid::RequestSnapshot()
+{
+	ServerPacket *pack = new ServerPacket(ServerOP_RaidSnapshotRequest, sizeof(ServerRaidSnapshotRequest_Struct));
+	ServerRaidSnapshotRequest_Struct *request = (ServerRaidSnapshotRequest_Struct*)pack->pBuffer;
+	request->zoneid = zone->GetZoneID();
+	request->instance_id = zone->GetInstanceID();
+	request->rid = GetID();
+	worldserver.SendPacket(pack);
+	safe_delete(pack);
+}
+
 void Raid::MemberZoned(Client *c)
 {
 	if(!c)
@@ -80,6 +80,7 @@ const uint32 RAID_GROUPLESS = 0xFFFFFFFF;
 
 struct RaidMember{
 	char membername[64];
+	uint32 CharacterID;
 	Client *member;
 	uint32 GroupNumber;
 	uint8 _class;
@@ -95,6 +96,10 @@ struct GroupMentor {
 	int mentor_percent;
 };
 
+struct ServerRaidMember_Struct;
+struct ServerRaidMemberDelta_Struct;
+struct ServerRaidSnapshot_Struct;
+
 class Raid : public GroupIDConsumer {
 public:
 	Raid(Client *nLeader);
@@ -170,6 +175,10 @@ public:
 	void	SaveRaidMOTD();
 	bool	LearnMembers();
 	void	VerifyRaid();
+	//membership is owned by world; changes go out as deltas and come back with a version
+	void	ApplyMemberDelta(const ServerRaidMemberDelta_Struct *delta);
+	void	ApplySnapshot(const ServerRaidSnapshot_Struct *snapshot);
+	void	RequestSnapshot();
 	void	MemberZoned(Client *c);
 	void	SendHPPacketsTo(Client *c);
 	void	SendHPPacketsFrom(Mob *m);
@@ -244,6 +253,12 @@ protected:
 	GroupLeadershipAA_Struct group_aa[MAX_RAID_GROUPS];
 
 	GroupMentor group_mentor[MAX_RAID_GROUPS];
+
+	RaidMember *FindMember(const char *name);
+	void	SetMember(const ServerRaidMember_Struct &m);
+	void	EraseMember(const char *name);
+	void	SendMemberDelta(uint8 action, const char *name);
+	uint32	version;
 };
 
 
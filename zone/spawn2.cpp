@@ -86,22 +86,72 @@ Spawn2::Spawn2(uint32 in_spawn2_id, uint32 spawngroup_id,
 	npcthis = nullptr;
 	enabled = in_enabled;
 	this->anim = anim;
+	next_due = 0;
+	spawn_group = nullptr;
+	spawn_group_version = 0;
 
 	if(timeleft == 0xFFFFFFFF) {
 		//special disable timeleft
 		timer.Disable();
 	} else if(timeleft != 0){
 		//we have a timeleft from the DB or something
-		timer.Start(timeleft);
+		StartTimer(timeleft);
 	} else {
 		//no timeleft at all, reset to
 		timer.Start(resetTimer());
-		timer.Trigger();
+		TriggerTimer();
 	}
 }
 
 Spawn2::~Spawn2()
 {
+	if(zone)
+		zone->UnscheduleSpawn2(this);
+}
+
+void Spawn2::Enable()
+{
+	enabled = true;
+	Schedule();
+}
+
+void Spawn2::SetNPCPointerNull()
+{
+	npcthis = nullptr;
+	Schedule();
+}
+
+//looked up again only when the zone's spawn group list has changed
+SpawnGroup* Spawn2::GetSpawnGroup()
+{
+	uint32 version = zone->spawn_group_list.GetVersion();
+	if(spawn_group_version != version) {
+		spawn_group = zone->spawn_group_list.GetSpawnGroup(spawngroup_id_);
+		spawn_group_version = version;
+	}
+	return spawn_group;
+}
+
+void Spawn2::StartTimer(uint32 duration)
+{
+	timer.Start(duration);
+	Schedule();
+}
+
+void Spawn2::TriggerTimer()
+{
+	timer.Trigger();
+	Schedule();
+}
+
+//queues a Process() for the first tick the timer can have expired by, Timer::Check() needs it to be passed
+void Spawn2::Schedule()
+{
+	if(!timer.Enabled())
+		return;
+
+	next_due = Timer::GetCurrentTime() + timer.GetRemainingTime() + 1;
+	zone->ScheduleSpawn2(this, next_due);
 }
 
 uint32 Spawn2::resetTimer()
@@ -145,7 +195,7 @@ bool Spawn2::Process() {
 		return true;
 
 	//grab our spawn group
-	SpawnGroup* sg = zone->spawn_group_list.GetSpawnGroup(spawngroup_id_);
+	SpawnGroup* sg = GetSpawnGroup();
 
 	if(NPCPointerValid() && (sg->despawn == 0 || condition_id != 0))
 		return true;
@@ -166,7 +216,7 @@ bool Spawn2::Process() {
 
 		if (sg == nullptr) {
 			database.LoadSpawnGroupsByID(spawngroup_id_,&zone->spawn_group_list);
-			sg = zone->spawn_group_list.GetSpawnGroup(spawngroup_id_);
+			sg = GetSpawnGroup();
 		}
 
 		if (sg == nullptr) {
@@ -195,7 +245,7 @@ bool Spawn2::Process() {
 			if(!entity_list.LimitCheckName(tmp->name))
 			{
 				_log(SPAWNS__MAIN, "Spawn2 %d: Spawn group %d yeilded NPC type %d, which is unique and one already exists.", spawn2_id, spawngroup_id_, npcid);
-				timer.Start(5000);	//try again in five seconds.
+				StartTimer(5000);	//try again in five seconds.
 				return(true);
 			}
 		}
@@ -203,7 +253,7 @@ bool Spawn2::Process() {
 		if(tmp->spawn_limit > 0) {
 			if(!entity_list.LimitCheckType(npcid, tmp->spawn_limit)) {
 				_log(SPAWNS__MAIN, "Spawn2 %d: Spawn group %d yeilded NPC type %d, which is over its spawn limit (%d)", spawn2_id, spawngroup_id_, npcid, tmp->spawn_limit);
-				timer.Start(5000);	//try again in five seconds.
+				StartTimer(5000);	//try again in five seconds.
 				return(true);
 			}
 		}
@@ -238,6 +288,9 @@ bool Spawn2::Process() {
 		} else {
 			_log(SPAWNS__MAIN, "Spawn2 %d: Group %d spawned %s (%d) at (%.3f, %.3f, %.3f). Grid loading delayed.", spawn2_id, spawngroup_id_, tmp->name, npcid, x, y, z);
 		}
+	} else {
+		//woken before the timer ran out, e.g. by an entry from before it was restarted
+		Schedule();
 	}
 	return true;
 }
@@ -270,7 +323,7 @@ void Spawn2::LoadGrid() {
 	associated with this spawn point is no longer relavent.
 */
 void Spawn2::Reset() {
-	timer.Start(resetTimer());
+	StartTimer(resetTimer());
 	npcthis = nullptr;
 	_log(SPAWNS__MAIN, "Spawn2 %d: Spawn reset, repop in %d ms", spawn2_id, timer.GetRemainingTime());
 }
@@ -283,18 +336,18 @@ void Spawn2::Depop() {
 
 void Spawn2::Repop(uint32 delay) {
 	if (delay == 0) {
-		timer.Trigger();
+		TriggerTimer();
 		_log(SPAWNS__MAIN, "Spawn2 %d: Spawn reset, repop immediately.", spawn2_id);
 	} else {
 		_log(SPAWNS__MAIN, "Spawn2 %d: Spawn reset for repop, repop in %d ms", spawn2_id, delay);
-		timer.Start(delay);
+		StartTimer(delay);
 	}
 	npcthis = nullptr;
 }
 
 void Spawn2::ForceDespawn()
 {
-	SpawnGroup* sg = zone->spawn_group_list.GetSpawnGroup(spawngroup_id_);
+	SpawnGroup* sg = GetSpawnGroup();
 
 	if(npcthis != nullptr)
 	{
@@ -329,7 +382,7 @@ void Spawn2::ForceDespawn()
 	}
 
 	_log(SPAWNS__MAIN, "Spawn2 %d: Spawn group %d set despawn timer to %d ms.", spawn2_id, spawngroup_id_, cur);
-	timer.Start(cur);
+	StartTimer(cur);
 }
 
 //resets our spawn as if we just died
@@ -338,7 +391,7 @@ void Spawn2::DeathReset(bool realdeath)
 	//get our reset based on variance etc and store it locally
 	uint32 cur = resetTimer();
 	//set our timer to our reset local
-	timer.Start(cur);
+	StartTimer(cur);
 
 	//zero out our NPC since he is now gone
 	npcthis = nullptr;
@@ -519,6 +572,9 @@ void Spawn2::SpawnConditionChanged(const SpawnCondition &c, int16 old_value) {
 		if(npcthis != nullptr)
 			npcthis->SignalNPC(signal_id);
 	}
+
+	//a timer that ran out while the condition held us back is due again
+	Schedule();
 }
 
 void Zone::SpawnConditionChanged(const SpawnCondition &c, int16 old_value) {
@@ -24,6 +24,7 @@
 #define SC_AlwaysEnabled 0
 
 class SpawnCondition;
+class SpawnGroup;
 class NPC;
 
 class Spawn2
@@ -37,7 +38,7 @@ public:
 	~Spawn2();
 
 	void	LoadGrid();
-	void	Enable() { enabled = true; }
+	void	Enable();
 	void	Disable();
 	bool	Enabled() { return enabled; }
 	bool	Process();
@@ -59,14 +60,15 @@ public:
 	const uint32 GetVariance() const { return variance_; }
 	uint32	RespawnTimer() { return respawn_; }
 	uint32	SpawnGroupID() { return spawngroup_id_; }
+	SpawnGroup*	GetSpawnGroup();
 	uint32	CurrentNPCID() { return currentnpcid; }
 	void	SetCurrentNPCID(uint32 nid) { currentnpcid = nid; }
 	uint32	GetSpawnCondition() { return condition_id; }
 
 	bool	NPCPointerValid() { return (npcthis!=nullptr); }
 	void	SetNPCPointer(NPC* n) { npcthis = n; }
-	void	SetNPCPointerNull() { npcthis = nullptr; }
-	void	SetTimer(uint32 duration) { timer.Start(duration); }
+	void	SetNPCPointerNull();
+	void	SetTimer(uint32 duration) { StartTimer(duration); }
 	uint32  GetKillCount() { return killcount; }
 protected:
 	friend class Zone;
@@ -76,6 +78,9 @@ private:
 	uint32	respawn_;
 	uint32	resetTimer();
 	uint32	despawnTimer(uint32 despawn_timer);
+	void	StartTimer(uint32 duration);
+	void	TriggerTimer();
+	void	Schedule();
 
 	uint32	spawngroup_id_;
 	uint32	currentnpcid;
@@ -92,6 +97,9 @@ private:
 	EmuAppearance anim;
 	bool IsDespawned;
 	uint32  killcount;
+	uint32	next_due;	// due time of this spawn's latest entry in Zone::spawn2_queue
+	SpawnGroup*	spawn_group;
+	uint32	spawn_group_version;
 };
 
 class SpawnCondition {
@@ -123,6 +123,7 @@ void SpawnGroupList::AddSpawnGroup(SpawnGroup* newGroup) {
 	if(newGroup == nullptr)
 		return;
 	groups[newGroup->id] = newGroup;
+	version++;
 }
 
 SpawnGroup* SpawnGroupList::GetSpawnGroup(uint32 in_id) {
@@ -136,6 +137,7 @@ bool SpawnGroupList::RemoveSpawnGroup(uint32 in_id) {
 		return(false);
 
 	groups.erase(in_id);
+	version++;
 	return(true);
 }
 
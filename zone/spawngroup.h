@@ -58,15 +58,17 @@ private:
 class SpawnGroupList
 {
 public:
-	SpawnGroupList() { }
+	SpawnGroupList() : version(1) { }
 	~SpawnGroupList();
 
 	void AddSpawnGroup(SpawnGroup* newGroup);
 	SpawnGroup* GetSpawnGroup(uint32 id);
 	bool RemoveSpawnGroup(uint32 in_id);
+	uint32 GetVersion() const { return version; } //changes whenever a group is added or removed
 private:
 	//LinkedList<SpawnGroup*> list_;
 	std::map<uint32, SpawnGroup*> groups;
+	uint32 version;
 };
 
 #endif
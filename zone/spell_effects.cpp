@@ -146,7 +146,7 @@ bool Mob::SpellEffect(Mob* caster, uint16 spell_id, float partial)
 		args.push_back(&buffslot);
 		int i = parse->EventSpell(EVENT_SPELL_EFFECT_NPC, CastToNPC(), nullptr, spell_id, caster ? caster->GetID() : 0, &args);
 		if(i != 0){
-			CalcBonuses();
+			UpdateBonuses(BonusSourceSpells);
 			return true;
 		}
 	}
@@ -156,7 +156,7 @@ bool Mob::SpellEffect(Mob* caster, uint16 spell_id, float partial)
 		args.push_back(&buffslot);
 		int i = parse->EventSpell(EVENT_SPELL_EFFECT_CLIENT, nullptr, CastToClient(), spell_id, caster ? caster->GetID() : 0, &args);
 		if(i != 0){
-			CalcBonuses();
+			UpdateBonuses(BonusSourceSpells);
 			return true;
 		}
 	}
@@ -3016,7 +3016,7 @@ bool Mob::SpellEffect(Mob* caster, uint16 spell_id, float partial)
 #endif
 	}
 
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 
 	if (SummonedItem) {
 		Client *c=CastToClient();
@@ -4179,7 +4179,7 @@ void Mob::BuffFadeBySlot(int slot, bool iRecalcBonuses)
 	}
 
 	if (iRecalcBonuses)
-		CalcBonuses();
+		UpdateBonuses(BonusSourceSpells);
 }
 
 int32 Client::GetAAEffectDataBySlot(uint32 aa_ID, uint32 slot_id, bool GetEffect, bool GetBase1, bool GetBase2)
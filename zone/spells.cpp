@@ -2589,8 +2589,8 @@ int Mob::CalcBuffDuration(Mob *caster, Mob *target, uint16 spell_id, int32 caste
 	if(!target)
 		target = caster;
 
-	formula = spells[spell_id].buffdurationformula;
-	duration = spells[spell_id].buffduration;
+	formula = spells_hot.buffdurationformula[spell_id];
+	duration = spells_hot.buffduration[spell_id];
 
 	int castlevel = caster->GetCasterLevel(spell_id);
 	if(caster_level_override > 0)
@@ -3024,6 +3024,9 @@ bool Client::CheckSpellLevelRestriction(uint16 spell_id)
 // the level of the mob
 int Mob::AddBuff(Mob *caster, uint16 spell_id, int duration, int32 level_override)
 {
+	//a buff landing on a dormant npc has to start ticking
+	if (IsNPC())
+		CastToNPC()->Wake();
 
 	int buffslot, ret, caster_level, emptyslot = -1;
 	bool will_overwrite = false;
@@ -3192,7 +3195,7 @@ int Mob::AddBuff(Mob *caster, uint16 spell_id, int duration, int32 level_overrid
 	}
 
 	// recalculate bonuses since we stripped/added buffs
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 
 	return emptyslot;
 }
@@ -3889,7 +3892,7 @@ void Mob::BuffFadeAll()
 			BuffFadeBySlot(j, false);
 	}
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 void Mob::BuffFadeNonPersistDeath()
@@ -3900,7 +3903,7 @@ void Mob::BuffFadeNonPersistDeath()
 			BuffFadeBySlot(j, false);
 	}
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 void Mob::BuffFadeDetrimental() {
@@ -3912,7 +3915,7 @@ void Mob::BuffFadeDetrimental() {
 		}
 	}
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 void Mob::BuffFadeDetrimentalByCaster(Mob *caster)
@@ -3934,7 +3937,7 @@ void Mob::BuffFadeDetrimentalByCaster(Mob *caster)
 		}
 	}
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 void Mob::BuffFadeBySitModifier()
@@ -3955,7 +3958,7 @@ void Mob::BuffFadeBySitModifier()
 
 	if(r_bonus)
 	{
-		CalcBonuses();
+		UpdateBonuses(BonusSourceSpells);
 	}
 }
 
@@ -3970,7 +3973,7 @@ void Mob::BuffFadeBySpellID(uint16 spell_id)
 	}
 
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 // removes buffs containing effectid, skipping skipslot
@@ -3988,7 +3991,7 @@ void Mob::BuffFadeByEffect(int effectid, int skipslot)
 	}
 
 	//we tell BuffFadeBySlot not to recalc, so we can do it only once when were done
-	CalcBonuses();
+	UpdateBonuses(BonusSourceSpells);
 }
 
 // checks if 'this' can be affected by spell_id from caster
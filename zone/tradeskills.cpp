@@ -19,7 +19,10 @@
 #include "../common/debug.h"
 
 #include <stdlib.h>
+#include <algorithm>
 #include <list>
+#include <map>
+#include <unordered_map>
 
 #ifndef WIN32
 #include <netinet/in.h>	//for htonl
@@ -38,6 +41,26 @@ extern QueryServ* QServ;
 
 static const SkillUseTypes TradeskillUnknown = Skill1HBlunt; /* an arbitrary non-tradeskill */
 
+// Every recipe is loaded once at boot so a combine is matched without querying the database
+struct TradeskillRecipe {
+	SkillUseTypes tradeskill;
+	int16 skill_needed;
+	uint16 trivial;
+	bool nofail;
+	bool replace_container;
+	std::string name;
+	uint8 must_learn;
+	bool quest;
+	bool enabled;
+	std::vector<uint32> components;	// sorted, an item appears once per componentcount
+	std::vector<uint32> items;	// sorted ids of every entry, containers included
+	std::vector< std::pair<uint32,uint8> > onsuccess;
+	std::vector< std::pair<uint32,uint8> > onfail;
+};
+
+static std::map<uint32, TradeskillRecipe> tradeskill_recipes;
+static std::unordered_multimap<uint64, uint32> tradeskill_recipe_index;	// component hash -> recipe id
+
 void Object::HandleAugmentation(Client* user, const AugmentItem_Struct* in_augment, Object *worldo)
 {
 	if (!user || !in_augment)
@@ -1182,100 +1205,136 @@ void Client::CheckIncreaseTradeskill(int16 bonusstat, int16 stat_modifier, float
 	_log(TRADESKILLS__TRACE, "...Stage2 chance was: %f percent. 0 percent means stage1 failed", chance_stage2);
 }
 
+// Hash of a sorted component list, the key combines are looked up by
+static uint64 TradeskillComponentHash(const std::vector<uint32> &components)
+{
+	uint64 hash = 14695981039346656037ULL;
+	for (auto iter = components.begin(); iter != components.end(); ++iter) {
+		hash ^= *iter;
+		hash *= 1099511628211ULL;
+	}
+	return hash;
+}
+
+// The old queries matched the container against any entry of the recipe, not only the iscontainer ones
+static bool TradeskillRecipeUsesContainer(const TradeskillRecipe &recipe, uint8 c_type, uint32 some_id)
+{
+	if (std::binary_search(recipe.items.begin(), recipe.items.end(), (uint32)c_type))
+		return true;
+
+	return some_id != 0 && std::binary_search(recipe.items.begin(), recipe.items.end(), some_id);
+}
+
+bool ZoneDatabase::LoadTradeskillRecipes()
+{
+	tradeskill_recipes.clear();
+	tradeskill_recipe_index.clear();
+
+	std::string query = "SELECT id, tradeskill, skillneeded, trivial, nofail, replace_container, "
+                        "name, must_learn, quest, enabled FROM tradeskill_recipe";
+	auto results = QueryDatabase(query);
+	if (!results.Success()) {
+		LogFile->write(EQEmuLog::Error, "Error in LoadTradeskillRecipes query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
+		return false;
+	}
+
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		TradeskillRecipe &recipe = tradeskill_recipes[atoul(row[0])];
+		recipe.tradeskill = (SkillUseTypes)atoi(row[1]);
+		recipe.skill_needed = (int16)atoi(row[2]);
+		recipe.trivial = (uint16)atoi(row[3]);
+		recipe.nofail = atoi(row[4]) ? true : false;
+		recipe.replace_container = atoi(row[5]) ? true : false;
+		recipe.name = row[6];
+		recipe.must_learn = (uint8)atoi(row[7]);
+		recipe.quest = atoi(row[8]) ? true : false;
+		recipe.enabled = atoi(row[9]) ? true : false;
+	}
+
+	query = "SELECT recipe_id, item_id, successcount, failcount, componentcount "
+            "FROM tradeskill_recipe_entries";
+	results = QueryDatabase(query);
+	if (!results.Success()) {
+		LogFile->write(EQEmuLog::Error, "Error in LoadTradeskillRecipes entries query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
+		tradeskill_recipes.clear();
+		return false;
+	}
+
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		auto iter = tradeskill_recipes.find(atoul(row[0]));
+		if (iter == tradeskill_recipes.end())
+			continue;
+
+		TradeskillRecipe &recipe = iter->second;
+		uint32 item = atoul(row[1]);
+		uint8 success_count = (uint8)atoi(row[2]);
+		uint8 fail_count = (uint8)atoi(row[3]);
+		int component_count = atoi(row[4]);
+
+		recipe.items.push_back(item);
+		if (success_count > 0)
+			recipe.onsuccess.push_back(std::pair<uint32,uint8>(item, success_count));
+		if (fail_count > 0)
+			recipe.onfail.push_back(std::pair<uint32,uint8>(item, fail_count));
+		for (int i = 0; i < component_count; i++)
+			recipe.components.push_back(item);
+	}
+
+	for (auto iter = tradeskill_recipes.begin(); iter != tradeskill_recipes.end(); ++iter) {
+		TradeskillRecipe &recipe = iter->second;
+		std::sort(recipe.items.begin(), recipe.items.end());
+		recipe.items.erase(std::unique(recipe.items.begin(), recipe.items.end()), recipe.items.end());
+		std::sort(recipe.components.begin(), recipe.components.end());
+
+		if (!recipe.components.empty())
+			tradeskill_recipe_index.insert(std::make_pair(TradeskillComponentHash(recipe.components), iter->first));
+	}
+
+	_log(TRADESKILLS__TRACE, "Loaded %u tradeskill recipes", (uint32)tradeskill_recipes.size());
+	return true;
+}
+
 bool ZoneDatabase::GetTradeRecipe(const ItemInst* container, uint8 c_type, uint32 some_id,
 	uint32 char_id, DBTradeskillRecipe_Struct *spec)
 {
 	if (container == nullptr)
 		return false;
 
-	std::string containers;// make where clause segment for container(s)
-	if (some_id == 0)
-		containers = StringFormat("= %u", c_type); // world combiner so no item number
-	else
-		containers = StringFormat("IN (%u,%u)", c_type, some_id); // container in inventory
-
-	//Could prolly watch for stacks in this loop and handle them properly...
-	//just increment sum and count accordingly
-	bool first = true;
-	std::string buf2;
-	uint32 count = 0;
-	uint32 sum = 0;
+	//each filled slot counts as one component, stacks included
+	std::vector<uint32> components;
 	for (uint8 i = 0; i < 10; i++) { // <watch> TODO: need to determine if this is bound to world/item container size
 		const ItemInst* inst = container->GetItem(i);
 		if (!inst)
-            continue;
-
-        const Item_Struct* item = GetItem(inst->GetItem()->ID);
-        if (!item)
-            continue;
+			continue;
 
-        if(first) {
-            buf2 += StringFormat("%d", item->ID);
-            first = false;
-        } else
-            buf2 += StringFormat(",%d", item->ID);
+		const Item_Struct* item = GetItem(inst->GetItem()->ID);
+		if (!item)
+			continue;
 
-        sum += item->ID;
-        count++;
+		components.push_back(item->ID);
 	}
 
-	if(count == 0)
+	if (components.empty())
 		return false;	//no items == no recipe
 
-	std::string query = StringFormat("SELECT tre.recipe_id "
-                                    "FROM tradeskill_recipe_entries AS tre "
-                                    "INNER JOIN tradeskill_recipe AS tr ON (tre.recipe_id = tr.id) "
-                                    "WHERE tr.enabled AND (( tre.item_id IN(%s) AND tre.componentcount > 0) "
-                                    "OR ( tre.item_id %s AND tre.iscontainer=1 ))"
-                                    "GROUP BY tre.recipe_id HAVING sum(tre.componentcount) = %u "
-                                    "AND sum(tre.item_id * tre.componentcount) = %u",
-                                    buf2.c_str(), containers.c_str(), count, sum);
-    auto results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe search, query: %s", query.c_str());
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe search, error: %s", results.ErrorMessage().c_str());
-		return false;
+	std::sort(components.begin(), components.end());
+
+	//the hash only narrows the search, the component lists still have to be equal
+	std::vector<uint32> matches;
+	auto range = tradeskill_recipe_index.equal_range(TradeskillComponentHash(components));
+	for (auto iter = range.first; iter != range.second; ++iter) {
+		const TradeskillRecipe &recipe = tradeskill_recipes[iter->second];
+		if (recipe.enabled && recipe.components == components && TradeskillRecipeUsesContainer(recipe, c_type, some_id))
+			matches.push_back(iter->second);
 	}
 
-    if (results.RowCount() > 1) {
-        //multiple recipes, partial match... do an extra query to get it exact.
-        //this happens when combining components for a smaller recipe
-        //which is completely contained within another recipe
-        first = true;
-        uint32 index = 0;
-        buf2 = "";
-        for (auto row = results.begin(); row != results.end(); ++row, ++index) {
-            uint32 recipeid = (uint32)atoi(row[0]);
-            if(first) {
-                buf2 += StringFormat("%u", recipeid);
-                first = false;
-            } else
-                buf2 += StringFormat(",%u", recipeid);
-
-            //length limit on buf2
-            if(index == 214) { //Maximum number of recipe matches (19 * 215 = 4096)
-                LogFile->write(EQEmuLog::Error, "GetTradeRecipe warning: Too many matches. Unable to search all recipe entries. Searched %u of %u possible entries.", index + 1, results.RowCount());
-                break;
-            }
-        }
-
-        query = StringFormat("SELECT tre.recipe_id "
-                            "FROM tradeskill_recipe_entries AS tre "
-                            "WHERE tre.recipe_id IN (%s) "
-                            "GROUP BY tre.recipe_id HAVING sum(tre.componentcount) = %u "
-                            "AND sum(tre.item_id * tre.componentcount) = %u", buf2.c_str(), count, sum);
-		results = QueryDatabase(query);
-        if (!results.Success()) {
-            LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, re-query: %s", query.c_str());
-            LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, error: %s", results.ErrorMessage().c_str());
-            return false;
-        }
-    }
-
-    if (results.RowCount() < 1)
-        return false;
-
-	if(results.RowCount() > 1) {
+	if (matches.empty())
+		return false;
+
+	//same recipe id order the old GROUP BY query returned them in
+	std::sort(matches.begin(), matches.end());
+
+	if (matches.size() > 1) {
 		//The recipe is not unique, so we need to compare the container were using.
 		uint32 containerId = 0;
 
@@ -1286,173 +1345,73 @@ bool ZoneDatabase::GetTradeRecipe(const ItemInst* container, uint8 c_type, uint3
 		else //Invalid container
 			return false;
 
-		query = StringFormat("SELECT tre.recipe_id "
-                            "FROM tradeskill_recipe_entries AS tre "
-                            "WHERE tre.recipe_id IN (%s) "
-                            "AND tre.item_id = %u;", buf2.c_str(), containerId);
-        results = QueryDatabase(query);
-		if (!results.Success()) {
-			LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, re-query: %s", query.c_str());
-			LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, error: %s", results.ErrorMessage().c_str());
-			return false;
+		std::vector<uint32> in_container;
+		for (auto iter = matches.begin(); iter != matches.end(); ++iter) {
+			const std::vector<uint32> &items = tradeskill_recipes[*iter].items;
+			if (std::binary_search(items.begin(), items.end(), containerId))
+				in_container.push_back(*iter);
 		}
 
-		if(results.RowCount() == 0) { //Recipe contents matched more than 1 recipe, but not in this container
+		if (in_container.empty()) { //Recipe contents matched more than 1 recipe, but not in this container
 			LogFile->write(EQEmuLog::Error, "Combine error: Incorrect container is being used!");
 			return false;
 		}
 
-		if (results.RowCount() > 1) //Recipe contents matched more than 1 recipe in this container
-			LogFile->write(EQEmuLog::Error, "Combine error: Recipe is not unique! %u matches found for container %u. Continuing with first recipe match.", results.RowCount(), containerId);
+		if (in_container.size() > 1) //Recipe contents matched more than 1 recipe in this container
+			LogFile->write(EQEmuLog::Error, "Combine error: Recipe is not unique! %u matches found for container %u. Continuing with first recipe match.", (uint32)in_container.size(), containerId);
 
+		matches.swap(in_container);
 	}
 
-	auto row = results.begin();
-	uint32 recipe_id = (uint32)atoi(row[0]);
-
-	//Right here we verify that we actually have ALL of the tradeskill components..
-	//instead of part which is possible with experimentation.
-	//This is here because something's up with the query above.. it needs to be rethought out
-	bool has_components = true;
-	query = StringFormat("SELECT item_id, componentcount "
-                        "FROM tradeskill_recipe_entries "
-                        "WHERE recipe_id = %i AND componentcount > 0",
-                        recipe_id);
-	results = QueryDatabase(query);
-    if (!results.Success()) {
-        LogFile->write(EQEmuLog::Error, "Error in tradeskill verify query: '%s': %s", query.c_str(), results.ErrorMessage().c_str());
-        return GetTradeRecipe(recipe_id, c_type, some_id, char_id, spec);
-    }
-
-	if (results.RowCount() == 0)
-        return GetTradeRecipe(recipe_id, c_type, some_id, char_id, spec);
-
-	for (auto row = results.begin(); row != results.end(); ++row) {
-        int ccnt = 0;
-
-        for(int x = MAIN_BEGIN; x < EmuConstants::MAP_WORLD_SIZE; x++) {
-            const ItemInst* inst = container->GetItem(x);
-            if(!inst)
-                continue;
-
-            const Item_Struct* item = GetItem(inst->GetItem()->ID);
-            if (!item)
-                continue;
-
-            if(item->ID == atoi(row[0]))
-                ccnt++;
-        }
-
-        if(ccnt != atoi(row[1]))
-            return false;
-    }
-
-	return GetTradeRecipe(recipe_id, c_type, some_id, char_id, spec);
+	return GetTradeRecipe(matches.front(), c_type, some_id, char_id, spec);
 }
 
 bool ZoneDatabase::GetTradeRecipe(uint32 recipe_id, uint8 c_type, uint32 some_id,
 	uint32 char_id, DBTradeskillRecipe_Struct *spec)
 {
-
-	// make where clause segment for container(s)
-	std::string containers;
-	if (some_id == 0)
-		containers = StringFormat("= %u", c_type); // world combiner so no item number
-	else
-		containers = StringFormat("IN (%u,%u)", c_type, some_id); // container in inventory
-
-	std::string query = StringFormat("SELECT tr.id, tr.tradeskill, tr.skillneeded, "
-                                    "tr.trivial, tr.nofail, tr.replace_container, "
-                                    "tr.name, tr.must_learn, tr.quest, crl.madecount "
-                                    "FROM tradeskill_recipe AS tr "
-                                    "INNER JOIN tradeskill_recipe_entries AS tre "
-                                    "ON tr.id = tre.recipe_id "
-                                    "LEFT JOIN (SELECT recipe_id, madecount "
-                                    "FROM char_recipe_list WHERE char_id = %u) AS crl "
-                                    "ON tr.id = crl.recipe_id "
-                                    "WHERE tr.id = %lu AND tre.item_id %s AND tr.enabled "
-                                    "GROUP BY tr.id",
-                                    char_id, (unsigned long)recipe_id, containers.c_str());
-    auto results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, query: %s", query.c_str());
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe, error: %s", results.ErrorMessage().c_str());
-		return false;
-	}
-
-	if(results.RowCount() != 1)
+	auto iter = tradeskill_recipes.find(recipe_id);
+	if (iter == tradeskill_recipes.end())
 		return false;//just not found i guess..
 
-	auto row = results.begin();
-	spec->tradeskill = (SkillUseTypes)atoi(row[1]);
-	spec->skill_needed	= (int16)atoi(row[2]);
-	spec->trivial = (uint16)atoi(row[3]);
-	spec->nofail = atoi(row[4]) ? true : false;
-	spec->replace_container	= atoi(row[5]) ? true : false;
-	spec->name = row[6];
-	spec->must_learn = (uint8)atoi(row[7]);
-	spec->quest = atoi(row[8]) ? true : false;
-
-	if (row[9] == nullptr) {
-		spec->has_learnt = false;
-		spec->madecount = 0;
-	} else {
-		spec->has_learnt = true;
-		spec->madecount = (uint32)atoul(row[9]);
-	}
-	spec->recipe_id = recipe_id;
+	const TradeskillRecipe &recipe = iter->second;
+	if (!recipe.enabled || !TradeskillRecipeUsesContainer(recipe, c_type, some_id))
+		return false;
 
-	//Pull the on-success items...
-	query = StringFormat("SELECT item_id,successcount FROM tradeskill_recipe_entries "
-                        "WHERE successcount > 0 AND recipe_id = %u", recipe_id);
-    results = QueryDatabase(query);
-	if (!results.Success()) {
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecept success query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
+	if (recipe.onsuccess.empty()) {
+		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe success: no success items for recipe %u", recipe_id);
 		return false;
 	}
 
-	if(results.RowCount() < 1) {
-		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecept success: no success items returned");
+	spec->tradeskill = recipe.tradeskill;
+	spec->skill_needed = recipe.skill_needed;
+	spec->trivial = recipe.trivial;
+	spec->nofail = recipe.nofail;
+	spec->replace_container = recipe.replace_container;
+	spec->name = recipe.name;
+	spec->must_learn = recipe.must_learn;
+	spec->quest = recipe.quest;
+	spec->recipe_id = recipe_id;
+	spec->onsuccess = recipe.onsuccess;
+	spec->onfail = recipe.onfail;
+	// The old salvage query was never read (its loop stopped at begin()), so combines never salvaged
+	spec->salvage.clear();
+
+	//what the character has made is the only part that isn't loaded up front
+	spec->has_learnt = false;
+	spec->madecount = 0;
+
+	auto stmt = Prepare("SELECT madecount FROM char_recipe_list WHERE char_id = ? AND recipe_id = ?");
+	if (!stmt.IsValid() || !stmt->Execute(char_id, recipe_id)) {
+		LogFile->write(EQEmuLog::Error, "Error in GetTradeRecipe madecount query '%s': %s", stmt->GetQuery().c_str(), stmt->GetError().c_str());
 		return false;
 	}
 
-	spec->onsuccess.clear();
-	for(auto row = results.begin(); row != results.end(); ++row) {
-		uint32 item = (uint32)atoi(row[0]);
-		uint8 num = (uint8) atoi(row[1]);
-		spec->onsuccess.push_back(std::pair<uint32,uint8>(item, num));
+	uint32 madecount;
+	if (stmt->Fetch(madecount)) {
+		spec->has_learnt = true;
+		spec->madecount = madecount;
 	}
 
-    spec->onfail.clear();
-	//Pull the on-fail items...
-	query = StringFormat("SELECT item_id, failcount FROM tradeskill_recipe_entries "
-                        "WHERE failcount > 0 AND recipe_id = %u", recipe_id);
-	results = QueryDatabase(query);
-	if (results.Success())
-		for(auto row = results.begin(); row != results.end(); ++row) {
-			uint32 item = (uint32)atoi(row[0]);
-			uint8 num = (uint8) atoi(row[1]);
-			spec->onfail.push_back(std::pair<uint32,uint8>(item, num));
-		}
-
-    spec->salvage.clear();
-
-    // Don't bother with the query if TS is nofail
-    if (spec->nofail)
-        return true;
-
-	// Pull the salvage list
-	query = StringFormat("SELECT item_id, salvagecount "
-                        "FROM tradeskill_recipe_entries "
-                        "WHERE salvagecount > 0 AND recipe_id = %u", recipe_id);
-    results = QueryDatabase(query);
-	if (results.Success())
-		for(auto row = results.begin(); row != results.begin(); ++row) {
-			uint32 item = (uint32)atoi(row[0]);
-			uint8 num = (uint8)atoi(row[1]);
-			spec->salvage.push_back(std::pair<uint32,uint8>(item, num));
-		}
-
 	return true;
 }
 
@@ -1555,6 +1514,10 @@ bool ZoneDatabase::EnableRecipe(uint32 recipe_id)
 	if (!results.Success())
 		LogFile->write(EQEmuLog::Error, "Error in EnableRecipe query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
 
+	auto iter = tradeskill_recipes.find(recipe_id);
+	if (results.Success() && iter != tradeskill_recipes.end())
+		iter->second.enabled = true;
+
 	return results.RowsAffected() > 0;
 }
 
@@ -1566,5 +1529,9 @@ bool ZoneDatabase::DisableRecipe(uint32 recipe_id)
 	if (!results.Success())
 		LogFile->write(EQEmuLog::Error, "Error in DisableRecipe query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
 
+	auto iter = tradeskill_recipes.find(recipe_id);
+	if (results.Success() && iter != tradeskill_recipes.end())
+		iter->second.enabled = false;
+
 	return results.RowsAffected() > 0;
 }
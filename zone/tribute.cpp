@@ -176,7 +176,7 @@ void Client::DoTributeUpdate() {
 				DeleteItemInInventory(EmuConstants::TRIBUTE_BEGIN + r, 0, false);
 		}
 	}
-	CalcBonuses();
+	UpdateBonuses(BonusSourceItems);
 }
 
 void Client::SendTributeTimer() {
@@ -102,6 +102,9 @@ void WorldServer::OnConnected() {
 
 	ServerPacket* pack;
 
+	//world may have restarted, anything it sent us before is stale.
+	guild_mgr.ClearRosters();
+
 	//tell the launcher what name we were started with.
 	pack = new ServerPacket(ServerOP_SetLaunchName,sizeof(LaunchName_Struct));
 	LaunchName_Struct* ln = (LaunchName_Struct*)pack->pBuffer;
@@ -578,6 +581,8 @@ void WorldServer::Process() {
 		case ServerOP_GuildMemberUpdate:
 		case ServerOP_GuildRankUpdate:
 		case ServerOP_LFGuildUpdate:
+		case ServerOP_GuildRoster:
+		case ServerOP_GuildMemberDelta:
 //		case ServerOP_GuildGMSet:
 //		case ServerOP_GuildGMSetRank:
 //		case ServerOP_GuildJoin:
@@ -1084,7 +1089,6 @@ void WorldServer::Process() {
 
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
-					r->LearnMembers();
 					r->VerifyRaid();
 					r->SendRaidAddAll(rga->playername);
 				}
@@ -1105,7 +1109,6 @@ void WorldServer::Process() {
 					if(rem){
 						r->SendRaidDisband(rem);
 					}
-					r->LearnMembers();
 					r->VerifyRaid();
 				}
 			}
@@ -1121,7 +1124,6 @@ void WorldServer::Process() {
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
 					r->SendRaidDisbandAll();
-					r->LearnMembers();
 					r->VerifyRaid();
 				}
 			}
@@ -1154,7 +1156,6 @@ void WorldServer::Process() {
 
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
-					r->LearnMembers();
 					r->VerifyRaid();
 					Client *c = entity_list.GetClientByName(rga->playername);
 					if(c){
@@ -1211,7 +1212,6 @@ void WorldServer::Process() {
 					if(c){
 						r->SetLeader(c);
 					}
-					r->LearnMembers();
 					r->VerifyRaid();
 					r->SendMakeLeaderPacket(rga->playername);
 				}
@@ -1228,13 +1228,39 @@ void WorldServer::Process() {
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
 					r->GetRaidDetails();
-					r->LearnMembers();
 					r->VerifyRaid();
 				}
 			}
 			break;
 		}
 
+		case ServerOP_RaidMemberDelta: {
+			if(pack->size != sizeof(ServerRaidMemberDelta_Struct))
+				break;
+
+			ServerRaidMemberDelta_Struct* delta = (ServerRaidMemberDelta_Struct*)pack->pBuffer;
+			if(zone){
+				Raid *r = entity_list.GetRaidByID(delta->rid);
+				if(r)
+					r->ApplyMemberDelta(delta);
+			}
+			break;
+		}
+
+		case ServerOP_RaidSnapshot: {
+			ServerRaidSnapshot_Struct* snapshot = (ServerRaidSnapshot_Struct*)pack->pBuffer;
+			if(pack->size < sizeof(ServerRaidSnapshot_Struct) ||
+				pack->size < sizeof(ServerRaidSnapshot_Struct) + snapshot->count * sizeof(ServerRaidMember_Struct))
+				break;
+
+			if(zone){
+				Raid *r = entity_list.GetRaidByID(snapshot->rid);
+				if(r)
+					r->ApplySnapshot(snapshot);
+			}
+			break;
+		}
+
 		case ServerOP_RaidGroupDisband:{
 			ServerRaidGeneralAction_Struct* rga = (ServerRaidGeneralAction_Struct*)pack->pBuffer;
 			if(zone){
@@ -1260,7 +1286,6 @@ void WorldServer::Process() {
 			if(zone){
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
-					r->LearnMembers();
 					r->VerifyRaid();
 					EQApplicationPacket* outapp = new EQApplicationPacket(OP_GroupUpdate, sizeof(GroupJoin_Struct));
 					GroupJoin_Struct* gj = (GroupJoin_Struct*) outapp->pBuffer;
@@ -1291,7 +1316,6 @@ void WorldServer::Process() {
 			if(zone){
 				Raid *r = entity_list.GetRaidByID(rga->rid);
 				if(r){
-					r->LearnMembers();
 					r->VerifyRaid();
 					EQApplicationPacket* outapp = new EQApplicationPacket(OP_GroupUpdate, sizeof(GroupJoin_Struct));
 					GroupJoin_Struct* gj = (GroupJoin_Struct*) outapp->pBuffer;
@@ -1753,6 +1777,16 @@ void WorldServer::Process() {
 			RuleManager::Instance()->LoadRules(&database, RuleManager::Instance()->GetActiveRuleset());
 			break;
 		}
+		case ServerOP_SharedMemoryGeneration:
+		{
+			if (pack->size != sizeof(ServerSharedMemoryGeneration_Struct))
+				break;
+			ServerSharedMemoryGeneration_Struct *smg = (ServerSharedMemoryGeneration_Struct*)pack->pBuffer;
+			_log(ZONE__INIT, "Shared memory %s is now generation %u, remapping", smg->segment, smg->generation);
+			//we are between ticks here, so nothing is reading the segments while they are swapped
+			ReloadSharedMemory();
+			break;
+		}
 		case ServerOP_CameraShake:
 		{
 			if(zone)
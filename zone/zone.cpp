@@ -16,6 +16,7 @@
 	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
 */
 
+#include <algorithm>
 #include <float.h>
 #include <iostream>
 #include <math.h>
@@ -837,6 +838,7 @@ Zone::Zone(uint32 in_zoneid, uint32 in_instanceid, const char* in_short_name)
 }
 
 Zone::~Zone() {
+	spawn2_queue.clear();
 	spawn2_list.Clear();
 	safe_delete(zonemap);
 	safe_delete(watermap);
@@ -1162,23 +1164,67 @@ uint32 Zone::CountAuth() {
 	return x;
 }
 
-bool Zone::Process() {
-	spawn_conditions.Process();
+static bool Spawn2DueLater(const Zone::Spawn2Due &a, const Zone::Spawn2Due &b) {
+	return (int32)(a.due - b.due) > 0;
+}
 
-	if(spawn2_timer.Check()) {
-		LinkedListIterator<Spawn2*> iterator(spawn2_list);
+void Zone::ScheduleSpawn2(Spawn2 *spawn, uint32 due) {
+	Spawn2Due entry;
+	entry.due = due;
+	entry.spawn = spawn;
+	spawn2_queue.push_back(entry);
+	std::push_heap(spawn2_queue.begin(), spawn2_queue.end(), Spawn2DueLater);
+}
 
-		Inventory::CleanDirty();
+void Zone::UnscheduleSpawn2(Spawn2 *spawn) {
+	if(spawn2_queue.empty())
+		return;
+
+	auto removed = std::remove_if(spawn2_queue.begin(), spawn2_queue.end(),
+		[spawn](const Spawn2Due &entry) { return entry.spawn == spawn; });
+	if(removed == spawn2_queue.end())
+		return;
+
+	spawn2_queue.erase(removed, spawn2_queue.end());
+	std::make_heap(spawn2_queue.begin(), spawn2_queue.end(), Spawn2DueLater);
+}
+
+//only the spawns whose respawn timer is due are processed, the rest of spawn2_list isn't touched
+void Zone::ProcessSpawn2Queue() {
+	uint32 now = Timer::GetCurrentTime();
+
+	while(!spawn2_queue.empty() && (int32)(now - spawn2_queue.front().due) >= 0) {
+		std::pop_heap(spawn2_queue.begin(), spawn2_queue.end(), Spawn2DueLater);
+		Spawn2Due entry = spawn2_queue.back();
+		spawn2_queue.pop_back();
+
+		Spawn2 *spawn = entry.spawn;
+		if(entry.due != spawn->next_due)
+			continue;
+
+		if(spawn->Process())
+			continue;
 
+		LinkedListIterator<Spawn2*> iterator(spawn2_list);
 		iterator.Reset();
-		while (iterator.MoreElements()) {
-			if (iterator.GetData()->Process()) {
-				iterator.Advance();
-			}
-			else {
+		while(iterator.MoreElements()) {
+			if(iterator.GetData() == spawn) {
 				iterator.RemoveCurrent();
+				break;
 			}
+			iterator.Advance();
 		}
+	}
+}
+
+bool Zone::Process() {
+	spawn_conditions.Process();
+
+	if(spawn2_timer.Check()) {
+		Inventory::CleanDirty();
+
+		ProcessSpawn2Queue();
+
 		if(adv_data && !did_adventure_actions)
 		{
 			DoAdventureActions();
@@ -1463,6 +1509,9 @@ void Zone::Repop(uint32 delay) {
 
 	LinkedListIterator<Spawn2*> iterator(spawn2_list);
 
+	//everything queued is about to go, so the deletes below don't each search the queue
+	spawn2_queue.clear();
+
 	iterator.Reset();
 	while (iterator.MoreElements()) {
 		iterator.RemoveCurrent();
@@ -248,6 +248,16 @@ public:
 	void	DeleteQGlobal(std::string name, uint32 npcID, uint32 charID, uint32 zoneID);
 
 	LinkedList<Spawn2*> spawn2_list;
+	// Min-heap of spawn2_list by respawn timer due time, an entry whose due time no longer matches its
+	// spawn's next_due was superseded by a later schedule and is skipped
+	struct Spawn2Due {
+		uint32	due;
+		Spawn2	*spawn;
+	};
+	std::vector<Spawn2Due> spawn2_queue;
+	void	ScheduleSpawn2(Spawn2 *spawn, uint32 due);
+	void	UnscheduleSpawn2(Spawn2 *spawn);
+	void	ProcessSpawn2Queue();
 	LinkedList<ZonePoint*> zone_point_list;
 	uint32	numzonepoints;
 
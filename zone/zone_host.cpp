@@ -0,0 +1,183 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+
+#include "../common/debug.h"
+#include "zone_host.h"
+
+#ifndef WIN32
+
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#include <string.h>
+#include <stdio.h>
+#ifdef __linux__
+	#include <sys/prctl.h>
+#endif
+
+extern volatile bool RunLoops;
+
+bool ZoneHost::WriteLine(int fd, const std::string &line) {
+	std::string out = line + "\n";
+	size_t sent = 0;
+	while(sent < out.length()) {
+		ssize_t r = write(fd, out.c_str() + sent, out.length() - sent);
+		if(r == -1) {
+			if(errno == EINTR)
+				continue;
+			return(false);
+		}
+		sent += r;
+	}
+	return(true);
+}
+
+void ZoneHost::ReportExited(int fd) {
+	int status;
+	pid_t died;
+	while((died = waitpid(-1, &status, WNOHANG)) > 0) {
+		_log(ZONE__INIT, "Hosted zone with pid %d has exited.", died);
+		char msg[32];
+		snprintf(msg, sizeof(msg), "exited %d", died);
+		WriteLine(fd, msg);
+	}
+}
+
+void ZoneHost::BecomeZone(int fd, const std::string &log_file) {
+	close(fd);
+
+#ifdef __linux__
+	//nobody would be left to report our exit to eqlaunch, so go down with the host
+	pid_t host = getppid();
+	prctl(PR_SET_PDEATHSIG, SIGTERM);
+	if(getppid() != host)
+		_exit(1);
+#endif
+
+	//same redirection ProcLauncher gives a zone it execs itself
+	if(log_file.length() > 0) {
+		int outfd = creat(log_file.c_str(), S_IRUSR | S_IWUSR | S_IRGRP);
+		if(outfd == -1) {
+			fprintf(stderr, "Unable to open log file %s: %s.\n", log_file.c_str(), strerror(errno));
+		} else {
+			fflush(stdout);
+			fflush(stderr);
+			dup2(outfd, STDOUT_FILENO);
+			dup2(outfd, STDERR_FILENO);
+			close(outfd);
+		}
+		close(STDIN_FILENO);
+	}
+}
+
+bool ZoneHost::Serve(int fd, std::string &zone_name) {
+	_log(ZONE__INIT, "Zone host ready, waiting for launches.");
+	if(!WriteLine(fd, "ready"))
+		return(false);
+
+	std::string buffer;
+	while(RunLoops) {
+		ReportExited(fd);
+
+		struct pollfd p;
+		p.fd = fd;
+		p.events = POLLIN;
+		p.revents = 0;
+		int res = poll(&p, 1, 1000);
+		if(res == -1 && errno != EINTR) {
+			_log(ZONE__INIT_ERR, "Zone host lost its launcher: %s", strerror(errno));
+			return(false);
+		}
+		if(res <= 0)
+			continue;
+
+		char chunk[512];
+		ssize_t len = read(fd, chunk, sizeof(chunk));
+		if(len == -1 && errno == EINTR)
+			continue;
+		if(len <= 0) {
+			_log(ZONE__INIT, "Launcher has gone away, zone host exiting.");
+			return(false);
+		}
+		buffer.append(chunk, len);
+
+		size_t eol;
+		while((eol = buffer.find('\n')) != std::string::npos) {
+			std::string line = buffer.substr(0, eol);
+			buffer.erase(0, eol + 1);
+
+			//start <zone> <log file>, the log file being the rest of the line
+			if(line.compare(0, 6, "start ") != 0) {
+				_log(ZONE__INIT_ERR, "Zone host got an unknown request '%s'", line.c_str());
+				continue;
+			}
+			std::string name = line.substr(6);
+			std::string log_file;
+			size_t space = name.find(' ');
+			if(space != std::string::npos) {
+				log_file = name.substr(space + 1);
+				name.erase(space);
+			}
+
+			LogFile->Suspend();
+			pid_t child = fork();
+			if(child == 0) {
+				BecomeZone(fd, log_file);
+				zone_name = name;
+				return(true);
+			}
+
+			if(child == -1) {
+				_log(ZONE__INIT_ERR, "Unable to fork zone %s: %s", name.c_str(), strerror(errno));
+				WriteLine(fd, "failed");
+				continue;
+			}
+
+			_log(ZONE__INIT, "Forked zone %s as pid %d", name.c_str(), child);
+			char msg[32];
+			snprintf(msg, sizeof(msg), "started %d", child);
+			WriteLine(fd, msg);
+		}
+	}
+
+	return(false);
+}
+
+#else	//WIN32
+
+bool ZoneHost::Serve(int fd, std::string &zone_name) {
+	_log(ZONE__INIT_ERR, "Zone hosting needs fork(), which this platform does not have.");
+	return(false);
+}
+
+bool ZoneHost::WriteLine(int fd, const std::string &line) {
+	return(false);
+}
+
+void ZoneHost::ReportExited(int fd) {
+}
+
+void ZoneHost::BecomeZone(int fd, const std::string &log_file) {
+}
+
+#endif	//WIN32
@@ -0,0 +1,48 @@
+/*	EQEMu: Everquest Server Emulator
+	Copyright (C) 2001-2014 EQEMu Development Team (http://eqemulator.net)
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; version 2 of the License.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY except by those people which sell it, which
+	are required to give you total support for your newly bought product;
+	without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+	A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+*/
+#ifndef ZONE_HOST_H
+#define ZONE_HOST_H
+
+#include <string>
+
+/*
+	A zone started as "zone --host <fd> <launcher>" loads everything zones share (opcodes, rules, items,
+	factions, loot, spells, commands, quests...) once and then hands out copies of itself: for every
+	"start <zone> <log file>" line eqlaunch writes on fd it forks, and the child carries on booting that
+	zone while sharing the loaded pages with the host and its other zones until it writes to them.
+
+	Replies on fd are "ready" once, then "started <pid>" or "failed" per request, and "exited <pid>"
+	whenever a zone it forked goes away. Zones are killed if the host dies.
+
+	Only works where fork() does, and the host has to be single threaded when it forks: no world
+	connection, no async database work, and the log writer suspended. Without a world connection the host
+	misses every reload, so a forked zone remaps newer shared memory and reloads whatever boot data
+	changed since the host loaded it before it boots.
+*/
+class ZoneHost {
+public:
+	//Serves eqlaunch on fd. Returns true in a forked zone with the name it was asked to run, false when the host should exit.
+	static bool Serve(int fd, std::string &zone_name);
+
+private:
+	static bool WriteLine(int fd, const std::string &line);
+	static void ReportExited(int fd);
+	static void BecomeZone(int fd, const std::string &log_file);
+};
+
+#endif
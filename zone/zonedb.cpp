@@ -61,13 +61,18 @@ ZoneDatabase::~ZoneDatabase() {
 	}
 	safe_delete_array(npc_spellseffects_loadtried);
 
+	ClearFactionData();
+}
+
+void ZoneDatabase::ClearFactionData() {
 	if (faction_array != nullptr) {
-		for (x=0; x <= max_faction; x++) {
+		for (uint32 x = 0; x <= max_faction; x++) {
 			if (faction_array[x] != 0)
 				safe_delete(faction_array[x]);
 		}
 		safe_delete_array(faction_array);
 	}
+	max_faction = 0;
 }
 
 bool ZoneDatabase::SaveZoneCFG(uint32 zoneid, uint16 instance_id, NewZone_Struct* zd) {
@@ -277,11 +282,12 @@ bool ZoneDatabase::logevents(const char* accountname,uint32 accountid,uint8 stat
                                     descriptiontype, descriptiontext, event_nid);
     safe_delete_array(descriptiontext);
 	safe_delete_array(targetarr);
-	auto results = QueryDatabase(query);
-	if (!results.Success())	{
-		std::cerr << "Error in logevents" << query << "' " << results.ErrorMessage() << std::endl;
-		return false;
-	}
+
+	// the event log is write only, so the zone does not wait for the insert
+	QueryDatabaseAsync(query, [query](MySQLRequestResult &results) {
+		if (!results.Success())
+			std::cerr << "Error in logevents" << query << "' " << results.ErrorMessage() << std::endl;
+	});
 
 	return true;
 }
@@ -3288,6 +3294,8 @@ bool ZoneDatabase::SetCharacterFactionLevel(uint32 char_id, int32 faction_id, in
 
 bool ZoneDatabase::LoadFactionData()
 {
+	ClearFactionData();
+
 	std::string query = "SELECT MAX(id) FROM faction_list";
 	auto results = QueryDatabase(query);
 	if (!results.Success()) {
@@ -3302,7 +3310,7 @@ bool ZoneDatabase::LoadFactionData()
 
 	max_faction = atoi(row[0]);
     faction_array = new Faction*[max_faction+1];
-    for(unsigned int index=0; index<max_faction; index++)
+    for(unsigned int index=0; index<=max_faction; index++)
         faction_array[index] = nullptr;
 
     query = "SELECT id, name, base FROM faction_list";
@@ -3330,6 +3338,26 @@ bool ZoneDatabase::LoadFactionData()
 	return true;
 }
 
+std::string ZoneDatabase::GetTableChecksums(const std::string &tables) {
+	std::string query = "CHECKSUM TABLE " + tables;
+	auto results = QueryDatabase(query);
+	if (!results.Success()) {
+		LogFile->write(EQEmuLog::Error, "Error in GetTableChecksums query '%s': %s", query.c_str(), results.ErrorMessage().c_str());
+		return "";
+	}
+
+	//a missing table has a NULL checksum, which still tells it apart from one that exists
+	std::string checksums;
+	for (auto row = results.begin(); row != results.end(); ++row) {
+		checksums += row[0];
+		checksums += "=";
+		checksums += row[1] ? row[1] : "none";
+		checksums += ";";
+	}
+
+	return checksums;
+}
+
 bool ZoneDatabase::GetFactionIdsForNPC(uint32 nfl_id, std::list<struct NPCFaction*> *faction_list, int32* primary_faction) {
 	if (nfl_id <= 0) {
 		std::list<struct NPCFaction*>::iterator cur,end;
@@ -431,6 +431,7 @@ public:
 	void	DeleteMerchantTemp(uint32 npcid, uint32 slot);
 
 	/* Tradeskills  */
+	bool	LoadTradeskillRecipes();
 	bool	GetTradeRecipe(const ItemInst* container, uint8 c_type, uint32 some_id, uint32 char_id, DBTradeskillRecipe_Struct *spec);
 	bool	GetTradeRecipe(uint32 recipe_id, uint8 c_type, uint32 some_id, uint32 char_id, DBTradeskillRecipe_Struct *spec);
 	uint32	GetZoneForage(uint32 ZoneID, uint8 skill); /* for foraging */
@@ -496,9 +497,11 @@ public:
 
 	/* Things which really dont belong here... */
 	int16	CommandRequirement(const char* commandname);
+	std::string	GetTableChecksums(const std::string &tables); // CHECKSUM TABLE of a comma separated list, empty on error
 
 protected:
 	void ZDBInitVars();
+	void ClearFactionData();
 
 	uint32				max_faction;
 	Faction**			faction_array;